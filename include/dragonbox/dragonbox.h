@@ -221,6 +221,7 @@ namespace jkj {
                 using JKJ_STD_REPLACEMENT_NAMESPACE::int_least8_t;
                 using JKJ_STD_REPLACEMENT_NAMESPACE::int_least16_t;
                 using JKJ_STD_REPLACEMENT_NAMESPACE::int_least32_t;
+                using JKJ_STD_REPLACEMENT_NAMESPACE::int_least64_t;
                 using JKJ_STD_REPLACEMENT_NAMESPACE::int_fast8_t;
                 using JKJ_STD_REPLACEMENT_NAMESPACE::int_fast16_t;
                 using JKJ_STD_REPLACEMENT_NAMESPACE::int_fast32_t;
@@ -1259,6 +1260,160 @@ namespace jkj {
                     }
                 }
             }
+
+            ////////////////////////////////////////////////////////////////////////////////////////
+            // Exact decimal arithmetic shared by the add-on headers.
+            ////////////////////////////////////////////////////////////////////////////////////////
+
+            template <class Dummy = void>
+            struct pow10_table_holder {
+                static constexpr stdr::uint_least64_t table[20] = {
+                    UINT64_C(1),
+                    UINT64_C(10),
+                    UINT64_C(100),
+                    UINT64_C(1000),
+                    UINT64_C(10000),
+                    UINT64_C(100000),
+                    UINT64_C(1000000),
+                    UINT64_C(10000000),
+                    UINT64_C(100000000),
+                    UINT64_C(1000000000),
+                    UINT64_C(10000000000),
+                    UINT64_C(100000000000),
+                    UINT64_C(1000000000000),
+                    UINT64_C(10000000000000),
+                    UINT64_C(100000000000000),
+                    UINT64_C(1000000000000000),
+                    UINT64_C(10000000000000000),
+                    UINT64_C(100000000000000000),
+                    UINT64_C(1000000000000000000),
+                    UINT64_C(10000000000000000000)};
+            };
+#if !JKJ_HAS_INLINE_VARIABLE
+            template <class Dummy>
+            constexpr stdr::uint_least64_t pow10_table_holder<Dummy>::table[20];
+#endif
+
+            // Minimal fixed-capacity big integer, used for deciding exact ties in
+            // to_chars_n_capped and the BID conversion, and for printing exact digits in
+            // dragonbox_charconv.h.
+            template <stdr::size_t max_limbs_>
+            struct fixed_big_uint {
+                static constexpr stdr::size_t max_limbs = max_limbs_;
+                stdr::uint_least32_t limbs[max_limbs];
+                stdr::size_t size;
+
+                explicit JKJ_CONSTEXPR14 fixed_big_uint(stdr::uint_least64_t n) noexcept
+                    : limbs{stdr::uint_least32_t(n & UINT32_C(0xffffffff)),
+                            stdr::uint_least32_t(n >> 32)},
+                      size{2} {}
+
+                JKJ_CONSTEXPR14 void multiply(stdr::uint_least32_t m) noexcept {
+                    stdr::uint_least64_t carry = 0;
+                    for (stdr::size_t i = 0; i < size; ++i) {
+                        auto const product = stdr::uint_least64_t(limbs[i]) * m + carry;
+                        limbs[i] = stdr::uint_least32_t(product & UINT32_C(0xffffffff));
+                        carry = product >> 32;
+                    }
+                    if (carry != 0) {
+                        assert(size < max_limbs);
+                        limbs[size++] = stdr::uint_least32_t(carry);
+                    }
+                }
+
+                JKJ_CONSTEXPR14 void multiply_pow5(int e) noexcept {
+                    // 5^13 is the largest power of 5 fitting into 32 bits.
+                    for (; e >= 13; e -= 13) {
+                        multiply(UINT32_C(1220703125));
+                    }
+                    stdr::uint_least32_t m = 1;
+                    for (; e > 0; --e) {
+                        m *= 5;
+                    }
+                    multiply(m);
+                }
+
+                JKJ_CONSTEXPR14 void multiply_pow2(int e) noexcept {
+                    auto const limb_shift = stdr::size_t(e / 32);
+                    auto const bit_shift = e % 32;
+                    if (bit_shift != 0) {
+                        multiply(stdr::uint_least32_t(1) << bit_shift);
+                    }
+                    if (limb_shift != 0) {
+                        assert(size + limb_shift <= max_limbs);
+                        for (auto i = size; i > 0; --i) {
+                            limbs[i - 1 + limb_shift] = limbs[i - 1];
+                        }
+                        for (stdr::size_t i = 0; i < limb_shift; ++i) {
+                            limbs[i] = 0;
+                        }
+                        size += limb_shift;
+                    }
+                }
+
+                // Divides by d and returns the remainder.
+                JKJ_CONSTEXPR14 stdr::uint_least32_t divide(stdr::uint_least32_t d) noexcept {
+                    stdr::uint_least64_t remainder = 0;
+                    for (auto i = size; i > 0; --i) {
+                        auto const dividend = (remainder << 32) | limbs[i - 1];
+                        limbs[i - 1] = stdr::uint_least32_t(dividend / d);
+                        remainder = dividend % d;
+                    }
+                    while (size > 0 && limbs[size - 1] == 0) {
+                        --size;
+                    }
+                    return stdr::uint_least32_t(remainder);
+                }
+
+                JKJ_CONSTEXPR14 bool is_zero() const noexcept {
+                    for (stdr::size_t i = 0; i < size; ++i) {
+                        if (limbs[i] != 0) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                // Returns -1, 0, or 1.
+                static JKJ_CONSTEXPR14 int compare(fixed_big_uint const& x,
+                                                   fixed_big_uint const& y) noexcept {
+                    auto const size = x.size > y.size ? x.size : y.size;
+                    for (auto i = size; i > 0; --i) {
+                        auto const xi = i <= x.size ? x.limbs[i - 1] : 0;
+                        auto const yi = i <= y.size ? y.limbs[i - 1] : 0;
+                        if (xi != yi) {
+                            return xi < yi ? -1 : 1;
+                        }
+                    }
+                    return 0;
+                }
+            };
+
+            // The values compared by compare_binary_with_decimal for binary64 and the decimal
+            // exponent of its shortest representation have at most about 810 bits.
+            using capped_big_uint = fixed_big_uint<36>;
+
+            // Compares binary_significand * 2^binary_exponent with
+            // decimal_significand * 10^decimal_exponent exactly.
+            JKJ_CONSTEXPR14 inline int compare_binary_with_decimal(
+                stdr::uint_least64_t binary_significand, int binary_exponent,
+                stdr::uint_least64_t decimal_significand, int decimal_exponent) noexcept {
+                capped_big_uint x{binary_significand};
+                capped_big_uint y{decimal_significand};
+                if (decimal_exponent < 0) {
+                    x.multiply_pow5(-decimal_exponent);
+                }
+                else {
+                    y.multiply_pow5(decimal_exponent);
+                }
+                if (binary_exponent > decimal_exponent) {
+                    x.multiply_pow2(binary_exponent - decimal_exponent);
+                }
+                else {
+                    y.multiply_pow2(decimal_exponent - binary_exponent);
+                }
+                return capped_big_uint::compare(x, y);
+            }
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////
@@ -2257,6 +2412,106 @@ namespace jkj {
             compressed_cache_holder<ieee754_binary64, Dummy>::pow5_table;
 #endif
 
+        // Cache restricted to the inputs whose decimal exponent, floor(log10(|x|)), lies in
+        // [min_decimal_exponent, max_decimal_exponent].
+        // Only the entries needed for those inputs are copied into a separate table. Other inputs
+        // are still handled correctly, but through the compressed cache for binary64 and through the
+        // full cache for binary32.
+        template <class FloatFormat, int min_decimal_exponent, int max_decimal_exponent,
+                  class Dummy = void>
+        struct restricted_cache_holder {
+            static_assert(min_decimal_exponent <= max_decimal_exponent, "");
+            static_assert(min_decimal_exponent >= -400 && max_decimal_exponent <= 400, "");
+
+            using cache_entry_type = typename cache_holder<FloatFormat>::cache_entry_type;
+            static constexpr int cache_bits = cache_holder<FloatFormat>::cache_bits;
+            static constexpr int min_k = cache_holder<FloatFormat>::min_k;
+            static constexpr int max_k = cache_holder<FloatFormat>::max_k;
+
+        private:
+            struct full_cache_holder {
+                template <class ShiftAmountType, class DecimalExponentType>
+                static constexpr cache_entry_type get_cache(DecimalExponentType k) noexcept {
+                    return cache_holder<FloatFormat>::cache[detail::stdr::size_t(k - min_k)];
+                }
+            };
+            using fallback_cache_holder = typename detail::stdr::conditional<
+                detail::stdr::is_same<FloatFormat, ieee754_binary64>::value,
+                compressed_cache_holder<FloatFormat>, full_cache_holder>::type;
+
+            static constexpr int min(int x, int y) noexcept { return x < y ? x : y; }
+            static constexpr int max(int x, int y) noexcept { return x > y ? x : y; }
+            static constexpr int clamp_binary_exponent(int e) noexcept {
+                return max(FloatFormat::min_exponent - FloatFormat::significand_bits,
+                           min(e, FloatFormat::max_exponent - FloatFormat::significand_bits));
+            }
+
+            // The algorithm uses the exponent e of the input written as f * 2^e with
+            // 2^significand_bits <= f < 2^(significand_bits + 1) (or the minimum one for
+            // subnormals), so e = floor(log2(|x|)) - significand_bits.
+            static constexpr int min_binary_exponent = clamp_binary_exponent(
+                detail::log::floor_log2_pow10(min_decimal_exponent) - FloatFormat::significand_bits);
+            static constexpr int max_binary_exponent =
+                clamp_binary_exponent(detail::log::floor_log2_pow10(max_decimal_exponent + 1) -
+                                      FloatFormat::significand_bits);
+
+            // Same as impl::kappa.
+            static constexpr int kappa =
+                detail::log::floor_log10_pow2(FloatFormat::total_bits - FloatFormat::significand_bits -
+                                              2) -
+                1;
+
+        public:
+            // Same as impl::min_k and impl::max_k, but for the restricted range of exponents.
+            // The directed rounding modes may use e - 1 in place of e.
+            static constexpr int slice_min_k = max(
+                min_k,
+                min(-detail::log::floor_log10_pow2_minus_log10_4_over_3(max_binary_exponent),
+                    -detail::log::floor_log10_pow2(max_binary_exponent) + kappa));
+            static constexpr int slice_max_k = min(
+                max_k,
+                max(-detail::log::floor_log10_pow2_minus_log10_4_over_3(min_binary_exponent),
+                    -detail::log::floor_log10_pow2(min_binary_exponent - 1) + kappa));
+            static constexpr detail::stdr::size_t slice_size =
+                detail::stdr::size_t(slice_max_k - slice_min_k + 1);
+
+            using cache_holder_t = detail::array<cache_entry_type, slice_size>;
+
+#if JKJ_HAS_CONSTEXPR17
+            static constexpr cache_holder_t cache JKJ_STATIC_DATA_SECTION = [] {
+                cache_holder_t res{};
+                for (detail::stdr::size_t i = 0; i < slice_size; ++i) {
+                    res[i] = cache_holder<FloatFormat>::cache[i + detail::stdr::size_t(
+                                                                      slice_min_k - min_k)];
+                }
+                return res;
+            }();
+#else
+            template <detail::stdr::size_t... indices>
+            static constexpr cache_holder_t make_cache(detail::index_sequence<indices...>) {
+                return {cache_holder<FloatFormat>::cache[indices + (slice_min_k - min_k)]...};
+            }
+            static constexpr cache_holder_t cache JKJ_STATIC_DATA_SECTION =
+                make_cache(detail::make_index_sequence<slice_size>{});
+#endif
+
+            template <class ShiftAmountType, class DecimalExponentType>
+            static JKJ_CONSTEXPR20 cache_entry_type get_cache(DecimalExponentType k) noexcept {
+                if (k >= slice_min_k && k <= slice_max_k) {
+                    return cache[detail::stdr::size_t(k - slice_min_k)];
+                }
+                return fallback_cache_holder::template get_cache<ShiftAmountType>(k);
+            }
+        };
+#if !JKJ_HAS_INLINE_VARIABLE
+        template <class FloatFormat, int min_decimal_exponent, int max_decimal_exponent,
+                  class Dummy>
+        constexpr typename restricted_cache_holder<FloatFormat, min_decimal_exponent,
+                                                   max_decimal_exponent, Dummy>::cache_holder_t
+            restricted_cache_holder<FloatFormat, min_decimal_exponent, max_decimal_exponent,
+                                    Dummy>::cache;
+#endif
+
         ////////////////////////////////////////////////////////////////////////////////////////
         // Forward declarations of user-specializable templates used in the main algorithm.
         ////////////////////////////////////////////////////////////////////////////////////////
@@ -2853,6 +3108,27 @@ namespace jkj {
                         return cache_holder_type<FloatFormat>::template get_cache<ShiftAmountType>(k);
                     }
                 } compact = {};
+
+                // Use restricted_cache_holder<FloatFormat, MinDecimalExponent, MaxDecimalExponent>.
+                // Intended for inputs known to satisfy
+                // 10^MinDecimalExponent <= |x| < 10^(MaxDecimalExponent + 1), whose cache entries
+                // then occupy a small table. Other inputs give the same results, only slower.
+                template <int MinDecimalExponent, int MaxDecimalExponent>
+                struct restricted_t {
+                    using cache_policy = restricted_t;
+                    template <class FloatFormat>
+                    using cache_holder_type =
+                        restricted_cache_holder<FloatFormat, MinDecimalExponent, MaxDecimalExponent>;
+
+                    template <class FloatFormat, class ShiftAmountType, class DecimalExponentType>
+                    static JKJ_CONSTEXPR20 typename cache_holder<FloatFormat>::cache_entry_type
+                    get_cache(DecimalExponentType k) noexcept {
+                        assert(k >= cache_holder<FloatFormat>::min_k &&
+                               k <= cache_holder<FloatFormat>::max_k);
+
+                        return cache_holder_type<FloatFormat>::template get_cache<ShiftAmountType>(k);
+                    }
+                };
             }
 
             namespace preferred_integer_types {
@@ -3421,6 +3697,33 @@ namespace jkj {
                     auto const z_result =
                         multiplication_traits_::compute_mul(carrier_uint((two_fc | 1) << beta), cache);
 
+                    return compute_nearest_normal_interval<SignPolicy, TrailingZeroPolicy,
+                                                           BinaryToDecimalRoundingPolicy, CachePolicy,
+                                                           PreferredIntegerTypesPolicy>(
+                        s, interval_type, two_fc, minus_k, cache, beta, deltai, z_result);
+                }
+
+                // Steps 2 and 3 of the normal interval case, given the results of Step 1.
+                template <class SignPolicy, class TrailingZeroPolicy,
+                          class BinaryToDecimalRoundingPolicy, class CachePolicy,
+                          class PreferredIntegerTypesPolicy, class IntervalType,
+                          class DecimalExponentType, class CacheEntryType, class ShiftAmountType,
+                          class RemainderType, class ComputeMulResult>
+                JKJ_FORCEINLINE JKJ_SAFEBUFFERS static JKJ_CONSTEXPR20
+                    return_type<SignPolicy, TrailingZeroPolicy, PreferredIntegerTypesPolicy>
+                    compute_nearest_normal_interval(signed_significand_bits<FormatTraits> s,
+                                                    IntervalType interval_type, carrier_uint two_fc,
+                                                    DecimalExponentType minus_k,
+                                                    CacheEntryType const& cache, ShiftAmountType beta,
+                                                    RemainderType deltai,
+                                                    ComputeMulResult z_result) noexcept {
+                    using cache_holder_type = typename CachePolicy::template cache_holder_type<format>;
+                    using remainder_type_ = remainder_type<PreferredIntegerTypesPolicy>;
+                    using decimal_exponent_type_ = decimal_exponent_type<PreferredIntegerTypesPolicy>;
+                    using multiplication_traits_ =
+                        multiplication_traits<FormatTraits,
+                                              typename cache_holder_type::cache_entry_type,
+                                              cache_holder_type::cache_bits>;
 
                     //////////////////////////////////////////////////////////////////////
                     // Step 2: Try larger divisor; remove trailing zeros if necessary.
@@ -3550,6 +3853,99 @@ namespace jkj {
                                decimal_significand, decimal_exponent_type_(minus_k + kappa)));
                 }
 
+                // Runs Step 1 of N independent inputs in lockstep, so that the multiplications for
+                // different inputs can overlap, and then finishes each input separately. Inputs
+                // falling into the shorter interval case are rare and are delegated to the scalar
+                // path.
+                template <class SignPolicy, class TrailingZeroPolicy, class IntervalTypeProvider,
+                          class BinaryToDecimalRoundingPolicy, class CachePolicy,
+                          class PreferredIntegerTypesPolicy, stdr::size_t N>
+                JKJ_SAFEBUFFERS static JKJ_CONSTEXPR20 void compute_nearest_xn(
+                    signed_significand_bits<FormatTraits> const* s, exponent_int const* exponent_bits,
+                    return_type<SignPolicy, TrailingZeroPolicy, PreferredIntegerTypesPolicy>*
+                        results) noexcept {
+                    using cache_holder_type = typename CachePolicy::template cache_holder_type<format>;
+                    static_assert(
+                        min_k >= cache_holder_type::min_k && max_k <= cache_holder_type::max_k, "");
+
+                    using remainder_type_ = remainder_type<PreferredIntegerTypesPolicy>;
+                    using decimal_exponent_type_ = decimal_exponent_type<PreferredIntegerTypesPolicy>;
+                    using shift_amount_type =
+                        typename PreferredIntegerTypesPolicy::template shift_amount_type<FormatTraits>;
+
+                    using multiplication_traits_ =
+                        multiplication_traits<FormatTraits,
+                                              typename cache_holder_type::cache_entry_type,
+                                              cache_holder_type::cache_bits>;
+
+                    carrier_uint two_fc[N];
+                    exponent_int binary_exponent[N];
+                    bool is_shorter_interval[N];
+                    for (stdr::size_t i = 0; i < N; ++i) {
+                        two_fc[i] = s[i].remove_sign_bit_and_shift();
+                        is_shorter_interval[i] = false;
+                        if (exponent_bits[i] != 0) {
+                            binary_exponent[i] = exponent_int(
+                                exponent_bits[i] + format::exponent_bias - format::significand_bits);
+                            is_shorter_interval[i] = two_fc[i] == 0;
+                            two_fc[i] |= (carrier_uint(1) << (format::significand_bits + 1));
+                        }
+                        else {
+                            binary_exponent[i] = format::min_exponent - format::significand_bits;
+                        }
+                    }
+
+                    //////////////////////////////////////////////////////////////////////
+                    // Step 1: Schubfach multiplier calculation, for all inputs.
+                    //////////////////////////////////////////////////////////////////////
+
+                    decimal_exponent_type_ minus_k[N];
+                    typename cache_holder_type::cache_entry_type cache[N];
+                    shift_amount_type beta[N];
+                    for (stdr::size_t i = 0; i < N; ++i) {
+                        minus_k[i] = decimal_exponent_type_(
+                            log::floor_log10_pow2<min_exponent - format::significand_bits,
+                                                  max_exponent - format::significand_bits,
+                                                  decimal_exponent_type_>(binary_exponent[i]) -
+                            kappa);
+                        cache[i] = CachePolicy::template get_cache<format, shift_amount_type>(
+                            decimal_exponent_type_(-minus_k[i]));
+                        beta[i] = shift_amount_type(
+                            binary_exponent[i] +
+                            log::floor_log2_pow10<min_k, max_k>(decimal_exponent_type_(-minus_k[i])));
+                    }
+
+                    remainder_type_ deltai[N];
+                    typename multiplication_traits_::compute_mul_result z_result[N];
+                    for (stdr::size_t i = 0; i < N; ++i) {
+                        deltai[i] = static_cast<remainder_type_>(
+                            multiplication_traits_::compute_delta(cache[i], beta[i]));
+                        z_result[i] = multiplication_traits_::compute_mul(
+                            carrier_uint((two_fc[i] | 1) << beta[i]), cache[i]);
+                    }
+
+                    //////////////////////////////////////////////////////////////////////
+                    // Steps 2 and 3, for each input.
+                    //////////////////////////////////////////////////////////////////////
+
+                    for (stdr::size_t i = 0; i < N; ++i) {
+                        if (is_shorter_interval[i]) {
+                            results[i] = compute_nearest<SignPolicy, TrailingZeroPolicy,
+                                                         IntervalTypeProvider,
+                                                         BinaryToDecimalRoundingPolicy, CachePolicy,
+                                                         PreferredIntegerTypesPolicy>(
+                                s[i], exponent_bits[i]);
+                        }
+                        else {
+                            results[i] = compute_nearest_normal_interval<
+                                SignPolicy, TrailingZeroPolicy, BinaryToDecimalRoundingPolicy,
+                                CachePolicy, PreferredIntegerTypesPolicy>(
+                                s[i], IntervalTypeProvider::normal_interval(s[i]), two_fc[i],
+                                minus_k[i], cache[i], beta[i], deltai[i], z_result[i]);
+                        }
+                    }
+                }
+
                 template <class SignPolicy, class TrailingZeroPolicy, class CachePolicy,
                           class PreferredIntegerTypesPolicy>
                 JKJ_FORCEINLINE JKJ_SAFEBUFFERS static JKJ_CONSTEXPR20
@@ -4132,6 +4528,53 @@ namespace jkj {
                     }
                 }
             };
+
+            template <class T>
+            struct void_type {
+                using type = void;
+            };
+
+            // Inputs are processed in lockstep only for the rounding modes whose interval type does
+            // not depend on the input; otherwise, the scalar path is called for each input.
+            template <class FormatTraits, class PolicyHolder, stdr::size_t N, class = void>
+            struct to_decimal_xn_dispatcher {
+                using return_type =
+                    typename to_decimal_dispatcher<FormatTraits, PolicyHolder>::return_type;
+
+                JKJ_FORCEINLINE JKJ_SAFEBUFFERS static JKJ_CONSTEXPR20 void
+                compute(signed_significand_bits<FormatTraits> const* s,
+                        typename FormatTraits::exponent_int const* exponent_bits,
+                        return_type* results) noexcept {
+                    for (stdr::size_t i = 0; i < N; ++i) {
+                        results[i] = PolicyHolder::delegate(
+                            s[i], to_decimal_dispatcher<FormatTraits, PolicyHolder>{}, s[i],
+                            exponent_bits[i]);
+                    }
+                }
+            };
+
+            template <class FormatTraits, class PolicyHolder, stdr::size_t N>
+            struct to_decimal_xn_dispatcher<
+                FormatTraits, PolicyHolder, N,
+                typename void_type<typename PolicyHolder::decimal_to_binary_rounding_policy::
+                                       interval_type_provider>::type> {
+                using return_type =
+                    typename to_decimal_dispatcher<FormatTraits, PolicyHolder>::return_type;
+
+                JKJ_FORCEINLINE JKJ_SAFEBUFFERS static JKJ_CONSTEXPR20 void
+                compute(signed_significand_bits<FormatTraits> const* s,
+                        typename FormatTraits::exponent_int const* exponent_bits,
+                        return_type* results) noexcept {
+                    impl<FormatTraits>::template compute_nearest_xn<
+                        typename PolicyHolder::sign_policy, typename PolicyHolder::trailing_zero_policy,
+                        typename PolicyHolder::decimal_to_binary_rounding_policy::
+                            interval_type_provider,
+                        typename PolicyHolder::binary_to_decimal_rounding_policy,
+                        typename PolicyHolder::cache_policy,
+                        typename PolicyHolder::preferred_integer_types_policy, N>(s, exponent_bits,
+                                                                                  results);
+                }
+            };
         }
 
 
@@ -4166,6 +4609,58 @@ namespace jkj {
 
             return to_decimal_ex(s, exponent_bits, policies...);
         }
+
+        // Converts N inputs at once; results[i] is identical to to_decimal(x[i], policies...).
+        // Independent inputs are processed in lockstep so that their multiplications can overlap.
+        // Whether this is faster than calling to_decimal in a loop depends on the target, so
+        // measure it before switching.
+        template <detail::stdr::size_t N, class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        JKJ_FORCEINLINE JKJ_SAFEBUFFERS JKJ_CONSTEXPR20 void
+        to_decimal_xn(Float const* x,
+                      detail::to_decimal_return_type<FormatTraits, Policies...>* results,
+                      Policies...) noexcept {
+            using policy_holder = detail::to_decimal_policy_holder<Policies...>;
+
+            signed_significand_bits<FormatTraits> s[N];
+            typename FormatTraits::exponent_int exponent_bits[N];
+            for (detail::stdr::size_t i = 0; i < N; ++i) {
+                auto const br = make_float_bits<Float, ConversionTraits, FormatTraits>(x[i]);
+                exponent_bits[i] = br.extract_exponent_bits();
+                s[i] = br.remove_exponent_bits();
+                assert(br.is_finite() && br.is_nonzero());
+            }
+
+            detail::to_decimal_xn_dispatcher<FormatTraits, policy_holder, N>::compute(
+                s, exponent_bits, results);
+        }
+
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        JKJ_FORCEINLINE JKJ_SAFEBUFFERS JKJ_CONSTEXPR20 void
+        to_decimal_x2(Float const* x,
+                      detail::to_decimal_return_type<FormatTraits, Policies...>* results,
+                      Policies... policies) noexcept {
+            to_decimal_xn<2, Float, ConversionTraits, FormatTraits>(x, results, policies...);
+        }
+
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        JKJ_FORCEINLINE JKJ_SAFEBUFFERS JKJ_CONSTEXPR20 void
+        to_decimal_x4(Float const* x,
+                      detail::to_decimal_return_type<FormatTraits, Policies...>* results,
+                      Policies... policies) noexcept {
+            to_decimal_xn<4, Float, ConversionTraits, FormatTraits>(x, results, policies...);
+        }
     }
 }
 
@@ -0,0 +1,320 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_DRAGONBOX_BID
+#define JKJ_HEADER_DRAGONBOX_BID
+
+#include "dragonbox.h"
+
+// Conversion of binary floating-point numbers into IEEE-754 decimal floating-point numbers with
+// the binary integer decimal (BID) encoding.
+// The result is the shortest decimal representation given by to_decimal if it fits into the
+// precision and the exponent range of the decimal format, and otherwise the binary number correctly
+// rounded to the decimal format with round-half-to-even, as convertFormat of IEEE-754 does. The
+// exponent is that of the shortest representation: for example, 1.5 becomes 15 * 10^-1 rather
+// than 1500000 * 10^-6.
+// +-0 becomes +-0 * 10^0, +-Infinity becomes +-Infinity, and NaN's become quiet NaN's with zero
+// payload and the same sign.
+
+namespace jkj {
+    namespace dragonbox {
+        struct ieee754_decimal32 {
+            static constexpr int total_bits = 32;
+            static constexpr int exponent_bits = 8;
+            static constexpr int precision = 7;
+            static constexpr int min_exponent = -101;
+            static constexpr int max_exponent = 90;
+            static constexpr int exponent_bias = 101;
+        };
+        struct ieee754_decimal64 {
+            static constexpr int total_bits = 64;
+            static constexpr int exponent_bits = 10;
+            static constexpr int precision = 16;
+            static constexpr int min_exponent = -398;
+            static constexpr int max_exponent = 369;
+            static constexpr int exponent_bias = 398;
+        };
+        struct ieee754_decimal128 {
+            static constexpr int total_bits = 128;
+            static constexpr int exponent_bits = 14;
+            static constexpr int precision = 34;
+            static constexpr int min_exponent = -6176;
+            static constexpr int max_exponent = 6111;
+            static constexpr int exponent_bias = 6176;
+        };
+
+        // Bit pattern of a decimal128, split into two halves.
+        struct bid128 {
+            detail::stdr::uint_least64_t high;
+            detail::stdr::uint_least64_t low;
+        };
+
+        namespace detail {
+            inline int bid_decimal_length(stdr::uint_least64_t n) noexcept {
+                int length = 1;
+                while (length < 20 && n >= pow10_table_holder<>::table[length]) {
+                    ++length;
+                }
+                return length;
+            }
+
+            // A finite decimal number c * 10^q that fits into the target format.
+            struct bid_decimal {
+                stdr::uint_least64_t coefficient;
+                int exponent;
+                bool is_overflow;
+            };
+
+            // Fits x = binary_significand * 2^binary_exponent, whose shortest representation is
+            // s * 10^k, into the precision and the exponent range of DecimalFormat.
+            template <class DecimalFormat>
+            bid_decimal bid_normalize(stdr::uint_least64_t s, int k,
+                                      stdr::uint_least64_t binary_significand,
+                                      int binary_exponent) noexcept {
+                static_assert(DecimalFormat::precision <= 19 || DecimalFormat::total_bits == 128,
+                              "");
+                auto length = bid_decimal_length(s);
+
+                // The number of digits to round off, for the precision and then for the minimum
+                // exponent, rounded off at once.
+                auto r = length > DecimalFormat::precision ? length - DecimalFormat::precision : 0;
+                if (k + r < DecimalFormat::min_exponent) {
+                    r = DecimalFormat::min_exponent - k;
+                }
+                if (r > length) {
+                    // x is smaller than 10^(k + length), which is at most 10^min_exponent / 10.
+                    s = 0;
+                    k += r;
+                    length = 1;
+                }
+                else if (r > 0) {
+                    // Since s * 10^k lies within the rounding interval of x and is the closest one to
+                    // x among the candidates with at most length digits, there is no number with
+                    // fewer digits in between, so rounding it gives the same result as rounding x
+                    // itself, unless the digits rounded off are exactly one-half. In that case, x is
+                    // compared with s * 10^k exactly.
+                    auto const divisor = pow10_table_holder<>::table[r];
+                    auto const quotient = s / divisor;
+                    auto const remainder = s % divisor;
+                    auto round_up = remainder > divisor / 2;
+                    if (remainder == divisor / 2) {
+                        auto const comparison =
+                            compare_binary_with_decimal(binary_significand, binary_exponent, s, k);
+                        round_up = comparison > 0 || (comparison == 0 && quotient % 2 != 0);
+                    }
+                    s = quotient + (round_up ? 1 : 0);
+                    k += r;
+                    length -= r;
+                    if (s == pow10_table_holder<>::table[length]) {
+                        if (length == DecimalFormat::precision) {
+                            s /= 10;
+                            ++k;
+                        }
+                        else {
+                            ++length;
+                        }
+                    }
+                }
+
+                // A too large exponent is clamped by appending zeros to the coefficient if it
+                // still fits.
+                if (k > DecimalFormat::max_exponent) {
+                    auto const shift = k - DecimalFormat::max_exponent;
+                    if (length + shift > DecimalFormat::precision) {
+                        return {0, 0, true};
+                    }
+                    s *= pow10_table_holder<>::table[shift];
+                    k = DecimalFormat::max_exponent;
+                }
+                return {s, k, false};
+            }
+
+            template <class DecimalFormat>
+            struct bid_encoder;
+
+            // For 32 and 64 bits: if the coefficient fits into the bits after the sign and the
+            // exponent, it is stored there. Otherwise, its leading bits are the implicit 100,
+            // the combination field starts with 11, and the exponent is shifted by 2 bits.
+            template <class DecimalFormat, class CarrierUInt>
+            struct bid_small_encoder {
+                using carrier_uint = CarrierUInt;
+                static constexpr int coefficient_bits =
+                    DecimalFormat::total_bits - 1 - DecimalFormat::exponent_bits;
+
+                static carrier_uint sign_bit(bool is_negative) noexcept {
+                    return carrier_uint(is_negative ? 1 : 0) << (DecimalFormat::total_bits - 1);
+                }
+
+                static carrier_uint finite(bool is_negative, bid_decimal d) noexcept {
+                    auto const biased_exponent =
+                        carrier_uint(d.exponent + DecimalFormat::exponent_bias);
+                    auto const coefficient = carrier_uint(d.coefficient);
+                    if (coefficient < (carrier_uint(1) << coefficient_bits)) {
+                        return sign_bit(is_negative) | (biased_exponent << coefficient_bits) |
+                               coefficient;
+                    }
+                    else {
+                        return sign_bit(is_negative) |
+                               (carrier_uint(3) << (DecimalFormat::total_bits - 3)) |
+                               (biased_exponent << (coefficient_bits - 2)) |
+                               (coefficient & ((carrier_uint(1) << (coefficient_bits - 2)) - 1));
+                    }
+                }
+
+                static carrier_uint infinity(bool is_negative) noexcept {
+                    return sign_bit(is_negative) |
+                           (carrier_uint(0x78) << (DecimalFormat::total_bits - 8));
+                }
+
+                static carrier_uint nan(bool is_negative) noexcept {
+                    return sign_bit(is_negative) |
+                           (carrier_uint(0x7c) << (DecimalFormat::total_bits - 8));
+                }
+            };
+
+            template <>
+            struct bid_encoder<ieee754_decimal32>
+                : bid_small_encoder<ieee754_decimal32, stdr::uint_least32_t> {};
+
+            template <>
+            struct bid_encoder<ieee754_decimal64>
+                : bid_small_encoder<ieee754_decimal64, stdr::uint_least64_t> {};
+
+            // For 128 bits, coefficients coming from binary64 or smaller always fit into the low
+            // half, so only the first form is needed.
+            template <>
+            struct bid_encoder<ieee754_decimal128> {
+                using carrier_uint = bid128;
+                static constexpr int high_coefficient_bits =
+                    64 - 1 - ieee754_decimal128::exponent_bits;
+
+                static stdr::uint_least64_t sign_bit(bool is_negative) noexcept {
+                    return stdr::uint_least64_t(is_negative ? 1 : 0) << 63;
+                }
+
+                static bid128 finite(bool is_negative, bid_decimal d) noexcept {
+                    auto const biased_exponent =
+                        stdr::uint_least64_t(d.exponent + ieee754_decimal128::exponent_bias);
+                    return {sign_bit(is_negative) | (biased_exponent << high_coefficient_bits),
+                            d.coefficient};
+                }
+
+                static bid128 infinity(bool is_negative) noexcept {
+                    return {sign_bit(is_negative) | (UINT64_C(0x78) << 56), 0};
+                }
+
+                static bid128 nan(bool is_negative) noexcept {
+                    return {sign_bit(is_negative) | (UINT64_C(0x7c) << 56), 0};
+                }
+            };
+
+            template <class DecimalFormat, class Float, class ConversionTraits, class FormatTraits>
+            typename bid_encoder<DecimalFormat>::carrier_uint to_bid_impl(Float x) noexcept {
+                using encoder = bid_encoder<DecimalFormat>;
+                static_assert(FormatTraits::format::decimal_significand_digits <= 19, "");
+
+                auto const br = make_float_bits<Float, ConversionTraits, FormatTraits>(x);
+                auto const exponent_bits = br.extract_exponent_bits();
+                auto const s = br.remove_exponent_bits();
+                auto const is_negative = s.is_negative();
+
+                if (br.is_finite(exponent_bits)) {
+                    if (br.is_nonzero()) {
+                        auto const result =
+                            to_decimal_ex(s, exponent_bits, policy::sign::ignore,
+                                          policy::trailing_zero::remove);
+                        auto const d = bid_normalize<DecimalFormat>(
+                            stdr::uint_least64_t(result.significand), int(result.exponent),
+                            br.binary_significand(),
+                            int(br.binary_exponent()) - FormatTraits::format::significand_bits);
+                        return d.is_overflow ? encoder::infinity(is_negative)
+                                             : encoder::finite(is_negative, d);
+                    }
+                    else {
+                        return encoder::finite(is_negative, {0, 0, false});
+                    }
+                }
+                else if (s.has_all_zero_significand_bits()) {
+                    return encoder::infinity(is_negative);
+                }
+                else {
+                    return encoder::nan(is_negative);
+                }
+            }
+        }
+
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>>
+        detail::stdr::uint_least32_t to_bid32(Float x) noexcept {
+            return detail::to_bid_impl<ieee754_decimal32, Float, ConversionTraits, FormatTraits>(x);
+        }
+
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>>
+        detail::stdr::uint_least64_t to_bid64(Float x) noexcept {
+            return detail::to_bid_impl<ieee754_decimal64, Float, ConversionTraits, FormatTraits>(x);
+        }
+
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>>
+        bid128 to_bid128(Float x) noexcept {
+            return detail::to_bid_impl<ieee754_decimal128, Float, ConversionTraits, FormatTraits>(
+                x);
+        }
+
+        // Batch variants; results[i] is the conversion of x[i] for each i < count.
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>>
+        void to_bid32_n(Float const* x, detail::stdr::uint_least32_t* results,
+                        detail::stdr::size_t count) noexcept {
+            for (detail::stdr::size_t i = 0; i < count; ++i) {
+                results[i] = to_bid32<Float, ConversionTraits, FormatTraits>(x[i]);
+            }
+        }
+
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>>
+        void to_bid64_n(Float const* x, detail::stdr::uint_least64_t* results,
+                        detail::stdr::size_t count) noexcept {
+            for (detail::stdr::size_t i = 0; i < count; ++i) {
+                results[i] = to_bid64<Float, ConversionTraits, FormatTraits>(x[i]);
+            }
+        }
+
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>>
+        void to_bid128_n(Float const* x, bid128* results, detail::stdr::size_t count) noexcept {
+            for (detail::stdr::size_t i = 0; i < count; ++i) {
+                results[i] = to_bid128<Float, ConversionTraits, FormatTraits>(x[i]);
+            }
+        }
+    }
+}
+
+#endif
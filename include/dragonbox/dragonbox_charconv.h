@@ -0,0 +1,706 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_DRAGONBOX_CHARCONV
+#define JKJ_HEADER_DRAGONBOX_CHARCONV
+
+#include "dragonbox_hexfloat.h"
+#include "dragonbox_to_chars.h"
+
+#include <system_error>
+
+// An interface in the style of std::to_chars of C++17, which writes into [first, last) without
+// assuming any minimum size of the buffer. If the output does not fit, {last,
+// std::errc::value_too_large} is returned and the contents of [first, last) are unspecified.
+//
+// The default chars_format{} gives the output of to_chars_n with the given policies. It is written
+// in place if there are at least max_notation_output_string_length characters left, and otherwise
+// through a scratch buffer. With a precision, it gives the output of to_chars_n_capped instead.
+//
+// The other formats give the same output as std::to_chars, e.g. "1.5e+00", "0.1", "1.8p+0", "inf"
+// or "-nan", with or without a precision. Ties are broken to even, and the digits beyond the
+// shortest representation are those of the exact binary value, e.g. 1.00000000000000005551e-01 for
+// 0.1 with the precision 20. Policies are ignored for these formats.
+//
+// These live in the namespace charconv, because the to_chars(Float, char*, Policies...) of
+// dragonbox_to_chars.h rejects a char* in the place of Float with a hard error, which rules out
+// overloads in the same namespace.
+
+namespace jkj {
+    namespace dragonbox {
+        namespace charconv {
+            enum class chars_format : unsigned int {
+                scientific = 1,
+                fixed = 2,
+                hex = 4,
+                general = fixed | scientific
+            };
+
+            struct to_chars_result {
+                char* ptr;
+                std::errc ec;
+            };
+        }
+
+        namespace detail {
+            // The number digits[0].digits[1]...digits[length - 1] * 10^exponent, followed by as many
+            // zeros as needed.
+            struct charconv_decimal {
+                char const* digits;
+                int length;
+                int exponent;
+            };
+
+            inline charconv::to_chars_result charconv_copy(char const* buffer,
+                                                           char const* buffer_last, char* first,
+                                                           char* last) noexcept {
+                auto const length = stdr::size_t(buffer_last - buffer);
+                if (length > stdr::size_t(last - first)) {
+                    return {last, std::errc::value_too_large};
+                }
+                stdr::memcpy(first, buffer, length);
+                return {first + length, std::errc{}};
+            }
+
+            inline char* fill_zeros(char* buffer, stdr::size_t count) noexcept {
+                for (; count != 0; --count) {
+                    *buffer = '0';
+                    ++buffer;
+                }
+                return buffer;
+            }
+
+            // Prints n with at least min_length digits.
+            inline char* print_charconv_exponent(unsigned int n, int min_length,
+                                                 char* buffer) noexcept {
+                int length = 1;
+                for (auto m = n; m >= 10; m /= 10) {
+                    ++length;
+                }
+                length = length < min_length ? min_length : length;
+                for (int i = length - 1; i >= 0; --i) {
+                    buffer[i] = char('0' + n % 10);
+                    n /= 10;
+                }
+                return buffer + length;
+            }
+
+            inline stdr::size_t charconv_exponent_length(int exponent) noexcept {
+                // 'e', the sign, and at least two digits.
+                return exponent <= -100 || exponent >= 100 ? 5 : 4;
+            }
+
+            inline stdr::size_t charconv_scientific_length(charconv_decimal d,
+                                                           stdr::size_t fraction_length) noexcept {
+                return 1 + (fraction_length != 0 ? 1 + fraction_length : 0) +
+                       charconv_exponent_length(d.exponent);
+            }
+
+            inline char* write_charconv_scientific(charconv_decimal d, stdr::size_t fraction_length,
+                                                   char* buffer) noexcept {
+                *buffer = d.digits[0];
+                ++buffer;
+                if (fraction_length != 0) {
+                    *buffer = '.';
+                    ++buffer;
+                    auto const digits = stdr::size_t(d.length - 1) < fraction_length
+                                            ? stdr::size_t(d.length - 1)
+                                            : fraction_length;
+                    stdr::memcpy(buffer, d.digits + 1, digits);
+                    buffer = fill_zeros(buffer + digits, fraction_length - digits);
+                }
+                buffer[0] = 'e';
+                buffer[1] = d.exponent < 0 ? '-' : '+';
+                return print_charconv_exponent(
+                    unsigned(d.exponent < 0 ? -d.exponent : d.exponent), 2, buffer + 2);
+            }
+
+            inline stdr::size_t charconv_fixed_length(charconv_decimal d,
+                                                      stdr::size_t fraction_length) noexcept {
+                return (d.exponent >= 0 ? stdr::size_t(d.exponent) + 1 : 1) +
+                       (fraction_length != 0 ? 1 + fraction_length : 0);
+            }
+
+            inline char* write_charconv_fixed(charconv_decimal d, stdr::size_t fraction_length,
+                                              char* buffer) noexcept {
+                auto const length = stdr::size_t(d.length);
+                stdr::size_t next_digit = 0;
+                if (d.exponent >= 0) {
+                    auto const integer_length = stdr::size_t(d.exponent) + 1;
+                    next_digit = length < integer_length ? length : integer_length;
+                    stdr::memcpy(buffer, d.digits, next_digit);
+                    buffer = fill_zeros(buffer + next_digit, integer_length - next_digit);
+                }
+                else {
+                    *buffer = '0';
+                    ++buffer;
+                }
+                if (fraction_length == 0) {
+                    return buffer;
+                }
+
+                *buffer = '.';
+                ++buffer;
+                auto leading_zeros = d.exponent < 0 ? stdr::size_t(-d.exponent - 1) : 0;
+                leading_zeros = leading_zeros < fraction_length ? leading_zeros : fraction_length;
+                buffer = fill_zeros(buffer, leading_zeros);
+                auto digits = length - next_digit;
+                digits = digits < fraction_length - leading_zeros ? digits
+                                                                  : fraction_length - leading_zeros;
+                stdr::memcpy(buffer, d.digits + next_digit, digits);
+                return fill_zeros(buffer + digits, fraction_length - leading_zeros - digits);
+            }
+
+            inline charconv::to_chars_result
+            write_charconv_decimal(char* first, char* last, bool is_negative, charconv_decimal d,
+                                   bool is_scientific, stdr::size_t fraction_length) noexcept {
+                auto const length =
+                    (is_negative ? 1 : 0) +
+                    (is_scientific ? charconv_scientific_length(d, fraction_length)
+                                   : charconv_fixed_length(d, fraction_length));
+                if (length > stdr::size_t(last - first)) {
+                    return {last, std::errc::value_too_large};
+                }
+                if (is_negative) {
+                    *first = '-';
+                    ++first;
+                }
+                return {is_scientific ? write_charconv_scientific(d, fraction_length, first)
+                                      : write_charconv_fixed(d, fraction_length, first),
+                        std::errc{}};
+            }
+
+            // The style of printf("%g") with the precision P, without trailing zeros.
+            inline charconv::to_chars_result write_charconv_general(char* first, char* last,
+                                                                    bool is_negative,
+                                                                    charconv_decimal d,
+                                                                    int precision) noexcept {
+                if (d.exponent >= -4 && d.exponent < precision) {
+                    auto const fraction_length = d.length - 1 - d.exponent;
+                    return write_charconv_decimal(
+                        first, last, is_negative, d, false,
+                        stdr::size_t(fraction_length > 0 ? fraction_length : 0));
+                }
+                return write_charconv_decimal(first, last, is_negative, d, true,
+                                              stdr::size_t(d.length - 1));
+            }
+
+            inline charconv::to_chars_result write_charconv_special(char* first, char* last,
+                                                                    bool is_negative,
+                                                                    bool is_nan) noexcept {
+                if (stdr::size_t(last - first) < (is_negative ? 4u : 3u)) {
+                    return {last, std::errc::value_too_large};
+                }
+                if (is_negative) {
+                    *first = '-';
+                    ++first;
+                }
+                stdr::memcpy(first, is_nan ? "nan" : "inf", 3);
+                return {first + 3, std::errc{}};
+            }
+
+            // Prints significand * 10^exponent (significand != 0) with to_chars into buffer of
+            // max_output_string_length characters, and returns its digits without trailing zeros.
+            template <class FloatFormat, class CarrierUInt>
+            charconv_decimal print_charconv_decimal(CarrierUInt significand, int exponent,
+                                                    char* buffer) noexcept {
+                exponent += decimal_length(significand) - 1;
+                auto const last =
+                    to_chars<FloatFormat>(significand, exponent - decimal_length(significand) + 1,
+                                          buffer);
+
+                // The output is d[.ddd]E[-]ddd; remove the decimal point.
+                auto const abs_exponent = exponent < 0 ? -exponent : exponent;
+                auto const exponent_marker = last - 2 - (exponent < 0 ? 1 : 0) -
+                                             (abs_exponent >= 10 ? 1 : 0) -
+                                             (abs_exponent >= 100 ? 1 : 0);
+                auto const length = int(exponent_marker - buffer);
+                buffer[1] = buffer[0];
+                return {buffer + 1, length > 1 ? length - 1 : 1, exponent};
+            }
+
+            // Bounds on the exact decimal expansion of a finite value of the format, which is
+            // binary_significand * 2^e for e >= 0 and binary_significand * 5^-e * 10^e otherwise.
+            template <class FloatFormat>
+            struct charconv_exact_bounds {
+                static constexpr int min_binary_exponent =
+                    FloatFormat::min_exponent - FloatFormat::significand_bits;
+                // log2(5) < 2.322.
+                static constexpr int max_bits_negative =
+                    FloatFormat::significand_bits + 2 - min_binary_exponent * 2322 / 1000;
+                static constexpr int max_bits_nonnegative = FloatFormat::max_exponent + 1;
+                static constexpr int max_bits = max_bits_negative > max_bits_nonnegative
+                                                    ? max_bits_negative
+                                                    : max_bits_nonnegative;
+                static constexpr stdr::size_t max_limbs = stdr::size_t(max_bits / 32 + 2);
+                // log10(2) < 0.30103, plus room for printing 9 digits at a time.
+                static constexpr stdr::size_t max_digits =
+                    stdr::size_t(max_bits * 30103 / 100000 + 1 + 9);
+                // Rounding at 10^-max_precision or below, or at max_precision digits after the
+                // leading digit, never changes the value.
+                static constexpr int max_precision = FloatFormat::max_exponent - min_binary_exponent;
+            };
+
+            // Rounds the exact value of br (finite, nonzero) to the digit for 10^-precision if
+            // is_fixed, and otherwise to precision digits after the leading digit, ties to even.
+            // buffer must have charconv_exact_bounds::max_digits characters.
+            template <class FormatTraits>
+            charconv_decimal exact_charconv_decimal(float_bits<FormatTraits> br, bool is_fixed,
+                                                    int precision, char* buffer) noexcept {
+                using format = typename FormatTraits::format;
+                using bounds = charconv_exact_bounds<format>;
+
+                fixed_big_uint<bounds::max_limbs> n{br.binary_significand()};
+                auto const binary_exponent = int(br.binary_exponent()) - format::significand_bits;
+                int exponent = 0;
+                if (binary_exponent >= 0) {
+                    n.multiply_pow2(binary_exponent);
+                }
+                else {
+                    n.multiply_pow5(-binary_exponent);
+                    exponent = binary_exponent;
+                }
+
+                // Print 9 digits at a time from the end, then remove leading zeros.
+                auto digits = buffer + bounds::max_digits;
+                while (!n.is_zero()) {
+                    auto chunk = n.divide(UINT32_C(1000000000));
+                    for (int i = 0; i < 9; ++i) {
+                        --digits;
+                        *digits = char('0' + chunk % 10);
+                        chunk /= 10;
+                    }
+                }
+                while (*digits == '0') {
+                    ++digits;
+                }
+                auto length = int(buffer + bounds::max_digits - digits);
+                exponent += length - 1;
+
+                auto const position = is_fixed ? -precision : exponent - precision;
+                auto const kept = exponent - position + 1;
+                if (kept < 0) {
+                    return {"0", 1, 0};
+                }
+                if (kept < length) {
+                    bool round_up = digits[kept] > '5';
+                    if (digits[kept] == '5') {
+                        // Ties to even; the digit before the first one is 0.
+                        round_up = kept != 0 && (digits[kept - 1] - '0') % 2 != 0;
+                        for (auto i = kept + 1; i < length; ++i) {
+                            if (digits[i] != '0') {
+                                round_up = true;
+                                break;
+                            }
+                        }
+                    }
+                    length = kept;
+                    if (round_up) {
+                        while (length > 0 && digits[length - 1] == '9') {
+                            --length;
+                        }
+                        if (length == 0) {
+                            return {"1", 1, exponent + 1};
+                        }
+                        ++digits[length - 1];
+                    }
+                    else if (length == 0) {
+                        return {"0", 1, 0};
+                    }
+                }
+                while (digits[length - 1] == '0') {
+                    --length;
+                }
+                return {digits, length, exponent};
+            }
+
+            // Bits [shift, shift + 64) of the 192-bit number (high, middle, low), for 0 < shift < 192.
+            inline stdr::uint_least64_t extract_192(stdr::uint_least64_t high,
+                                                    stdr::uint_least64_t middle,
+                                                    stdr::uint_least64_t low, int shift) noexcept {
+                if (shift >= 128) {
+                    return high >> (shift - 128);
+                }
+                if (shift >= 64) {
+                    return shift == 64 ? middle : (high << (128 - shift)) | (middle >> (shift - 64));
+                }
+                return (middle << (64 - shift)) | (low >> shift);
+            }
+
+            // Computes br * 10^-position rounded to an integer with ties to even, where
+            // 10^(digits - 1) <= br * 10^-position < 10^digits for digits <= 17, by multiplying the
+            // binary significand with the cached power of 10 of the binary64 cache. The cached
+            // power is off by less than one unit of its 128 bits, which shifts the product by less
+            // than 10^17 / 2^127 < 2^-64, so the product decides the rounding unless its fractional
+            // part is within 2^-64 of one half, in which case br is compared with the midpoint
+            // exactly. Returns false if 10^-position is not in the cache.
+            template <class FormatTraits>
+            bool round_charconv_decimal_cached(float_bits<FormatTraits> br, int position,
+                                               stdr::uint_least64_t& rounded) noexcept {
+                using cache_holder_type = cache_holder<ieee754_binary64>;
+                auto const k = -position;
+                if (k < cache_holder_type::min_k || k > cache_holder_type::max_k) {
+                    return false;
+                }
+                auto const cache = cache_holder_type::cache[k - cache_holder_type::min_k];
+                auto const binary_significand = stdr::uint_least64_t(br.binary_significand());
+                auto const binary_exponent =
+                    int(br.binary_exponent()) - FormatTraits::format::significand_bits;
+
+                // cache * 2^(floor_log2_pow10(k) - 127) is approximately 10^k.
+                auto const shift = 127 - binary_exponent - int(log::floor_log2_pow10(k));
+                assert(shift > 64 && shift < 192);
+                auto const high_part = wuint::umul128(binary_significand, cache.high());
+                auto const low_part = wuint::umul128(binary_significand, cache.low());
+                auto const middle = high_part.low() + low_part.high();
+                auto const high = high_part.high() + (middle < high_part.low() ? 1 : 0);
+
+                rounded = extract_192(high, middle, low_part.low(), shift);
+                auto const fraction = extract_192(high, middle, low_part.low(), shift - 64);
+                constexpr auto half = UINT64_C(0x8000000000000000);
+                if (fraction > half) {
+                    ++rounded;
+                }
+                else if (fraction == half || fraction == half - 1) {
+                    auto const comparison = compare_binary_with_decimal(
+                        binary_significand, binary_exponent, rounded * 10 + 5, position - 1);
+                    if (comparison > 0 || (comparison == 0 && rounded % 2 != 0)) {
+                        ++rounded;
+                    }
+                }
+                return true;
+            }
+
+            // Rounds br (finite, nonzero) as exact_charconv_decimal does. In most cases the result
+            // is obtained from the shortest representation, which is the closest to br among the
+            // decimals of its length, so rounding it off gives the same result as rounding br
+            // itself, unless it is exactly at a tie. If more digits are requested than the
+            // shortest representation has, they are zeros unless the ulp of br is at least
+            // 10^position, in which case they are computed with the cached power of 10 for up to 17
+            // digits, and from the exact value otherwise.
+            template <class FormatTraits>
+            charconv_decimal round_charconv_decimal(float_bits<FormatTraits> br, bool is_fixed,
+                                                    int precision, char* buffer,
+                                                    char* exact_buffer) noexcept {
+                using format = typename FormatTraits::format;
+                using carrier_uint = typename FormatTraits::carrier_uint;
+
+                auto const result = to_decimal_ex(
+                    br.remove_exponent_bits(), br.extract_exponent_bits(), policy::sign::ignore,
+                    policy::trailing_zero::remove);
+                auto significand = carrier_uint(result.significand);
+                auto const decimal_exponent = int(result.exponent);
+                auto const length = decimal_length(significand);
+                auto exponent = decimal_exponent + length - 1;
+
+                auto const binary_significand = br.binary_significand();
+                auto const binary_exponent = int(br.binary_exponent()) - format::significand_bits;
+                int comparison = 2;
+                if (significand == 1 && !is_fixed) {
+                    // The shortest representation may be the power of 10 right above br.
+                    comparison = compare_binary_with_decimal(binary_significand, binary_exponent,
+                                                             significand, decimal_exponent);
+                    if (comparison < 0) {
+                        --exponent;
+                    }
+                }
+
+                auto const position = is_fixed ? -precision : exponent - precision;
+                if (position > decimal_exponent) {
+                    auto const kept = exponent - position + 1;
+                    if (kept < 0) {
+                        return {"0", 1, 0};
+                    }
+                    auto const divisor =
+                        carrier_uint(pow10_table_holder<>::table[position - decimal_exponent]);
+                    auto const remainder = carrier_uint(significand % divisor);
+                    significand = carrier_uint(significand / divisor);
+
+                    bool round_up = remainder > divisor / 2;
+                    if (remainder == divisor / 2) {
+                        if (comparison == 2) {
+                            comparison = compare_binary_with_decimal(
+                                binary_significand, binary_exponent, result.significand,
+                                decimal_exponent);
+                        }
+                        round_up = comparison > 0 || (comparison == 0 && significand % 2 != 0);
+                    }
+                    if (round_up) {
+                        ++significand;
+                    }
+                    if (significand == 0) {
+                        return {"0", 1, 0};
+                    }
+                    return print_charconv_decimal<format>(significand, position, buffer);
+                }
+
+                // Whether ulp < 10^position.
+                bool is_ulp_small;
+                if (position > 1233) {
+                    is_ulp_small = true;
+                }
+                else if (position < -1233) {
+                    is_ulp_small = false;
+                }
+                else {
+                    is_ulp_small =
+                        binary_exponent < log::floor_log2_pow10(position) + (position != 0 ? 1 : 0);
+                }
+                if (is_ulp_small ||
+                    (comparison == 2 ? compare_binary_with_decimal(binary_significand,
+                                                                   binary_exponent, significand,
+                                                                   decimal_exponent)
+                                     : comparison) == 0) {
+                    return print_charconv_decimal<format>(significand, decimal_exponent, buffer);
+                }
+
+                stdr::uint_least64_t rounded;
+                if (exponent - position < format::decimal_significand_digits &&
+                    round_charconv_decimal_cached(br, position, rounded)) {
+                    // Also turns 10^digits after a carry into 1.
+                    auto rounded_position = position;
+                    while (rounded % 10 == 0) {
+                        rounded /= 10;
+                        ++rounded_position;
+                    }
+                    return print_charconv_decimal<format>(carrier_uint(rounded), rounded_position,
+                                                          buffer);
+                }
+                return exact_charconv_decimal(br, is_fixed, precision, exact_buffer);
+            }
+
+            template <class FormatTraits>
+            charconv::to_chars_result to_chars_charconv_hex(float_bits<FormatTraits> br, char* first,
+                                                            char* last, int precision) noexcept {
+                using format = typename FormatTraits::format;
+                using carrier_uint = typename FormatTraits::carrier_uint;
+                constexpr int fraction_digits = hex_fraction_digits<format>::value;
+
+                auto const exponent_bits = br.extract_exponent_bits();
+                auto fraction = carrier_uint(br.extract_significand_bits()
+                                             << (fraction_digits * 4 - format::significand_bits));
+                auto leading_digit = unsigned(exponent_bits == 0 ? 0 : 1);
+                auto const exponent = br.is_nonzero() ? int(br.binary_exponent(exponent_bits)) : 0;
+
+                // The number of the digits of fraction; zeros follow up to the precision.
+                int number_of_digits = fraction_digits;
+                if (precision < 0) {
+                    if (fraction == 0) {
+                        number_of_digits = 0;
+                    }
+                    else {
+                        while ((fraction & 0xf) == 0) {
+                            fraction = carrier_uint(fraction >> 4);
+                            --number_of_digits;
+                        }
+                    }
+                }
+                else if (precision < fraction_digits) {
+                    // Round to nearest, ties to even. The leading digit may become 2, or 1 for
+                    // subnormal numbers.
+                    auto const shift = (fraction_digits - precision) * 4;
+                    auto const combined = carrier_uint(
+                        (carrier_uint(leading_digit) << (fraction_digits * 4)) | fraction);
+                    auto const remainder =
+                        carrier_uint(combined & ((carrier_uint(1) << shift) - 1));
+                    auto const half = carrier_uint(carrier_uint(1) << (shift - 1));
+                    auto rounded = carrier_uint(combined >> shift);
+                    if (remainder > half || (remainder == half && rounded % 2 != 0)) {
+                        ++rounded;
+                    }
+                    leading_digit = unsigned(rounded >> (precision * 4));
+                    fraction = carrier_uint(rounded & ((carrier_uint(1) << (precision * 4)) - 1));
+                    number_of_digits = precision;
+                }
+                auto const fraction_length =
+                    precision < 0 ? stdr::size_t(number_of_digits) : stdr::size_t(precision);
+
+                auto const abs_exponent = unsigned(exponent < 0 ? -exponent : exponent);
+                auto const length = (br.is_negative() ? 1 : 0) + 1 +
+                                    (fraction_length != 0 ? 1 + fraction_length : 0) + 2 +
+                                    stdr::size_t(abs_exponent >= 1000  ? 4
+                                                 : abs_exponent >= 100 ? 3
+                                                 : abs_exponent >= 10  ? 2
+                                                                       : 1);
+                if (length > stdr::size_t(last - first)) {
+                    return {last, std::errc::value_too_large};
+                }
+
+                if (br.is_negative()) {
+                    *first = '-';
+                    ++first;
+                }
+                *first = char('0' + leading_digit);
+                ++first;
+                if (fraction_length != 0) {
+                    *first = '.';
+                    for (int i = number_of_digits; i > 0; --i) {
+                        first[i] = "0123456789abcdef"[fraction & 0xf];
+                        fraction = carrier_uint(fraction >> 4);
+                    }
+                    first = fill_zeros(first + 1 + number_of_digits,
+                                       fraction_length - stdr::size_t(number_of_digits));
+                }
+                first[0] = 'p';
+                first[1] = exponent < 0 ? '-' : '+';
+                return {print_charconv_exponent(abs_exponent, 1, first + 2), std::errc{}};
+            }
+
+            template <class FormatTraits>
+            charconv::to_chars_result
+            to_chars_charconv_precision(float_bits<FormatTraits> br, char* first, char* last,
+                                        charconv::chars_format fmt, int precision) noexcept {
+                using format = typename FormatTraits::format;
+
+                auto const exponent_bits = br.extract_exponent_bits();
+                if (!br.is_finite(exponent_bits)) {
+                    return write_charconv_special(first, last, br.is_negative(),
+                                                  br.extract_significand_bits() != 0);
+                }
+                if (fmt == charconv::chars_format::hex) {
+                    return to_chars_charconv_hex(br, first, last, precision);
+                }
+
+                // Same as printf.
+                if (precision < 0) {
+                    precision = 6;
+                }
+                auto const is_fixed = fmt == charconv::chars_format::fixed;
+                auto const is_general = fmt == charconv::chars_format::general;
+                if (is_general && precision == 0) {
+                    precision = 1;
+                }
+                auto const max_precision = charconv_exact_bounds<format>::max_precision;
+                auto const rounding_precision =
+                    (precision < max_precision ? precision : max_precision) - (is_general ? 1 : 0);
+
+                char buffer[max_output_string_length<format>];
+                char exact_buffer[charconv_exact_bounds<format>::max_digits];
+                charconv_decimal d = {"0", 1, 0};
+                if (br.is_nonzero()) {
+                    d = round_charconv_decimal(br, is_fixed, rounding_precision, buffer,
+                                               exact_buffer);
+                }
+
+                if (is_general) {
+                    return write_charconv_general(first, last, br.is_negative(), d, precision);
+                }
+                return write_charconv_decimal(first, last, br.is_negative(), d, !is_fixed,
+                                              stdr::size_t(precision));
+            }
+
+            template <class FormatTraits>
+            charconv::to_chars_result to_chars_charconv_shortest(float_bits<FormatTraits> br,
+                                                                 char* first, char* last,
+                                                                 charconv::chars_format fmt) noexcept {
+                using format = typename FormatTraits::format;
+
+                auto const exponent_bits = br.extract_exponent_bits();
+                if (!br.is_finite(exponent_bits)) {
+                    return write_charconv_special(first, last, br.is_negative(),
+                                                  br.extract_significand_bits() != 0);
+                }
+                if (fmt == charconv::chars_format::hex) {
+                    return to_chars_charconv_hex(br, first, last, -1);
+                }
+
+                char buffer[max_output_string_length<format>];
+                charconv_decimal d = {"0", 1, 0};
+                if (br.is_nonzero()) {
+                    auto const result =
+                        to_decimal_ex(br.remove_exponent_bits(), exponent_bits, policy::sign::ignore,
+                                      policy::trailing_zero::ignore);
+                    d = print_charconv_decimal<format>(result.significand, int(result.exponent),
+                                                       buffer);
+                }
+
+                switch (fmt) {
+                case charconv::chars_format::scientific:
+                    return write_charconv_decimal(first, last, br.is_negative(), d, true,
+                                                  stdr::size_t(d.length - 1));
+
+                case charconv::chars_format::fixed:
+                    if (d.exponent - d.length + 1 > 0) {
+                        // br is an integer. Print all of its digits like printf("%.0f") does,
+                        // rather than the shortest representation followed by zeros.
+                        return to_chars_charconv_precision(br, first, last, fmt, 0);
+                    }
+                    return write_charconv_decimal(first, last, br.is_negative(), d, false,
+                                                  stdr::size_t(d.length - 1 - d.exponent));
+
+                default:
+                    assert(fmt == charconv::chars_format::general);
+                    return write_charconv_general(first, last, br.is_negative(), d, 6);
+                }
+            }
+        }
+
+        namespace charconv {
+            // Writes x into [first, last); see the comment at the top of this file.
+            template <class Float,
+                      class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                      class FormatTraits =
+                          ieee754_binary_traits<typename ConversionTraits::format,
+                                                typename ConversionTraits::carrier_uint>,
+                      class... Policies>
+            to_chars_result to_chars(char* first, char* last, Float x, chars_format fmt = {},
+                                     Policies... policies) noexcept {
+                if (fmt == chars_format{}) {
+                    constexpr auto max_length = max_notation_output_string_length<
+                        typename FormatTraits::format,
+                        typename detail::to_chars_policy_holder<Policies...>::notation_policy>;
+                    if (detail::stdr::size_t(last - first) >= max_length) {
+                        return {to_chars_n<Float, ConversionTraits, FormatTraits>(x, first,
+                                                                                  policies...),
+                                std::errc{}};
+                    }
+                    char buffer[max_length];
+                    auto const buffer_last =
+                        to_chars_n<Float, ConversionTraits, FormatTraits>(x, buffer, policies...);
+                    return detail::charconv_copy(buffer, buffer_last, first, last);
+                }
+                return detail::to_chars_charconv_shortest(
+                    make_float_bits<Float, ConversionTraits, FormatTraits>(x), first, last, fmt);
+            }
+
+            // Same as above, with the precision of printf. A negative precision means 6 for the
+            // decimal formats, and the shortest output for chars_format{} and chars_format::hex.
+            template <class Float,
+                      class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                      class FormatTraits =
+                          ieee754_binary_traits<typename ConversionTraits::format,
+                                                typename ConversionTraits::carrier_uint>>
+            to_chars_result to_chars(char* first, char* last, Float x, chars_format fmt,
+                                     int precision) noexcept {
+                if (fmt == chars_format{}) {
+                    if (precision < 0) {
+                        return to_chars<Float, ConversionTraits, FormatTraits>(first, last, x);
+                    }
+                    char buffer[max_output_string_length<typename FormatTraits::format>];
+                    auto const buffer_last = to_chars_n_capped<Float, ConversionTraits, FormatTraits>(
+                        x, buffer, precision == 0 ? 1 : precision);
+                    return detail::charconv_copy(buffer, buffer_last, first, last);
+                }
+                return detail::to_chars_charconv_precision(
+                    make_float_bits<Float, ConversionTraits, FormatTraits>(x), first, last, fmt,
+                    precision);
+            }
+        }
+    }
+}
+
+#endif
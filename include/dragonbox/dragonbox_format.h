@@ -0,0 +1,230 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_DRAGONBOX_FORMAT
+#define JKJ_HEADER_DRAGONBOX_FORMAT
+
+#include "dragonbox_to_chars.h"
+
+#if defined(__has_include)
+    #if __has_include(<version>)
+        #include <version>
+    #endif
+#endif
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+    #include <format>
+#endif
+
+// Formatters for std::format and {fmt} printing a floating-point number with to_chars_n, e.g.
+//
+//   std::format("[{:*^11}]", jkj::dragonbox::shortest(1.5)) == "[***1.5E0***]"
+//
+// The format spec is [[fill]align][sign][width], where fill is any character other than '{' or
+// '}' (a UTF-8 sequence of up to 4 bytes), align is one of '<', '>' and '^', and sign is one of
+// '+', '-' and ' '. Numbers are aligned to the right by default. Anything else, including a
+// precision or a presentation type, is a format_error. The output is formatted into a buffer on
+// the stack, and then written into the output iterator together with the padding.
+//
+// The formatter for std::format is defined if the standard library provides <format>, and the
+// one for {fmt} is defined if <fmt/format.h> is included before this header. This header requires
+// C++14.
+
+namespace jkj {
+    namespace dragonbox {
+        // A floating-point number to be formatted as to_chars_n(value, buffer, Policies{}...).
+        template <class Float, class... Policies>
+        struct shortest_fp {
+            Float value;
+        };
+
+        template <class Float, class... Policies>
+        constexpr shortest_fp<Float, Policies...> shortest(Float x, Policies...) noexcept {
+            return {x};
+        }
+
+        namespace detail {
+            struct format_spec {
+                char fill[4] = {' '};
+                int fill_length = 1;
+                char align = '>';
+                char sign = '-';
+                int width = 0;
+            };
+
+            constexpr bool is_format_align(char c) noexcept {
+                return c == '<' || c == '>' || c == '^';
+            }
+
+            // The length of the UTF-8 sequence starting with c, or 1 if c cannot start one.
+            constexpr int utf8_sequence_length(char c) noexcept {
+                return (static_cast<unsigned char>(c) & 0xe0) == 0xc0   ? 2
+                       : (static_cast<unsigned char>(c) & 0xf0) == 0xe0 ? 3
+                       : (static_cast<unsigned char>(c) & 0xf8) == 0xf0 ? 4
+                                                                         : 1;
+            }
+
+            // Parses the format spec in [first, last) into spec, and returns the position of the
+            // closing '}' (or last). valid is set to false if the spec is not of the form
+            // [[fill]align][sign][width].
+            template <class It>
+            constexpr It parse_format_spec(It first, It last, format_spec& spec, bool& valid) {
+                valid = false;
+                if (first == last) {
+                    valid = true;
+                    return first;
+                }
+
+                auto const fill_length = utf8_sequence_length(*first);
+                if (last - first > fill_length && is_format_align(first[fill_length])) {
+                    if (*first == '{' || *first == '}') {
+                        return first;
+                    }
+                    for (int i = 0; i < fill_length; ++i) {
+                        spec.fill[i] = first[i];
+                    }
+                    spec.fill_length = fill_length;
+                    spec.align = first[fill_length];
+                    first += fill_length + 1;
+                }
+                else if (is_format_align(*first)) {
+                    spec.align = *first;
+                    ++first;
+                }
+
+                if (first != last && (*first == '+' || *first == '-' || *first == ' ')) {
+                    spec.sign = *first;
+                    ++first;
+                }
+
+                if (first != last && *first >= '1' && *first <= '9') {
+                    int width = 0;
+                    do {
+                        if (width >= 100000000) {
+                            return first;
+                        }
+                        width = width * 10 + (*first - '0');
+                        ++first;
+                    } while (first != last && *first >= '0' && *first <= '9');
+                    spec.width = width;
+                }
+
+                if (first != last && *first != '}') {
+                    return first;
+                }
+                valid = true;
+                return first;
+            }
+
+            template <class OutputIt>
+            OutputIt write_format_fill(OutputIt out, format_spec const& spec, int count) {
+                for (int i = 0; i < count; ++i) {
+                    for (int j = 0; j < spec.fill_length; ++j) {
+                        *out = spec.fill[j];
+                        ++out;
+                    }
+                }
+                return out;
+            }
+
+            template <class Float, class... Policies, class OutputIt>
+            OutputIt write_formatted(OutputIt out, Float x, format_spec const& spec) {
+                using format = typename default_float_bit_carrier_conversion_traits<Float>::format;
+
+                // One more character for the sign of a positive number.
+                char buffer[1 + max_notation_output_string_length<
+                                    format,
+                                    typename to_chars_policy_holder<Policies...>::notation_policy>];
+                char* last = buffer;
+                if (spec.sign != '-' && !make_float_bits(x).is_negative()) {
+                    *last = spec.sign;
+                    ++last;
+                }
+                last = to_chars_n(x, last, Policies{}...);
+
+                auto const length = int(last - buffer);
+                auto const padding = spec.width > length ? spec.width - length : 0;
+                auto const left_padding =
+                    spec.align == '<' ? 0 : spec.align == '^' ? padding / 2 : padding;
+
+                out = write_format_fill(out, spec, left_padding);
+                for (char const* ptr = buffer; ptr != last; ++ptr) {
+                    *out = *ptr;
+                    ++out;
+                }
+                return write_format_fill(out, spec, padding - left_padding);
+            }
+        }
+    }
+}
+
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+namespace std {
+    template <class Float, class... Policies>
+    struct formatter<jkj::dragonbox::shortest_fp<Float, Policies...>, char> {
+        template <class ParseContext>
+        constexpr typename ParseContext::iterator parse(ParseContext& ctx) {
+            bool valid = false;
+            auto const it =
+                jkj::dragonbox::detail::parse_format_spec(ctx.begin(), ctx.end(), spec_, valid);
+            if (!valid) {
+                throw format_error("invalid format spec for jkj::dragonbox::shortest_fp");
+            }
+            return it;
+        }
+
+        template <class FormatContext>
+        typename FormatContext::iterator format(jkj::dragonbox::shortest_fp<Float, Policies...> x,
+                                                FormatContext& ctx) const {
+            return jkj::dragonbox::detail::write_formatted<Float, Policies...>(ctx.out(), x.value,
+                                                                              spec_);
+        }
+
+    private:
+        jkj::dragonbox::detail::format_spec spec_;
+    };
+}
+#endif
+
+#if defined(FMT_VERSION)
+namespace fmt {
+    template <class Float, class... Policies>
+    struct formatter<jkj::dragonbox::shortest_fp<Float, Policies...>, char> {
+        template <class ParseContext>
+        constexpr auto parse(ParseContext& ctx) -> decltype(ctx.begin()) {
+            bool valid = false;
+            auto const it =
+                jkj::dragonbox::detail::parse_format_spec(ctx.begin(), ctx.end(), spec_, valid);
+            if (!valid) {
+                throw format_error("invalid format spec for jkj::dragonbox::shortest_fp");
+            }
+            return it;
+        }
+
+        template <class FormatContext>
+        auto format(jkj::dragonbox::shortest_fp<Float, Policies...> x, FormatContext& ctx) const
+            -> decltype(ctx.out()) {
+            return jkj::dragonbox::detail::write_formatted<Float, Policies...>(ctx.out(), x.value,
+                                                                              spec_);
+        }
+
+    private:
+        jkj::dragonbox::detail::format_spec spec_;
+    };
+}
+#endif
+
+#endif
@@ -0,0 +1,442 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_DRAGONBOX_HEXFLOAT
+#define JKJ_HEADER_DRAGONBOX_HEXFLOAT
+
+#include "dragonbox.h"
+
+// Hexadecimal floating-point formatting and parsing, i.e., the format of printf("%a"). As the
+// significand and the exponent are read directly from the bit pattern, the output is exact and no
+// decimal conversion is involved.
+//
+// The output looks like "0x1.8p+0", "-0x1.fffffep+127", "0x0.0000000000001p-1022" (subnormals are
+// printed with the minimum exponent, as glibc does for double), "0x0p+0", "Infinity", or "NaN".
+// Hex digits are lowercase and trailing zeros of the fraction are removed.
+//
+// The parser accepts what the formatter writes, as well as uppercase hex digits, 'X' and 'P', a
+// missing "0x" prefix, a missing exponent, a leading '+' in the exponent, and any number of hex
+// digits, which are rounded to the nearest, ties to even. Like std::from_chars, it does not skip
+// whitespace nor accept a leading '+'.
+
+namespace jkj {
+    namespace dragonbox {
+        // IEEE-754 binary16. Only the hexfloat functions in this header support this format.
+        // Since there is no standard C++ type for it, a ConversionTraits class converting between
+        // the user's half-precision type and uint_least16_t needs to be supplied.
+        struct ieee754_binary16 {
+            static constexpr int total_bits = 16;
+            static constexpr int significand_bits = 10;
+            static constexpr int exponent_bits = 5;
+            static constexpr int min_exponent = -14;
+            static constexpr int max_exponent = 15;
+            static constexpr int exponent_bias = -15;
+            static constexpr int decimal_significand_digits = 5;
+            static constexpr int decimal_exponent_digits = 1;
+        };
+
+        namespace detail {
+            constexpr int hex_exponent_length(int n) noexcept {
+                return n < 10 ? 1 : hex_exponent_length(n / 10) + 1;
+            }
+
+            // Number of hex digits after the point needed for the significand bits.
+            template <class FloatFormat>
+            struct hex_fraction_digits {
+                static constexpr int value = (FloatFormat::significand_bits + 3) / 4;
+            };
+        }
+
+        // Maximum required buffer size for to_chars_hex_n (excluding null-terminator).
+        template <class FloatFormat>
+        constexpr detail::stdr::size_t max_hex_output_string_length() noexcept {
+            // sign(1) + prefix(2) + leading digit(1) + point(1) + fraction + exp_marker(1) +
+            // exp_sign(1) + exp
+            return detail::stdr::size_t(
+                1 + 2 + 1 + 1 + detail::hex_fraction_digits<FloatFormat>::value + 1 + 1 +
+                detail::hex_exponent_length(-FloatFormat::min_exponent > FloatFormat::max_exponent
+                                               ? -FloatFormat::min_exponent
+                                               : FloatFormat::max_exponent));
+        }
+
+        namespace detail {
+            template <class FormatTraits>
+            char* to_chars_hex_n_impl(float_bits<FormatTraits> br, char* buffer) noexcept {
+                using format = typename FormatTraits::format;
+                using carrier_uint = typename FormatTraits::carrier_uint;
+
+                auto const exponent_bits = br.extract_exponent_bits();
+                auto const significand_bits = br.extract_significand_bits();
+                if (br.is_negative()) {
+                    *buffer = '-';
+                    ++buffer;
+                }
+                if (!br.is_finite(exponent_bits)) {
+                    if (significand_bits == 0) {
+                        stdr::memcpy(buffer, "Infinity", 8);
+                        return buffer + 8;
+                    }
+                    if (br.is_negative()) {
+                        --buffer;
+                    }
+                    stdr::memcpy(buffer, "NaN", 3);
+                    return buffer + 3;
+                }
+
+                buffer[0] = '0';
+                buffer[1] = 'x';
+                buffer[2] = exponent_bits == 0 ? '0' : '1';
+                buffer += 3;
+
+                int exponent;
+                if (significand_bits == 0) {
+                    exponent = exponent_bits == 0 ? 0 : int(br.binary_exponent(exponent_bits));
+                }
+                else {
+                    exponent = int(br.binary_exponent(exponent_bits));
+
+                    // Align the fraction to a multiple of 4 bits, and drop trailing zero digits.
+                    constexpr int fraction_digits = hex_fraction_digits<format>::value;
+                    auto fraction = carrier_uint(significand_bits
+                                                 << (fraction_digits * 4 - format::significand_bits));
+                    int number_of_digits = fraction_digits;
+                    while ((fraction & 0xf) == 0) {
+                        fraction = carrier_uint(fraction >> 4);
+                        --number_of_digits;
+                    }
+
+                    *buffer = '.';
+                    for (int i = number_of_digits; i > 0; --i) {
+                        buffer[i] = "0123456789abcdef"[fraction & 0xf];
+                        fraction = carrier_uint(fraction >> 4);
+                    }
+                    buffer += number_of_digits + 1;
+                }
+
+                buffer[0] = 'p';
+                if (exponent < 0) {
+                    buffer[1] = '-';
+                    exponent = -exponent;
+                }
+                else {
+                    buffer[1] = '+';
+                }
+                buffer += 2;
+                if (exponent >= 1000) {
+                    *buffer++ = char('0' + exponent / 1000);
+                    exponent %= 1000;
+                    *buffer++ = char('0' + exponent / 100);
+                    exponent %= 100;
+                    *buffer++ = char('0' + exponent / 10);
+                }
+                else if (exponent >= 100) {
+                    *buffer++ = char('0' + exponent / 100);
+                    exponent %= 100;
+                    *buffer++ = char('0' + exponent / 10);
+                }
+                else if (exponent >= 10) {
+                    *buffer++ = char('0' + exponent / 10);
+                }
+                *buffer = char('0' + exponent % 10);
+                return buffer + 1;
+            }
+
+            // Returns the value of a hex digit, or a value >= 16 for other characters.
+            inline unsigned int hex_digit_value(char c) noexcept {
+                auto const decimal = static_cast<unsigned int>(static_cast<unsigned char>(c)) -
+                                     static_cast<unsigned int>('0');
+                // Maps 'A'-'F' to 'a'-'f'.
+                auto const alphabet = (static_cast<unsigned int>(static_cast<unsigned char>(c)) |
+                                       0x20u) -
+                                      static_cast<unsigned int>('a');
+                return decimal < 10 ? decimal : (alphabet < 6 ? alphabet + 10 : 16);
+            }
+
+            inline bool hex_starts_with(char const* first, char const* last, char const* str,
+                                        stdr::size_t length) noexcept {
+                if (stdr::size_t(last - first) < length) {
+                    return false;
+                }
+                for (stdr::size_t i = 0; i < length; ++i) {
+                    if (first[i] != str[i]) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            // Parses 8 hex digits packed into a 64-bit integer, the first one being the most
+            // significant byte. Returns false if any of them is not a hex digit.
+            inline bool parse_8_hex_digits(stdr::uint_least64_t chunk,
+                                           stdr::uint_least32_t& value) noexcept {
+                constexpr auto ones = UINT64_C(0x0101010101010101);
+                constexpr auto high_bits = UINT64_C(0x8080808080808080);
+                if ((chunk & high_bits) != 0) {
+                    return false;
+                }
+                // Maps 'A'-'F' to 'a'-'f', and no other character into 'a'-'f'.
+                auto const lowercase = chunk | (ones * 0x20);
+                // For bytes below 0x80, the high bit of byte + 0x80 - lo is set iff byte >= lo,
+                // and there is no carry into the next byte.
+                auto const is_decimal_digit =
+                    (chunk + ones * (0x80 - '0')) & ~(chunk + ones * (0x7f - '9')) & high_bits;
+                auto const is_letter = (lowercase + ones * (0x80 - 'a')) &
+                                       ~(lowercase + ones * (0x7f - 'f')) & high_bits;
+                if ((is_decimal_digit | is_letter) != high_bits) {
+                    return false;
+                }
+
+                // The low nibble, plus 9 for letters.
+                auto nibbles = (lowercase & (ones * 0x0f)) + ((lowercase >> 6) & ones) * 9;
+                nibbles = (nibbles | (nibbles >> 4)) & UINT64_C(0x00ff00ff00ff00ff);
+                nibbles = (nibbles | (nibbles >> 8)) & UINT64_C(0x0000ffff0000ffff);
+                value = stdr::uint_least32_t((nibbles | (nibbles >> 16)) & UINT32_C(0xffffffff));
+                return true;
+            }
+
+            // Accumulates hex digits into significand while they fit into 64 bits, 8 digits at a
+            // time when possible. The remaining digits are counted, and only matter as a sticky
+            // bit. Returns the position of the first character that is not a hex digit.
+            inline char const* read_hex_digits(char const* ptr, char const* last,
+                                               stdr::uint_least64_t& significand,
+                                               stdr::int_least64_t& number_of_dropped_digits,
+                                               bool& sticky) noexcept {
+                while (last - ptr >= 8 && (significand >> 32) == 0) {
+                    stdr::uint_least64_t chunk = 0;
+                    for (int i = 0; i < 8; ++i) {
+                        chunk = (chunk << 8) | static_cast<unsigned char>(ptr[i]);
+                    }
+                    stdr::uint_least32_t value;
+                    if (!parse_8_hex_digits(chunk, value)) {
+                        break;
+                    }
+                    significand = (significand << 32) | value;
+                    ptr += 8;
+                }
+                for (; ptr != last; ++ptr) {
+                    auto const digit = hex_digit_value(*ptr);
+                    if (digit >= 16) {
+                        break;
+                    }
+                    if ((significand >> 60) == 0) {
+                        significand = significand * 16 + digit;
+                    }
+                    else {
+                        sticky |= digit != 0;
+                        ++number_of_dropped_digits;
+                    }
+                }
+                return ptr;
+            }
+
+            // Number of leading zero bits of a nonzero 64-bit integer.
+            inline int hex_count_leading_zeros(stdr::uint_least64_t n) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+                return __builtin_clzll((unsigned long long)(n));
+#else
+                int count = 0;
+                for (int shift = 32; shift > 0; shift /= 2) {
+                    if ((n >> (64 - shift)) == 0) {
+                        n <<= shift;
+                        count += shift;
+                    }
+                }
+                return count;
+#endif
+            }
+
+            // Returns the bit pattern of the nearest representable number of significand * 2^exponent,
+            // with ties to even; sticky is set if there are nonzero bits below significand.
+            template <class FormatTraits>
+            typename FormatTraits::carrier_uint hex_round_to_bits(stdr::uint_least64_t significand,
+                                                                  int exponent, bool sticky) noexcept {
+                using format = typename FormatTraits::format;
+                using carrier_uint = typename FormatTraits::carrier_uint;
+                constexpr auto infinity_bits =
+                    carrier_uint(((carrier_uint(1) << format::exponent_bits) - 1u)
+                                 << format::significand_bits);
+                if (significand == 0) {
+                    return 0;
+                }
+
+                // The binary exponent of the value, and the exponent of its last representable bit.
+                auto const value_exponent = 63 - hex_count_leading_zeros(significand) + exponent;
+                if (value_exponent > format::max_exponent) {
+                    return infinity_bits;
+                }
+                auto const lsb_exponent = (value_exponent >= format::min_exponent
+                                               ? value_exponent
+                                               : format::min_exponent) -
+                                          format::significand_bits;
+
+                stdr::uint_least64_t result;
+                auto const shift = lsb_exponent - exponent;
+                if (shift <= 0) {
+                    result = significand << -shift;
+                }
+                else if (shift > 64) {
+                    // Smaller than half the minimum subnormal.
+                    result = 0;
+                }
+                else {
+                    auto const rest =
+                        shift == 64 ? significand : significand & ((UINT64_C(1) << shift) - 1);
+                    auto const half = UINT64_C(1) << (shift - 1);
+                    result = shift == 64 ? 0 : significand >> shift;
+                    if (rest > half || (rest == half && (sticky || result % 2 != 0))) {
+                        ++result;
+                    }
+                }
+
+                // A carry into the exponent field is handled by the addition. In particular, it
+                // gives the smallest normal number from the largest subnormal number, and infinity
+                // from the largest finite number.
+                return carrier_uint((carrier_uint(lsb_exponent + format::significand_bits -
+                                                  format::exponent_bias - 1)
+                                     << format::significand_bits) +
+                                    carrier_uint(result));
+            }
+
+            template <class FormatTraits>
+            char const* from_chars_hex_impl(char const* first, char const* last,
+                                            typename FormatTraits::carrier_uint& bits) noexcept {
+                using format = typename FormatTraits::format;
+                using carrier_uint = typename FormatTraits::carrier_uint;
+
+                auto ptr = first;
+                carrier_uint sign_bit = 0;
+                if (ptr != last && *ptr == '-') {
+                    sign_bit = carrier_uint(carrier_uint(1) << (format::total_bits - 1));
+                    ++ptr;
+                }
+                if (hex_starts_with(ptr, last, "Infinity", 8)) {
+                    bits = carrier_uint(sign_bit | (((carrier_uint(1) << format::exponent_bits) - 1u)
+                                                    << format::significand_bits));
+                    return ptr + 8;
+                }
+                if (hex_starts_with(ptr, last, "NaN", 3)) {
+                    bits = carrier_uint(sign_bit |
+                                        (((carrier_uint(1) << format::exponent_bits) - 1u)
+                                         << format::significand_bits) |
+                                        (carrier_uint(1) << (format::significand_bits - 1)));
+                    return ptr + 3;
+                }
+                if (last - ptr >= 3 && ptr[0] == '0' && (ptr[1] == 'x' || ptr[1] == 'X') &&
+                    (hex_digit_value(ptr[2]) < 16 ||
+                     (ptr[2] == '.' && last - ptr >= 4 && hex_digit_value(ptr[3]) < 16))) {
+                    ptr += 2;
+                }
+
+                // The exponent is accumulated in 64 bits, so that neither the number of digits nor
+                // the exponent written after 'p' can overflow it.
+                stdr::uint_least64_t significand = 0;
+                stdr::int_least64_t exponent = 0;
+                bool sticky = false;
+                auto const integer_part_first = ptr;
+                stdr::int_least64_t number_of_dropped_digits = 0;
+                ptr = read_hex_digits(ptr, last, significand, number_of_dropped_digits, sticky);
+                bool const has_integer_part = ptr != integer_part_first;
+                exponent += 4 * number_of_dropped_digits;
+
+                bool has_fraction_part = false;
+                if (ptr != last && *ptr == '.') {
+                    auto const fraction_part_first = ++ptr;
+                    number_of_dropped_digits = 0;
+                    ptr = read_hex_digits(ptr, last, significand, number_of_dropped_digits, sticky);
+                    has_fraction_part = ptr != fraction_part_first;
+                    exponent -= 4 * (stdr::int_least64_t(ptr - fraction_part_first) -
+                                     number_of_dropped_digits);
+                }
+                if (!has_integer_part && !has_fraction_part) {
+                    return first;
+                }
+
+                // The exponent after 'p' is saturated at 10^17, far beyond any exponent that can be
+                // compensated by the number of digits.
+                if (ptr != last && (*ptr == 'p' || *ptr == 'P')) {
+                    auto exponent_ptr = ptr + 1;
+                    bool is_negative = false;
+                    if (exponent_ptr != last && (*exponent_ptr == '+' || *exponent_ptr == '-')) {
+                        is_negative = *exponent_ptr == '-';
+                        ++exponent_ptr;
+                    }
+                    if (exponent_ptr != last && *exponent_ptr >= '0' && *exponent_ptr <= '9') {
+                        stdr::int_least64_t decimal_exponent = 0;
+                        for (; exponent_ptr != last && *exponent_ptr >= '0' && *exponent_ptr <= '9';
+                             ++exponent_ptr) {
+                            if (decimal_exponent < 10000000000000000) {
+                                decimal_exponent = decimal_exponent * 10 + (*exponent_ptr - '0');
+                            }
+                        }
+                        exponent += is_negative ? -decimal_exponent : decimal_exponent;
+                        ptr = exponent_ptr;
+                    }
+                }
+
+                // Clamping the exponent to a bound beyond which the result is either zero or
+                // infinity does not change the result.
+                constexpr stdr::int_least64_t exponent_bound =
+                    format::max_exponent - format::min_exponent + format::significand_bits + 128;
+                exponent = exponent > exponent_bound    ? exponent_bound
+                           : exponent < -exponent_bound ? -exponent_bound
+                                                        : exponent;
+                bits = carrier_uint(sign_bit | hex_round_to_bits<FormatTraits>(
+                                                   significand, int(exponent), sticky));
+                return ptr;
+            }
+        }
+
+        // Writes x in the hexadecimal format and returns the next-to-end position.
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>>
+        char* to_chars_hex_n(Float x, char* buffer) noexcept {
+            return detail::to_chars_hex_n_impl(
+                make_float_bits<Float, ConversionTraits, FormatTraits>(x), buffer);
+        }
+
+        // Null-terminate and bypass the return value of to_chars_hex_n.
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>>
+        char* to_chars_hex(Float x, char* buffer) noexcept {
+            auto ptr = to_chars_hex_n<Float, ConversionTraits, FormatTraits>(x, buffer);
+            *ptr = '\0';
+            return ptr;
+        }
+
+        // Parses a hexadecimal floating-point number at the beginning of [first, last) into x and
+        // returns the position right after it. If there is no such number, returns first and
+        // leaves x untouched. Values out of range become zero or infinity.
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>>
+        char const* from_chars_hex(char const* first, char const* last, Float& x) noexcept {
+            typename FormatTraits::carrier_uint bits;
+            auto const ptr = detail::from_chars_hex_impl<FormatTraits>(first, last, bits);
+            if (ptr != first) {
+                x = ConversionTraits::carrier_to_float(bits);
+            }
+            return ptr;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,176 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_DRAGONBOX_NUM_PUT
+#define JKJ_HEADER_DRAGONBOX_NUM_PUT
+
+#include "dragonbox_charconv.h"
+
+#include <climits>
+#include <ios>
+#include <iterator>
+#include <locale>
+
+// A std::num_put<char> facet formatting double with charconv::to_chars. Imbuing a stream with
+//
+//   std::locale(stream.getloc(), new jkj::dragonbox::num_put<>)
+//
+// makes operator<<(double) (and operator<<(float), which converts to double) give the same output
+// as the standard facet, but without going through snprintf. The floatfield chooses the format of
+// printf as the standard facet does: %f for fixed, %e for scientific, %a for both, and %g
+// otherwise, with the precision of the stream. showpos, uppercase, the width, the fill character,
+// the adjustfield and the decimal point of the numpunct facet are respected.
+//
+// If the facet is constructed with shortest = true, then the default floatfield ignores the
+// precision and gives the shortest representation that reads back to the same double, as
+// std::to_chars(first, last, x, std::chars_format::general) does, e.g. 0.1 rather than
+// 0.10000000000000001 with the precision 17.
+//
+// showpoint, digit grouping of the numpunct facet, long double, and outputs not fitting into
+// a buffer on the stack (e.g. 1e300 with fixed) are handed over to std::num_put.
+
+namespace jkj {
+    namespace dragonbox {
+        template <class OutputIt = std::ostreambuf_iterator<char>>
+        class num_put : public std::num_put<char, OutputIt> {
+        public:
+            using char_type = char;
+            using iter_type = OutputIt;
+
+            explicit num_put(bool shortest = false, std::size_t refs = 0)
+                : std::num_put<char, OutputIt>(refs), shortest_(shortest) {}
+
+        protected:
+            iter_type do_put(iter_type out, std::ios_base& io, char fill,
+                             double x) const override {
+                auto const flags = io.flags();
+                auto const& punct = std::use_facet<std::numpunct<char>>(io.getloc());
+                if (flags & std::ios_base::showpoint) {
+                    return std::num_put<char, OutputIt>::do_put(out, io, fill, x);
+                }
+                auto const grouping = punct.grouping();
+                if (!grouping.empty() && grouping[0] > 0 && grouping[0] != CHAR_MAX) {
+                    return std::num_put<char, OutputIt>::do_put(out, io, fill, x);
+                }
+
+                auto const floatfield = flags & std::ios_base::floatfield;
+                auto const is_hex = floatfield == (std::ios_base::fixed | std::ios_base::scientific);
+                auto const precision =
+                    io.precision() > INT_MAX ? INT_MAX : int(io.precision());
+
+                char buffer[128];
+                charconv::to_chars_result result;
+                if (floatfield == std::ios_base::fixed) {
+                    result = charconv::to_chars(buffer, buffer + sizeof(buffer), x,
+                                                charconv::chars_format::fixed, precision);
+                }
+                else if (floatfield == std::ios_base::scientific) {
+                    result = charconv::to_chars(buffer, buffer + sizeof(buffer), x,
+                                                charconv::chars_format::scientific, precision);
+                }
+                else if (is_hex) {
+                    result = charconv::to_chars(buffer, buffer + sizeof(buffer), x,
+                                                charconv::chars_format::hex);
+                }
+                else if (shortest_) {
+                    result = charconv::to_chars(buffer, buffer + sizeof(buffer), x,
+                                                charconv::chars_format::general);
+                }
+                else {
+                    result = charconv::to_chars(buffer, buffer + sizeof(buffer), x,
+                                                charconv::chars_format::general, precision);
+                }
+                if (result.ec != std::errc{}) {
+                    return std::num_put<char, OutputIt>::do_put(out, io, fill, x);
+                }
+
+                // The output is written as [sign][prefix][body]. For std::ios_base::internal, the
+                // padding goes after the sign if any, and after the prefix otherwise, as the
+                // standard facet does.
+                char* body = buffer;
+                char sign = '\0';
+                if (*body == '-') {
+                    sign = '-';
+                    ++body;
+                }
+                else if (flags & std::ios_base::showpos) {
+                    sign = '+';
+                }
+                // As %f, not %F.
+                auto const uppercase =
+                    (flags & std::ios_base::uppercase) != 0 && floatfield != std::ios_base::fixed;
+                auto const has_prefix = is_hex && *body >= '0' && *body <= '9';
+                auto const decimal_point = punct.decimal_point();
+                for (char* ptr = body; ptr != result.ptr; ++ptr) {
+                    if (*ptr == '.') {
+                        *ptr = decimal_point;
+                    }
+                    else if (uppercase && *ptr >= 'a' && *ptr <= 'z') {
+                        *ptr = char(*ptr - 'a' + 'A');
+                    }
+                }
+
+                auto const length =
+                    (sign != '\0' ? 1 : 0) + (has_prefix ? 2 : 0) + (result.ptr - body);
+                auto const padding = io.width() > length ? io.width() - length : 0;
+                io.width(0);
+                auto const adjustfield = flags & std::ios_base::adjustfield;
+
+                if (adjustfield != std::ios_base::left && adjustfield != std::ios_base::internal) {
+                    out = write_fill(out, fill, padding);
+                }
+                if (sign != '\0') {
+                    *out = sign;
+                    ++out;
+                }
+                if (adjustfield == std::ios_base::internal && sign != '\0') {
+                    out = write_fill(out, fill, padding);
+                }
+                if (has_prefix) {
+                    *out = '0';
+                    ++out;
+                    *out = uppercase ? 'X' : 'x';
+                    ++out;
+                }
+                if (adjustfield == std::ios_base::internal && sign == '\0') {
+                    out = write_fill(out, fill, padding);
+                }
+                for (char const* ptr = body; ptr != result.ptr; ++ptr) {
+                    *out = *ptr;
+                    ++out;
+                }
+                if (adjustfield == std::ios_base::left) {
+                    out = write_fill(out, fill, padding);
+                }
+                return out;
+            }
+
+        private:
+            static iter_type write_fill(iter_type out, char fill, std::streamsize count) {
+                for (std::streamsize i = 0; i < count; ++i) {
+                    *out = fill;
+                    ++out;
+                }
+                return out;
+            }
+
+            bool shortest_;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,115 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_DRAGONBOX_RUNTIME_ROUNDING
+#define JKJ_HEADER_DRAGONBOX_RUNTIME_ROUNDING
+
+#include "dragonbox_to_chars.h"
+
+namespace jkj {
+    namespace dragonbox {
+        // Runtime counterparts of the policies in policy::decimal_to_binary_rounding.
+        // The static-boundary variants are not listed, because they produce the same results as
+        // the corresponding nearest modes.
+        enum class decimal_to_binary_rounding_mode {
+            nearest_to_even,
+            nearest_to_odd,
+            nearest_toward_plus_infinity,
+            nearest_toward_minus_infinity,
+            nearest_toward_zero,
+            nearest_away_from_zero,
+            toward_plus_infinity,
+            toward_minus_infinity,
+            toward_zero,
+            away_from_zero
+        };
+
+        // Runtime counterparts of the policies in policy::binary_to_decimal_rounding.
+        enum class binary_to_decimal_rounding_mode {
+            do_not_care,
+            to_even,
+            to_odd,
+            away_from_zero,
+            toward_zero
+        };
+
+        template <class Float>
+        using to_chars_n_function = char* (*)(Float x, char* buffer);
+
+        namespace detail {
+            constexpr stdr::size_t number_of_decimal_to_binary_rounding_modes = 10;
+            constexpr stdr::size_t number_of_binary_to_decimal_rounding_modes = 5;
+
+            template <class Float>
+            struct to_chars_n_table {
+                to_chars_n_function<Float> entries[number_of_decimal_to_binary_rounding_modes *
+                                                   number_of_binary_to_decimal_rounding_modes];
+            };
+
+            // Defined in dragonbox_runtime_rounding.cpp.
+            extern to_chars_n_table<float> const binary32_to_chars_n_table;
+            extern to_chars_n_table<double> const binary64_to_chars_n_table;
+
+            inline to_chars_n_table<float> const& get_to_chars_n_table(float) noexcept {
+                return binary32_to_chars_n_table;
+            }
+            inline to_chars_n_table<double> const& get_to_chars_n_table(double) noexcept {
+                return binary64_to_chars_n_table;
+            }
+        }
+
+        // Returns to_chars_n instantiated with the policies corresponding to the given rounding
+        // modes and the default values of the other policies. The instantiations for all
+        // combinations are compiled into the library, and the selection is a lookup into a table of
+        // function pointers. Only float and double are supported.
+        // When many values are converted with the same modes, call this once and reuse the result.
+        template <class Float>
+        to_chars_n_function<Float> select_to_chars_n(decimal_to_binary_rounding_mode dbr,
+                                                     binary_to_decimal_rounding_mode bdr) noexcept {
+            auto const index =
+                detail::stdr::size_t(dbr) * detail::number_of_binary_to_decimal_rounding_modes +
+                detail::stdr::size_t(bdr);
+            return detail::get_to_chars_n_table(Float{}).entries[index];
+        }
+
+        // Same as to_chars_n with the policies corresponding to the given rounding modes.
+        inline char* to_chars_n(float x, char* buffer, decimal_to_binary_rounding_mode dbr,
+                                binary_to_decimal_rounding_mode bdr) noexcept {
+            return select_to_chars_n<float>(dbr, bdr)(x, buffer);
+        }
+        inline char* to_chars_n(double x, char* buffer, decimal_to_binary_rounding_mode dbr,
+                                binary_to_decimal_rounding_mode bdr) noexcept {
+            return select_to_chars_n<double>(dbr, bdr)(x, buffer);
+        }
+
+        // Null-terminate and bypass the return value of to_chars_n.
+        inline char* to_chars(float x, char* buffer, decimal_to_binary_rounding_mode dbr,
+                              binary_to_decimal_rounding_mode bdr) noexcept {
+            auto ptr = to_chars_n(x, buffer, dbr, bdr);
+            *ptr = '\0';
+            return ptr;
+        }
+        inline char* to_chars(double x, char* buffer, decimal_to_binary_rounding_mode dbr,
+                              binary_to_decimal_rounding_mode bdr) noexcept {
+            auto ptr = to_chars_n(x, buffer, dbr, bdr);
+            *ptr = '\0';
+            return ptr;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,381 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_DRAGONBOX_SCALED_INTEGER
+#define JKJ_HEADER_DRAGONBOX_SCALED_INTEGER
+
+#include "dragonbox.h"
+
+// Conversion of binary floating-point numbers into scaled integers, i.e., the correctly rounded
+// value of x * 10^k as a 64-bit signed integer, e.g. the number of cents for k = 2 or the number of
+// hundreds for k = -2. Unlike llround(x * 100), there is no rounding error in the multiplication.
+//
+// There are two interpretations of the value of x:
+//   - to_scaled_integer rounds the exact binary value of x.
+//   - to_scaled_integer_shortest rounds the shortest decimal representation of x given by
+//     to_decimal, which is what parsing the output of to_chars and rounding the decimal gives.
+// For example, the double 1.015 is actually 1.01499999999999990..., so for k = 2 the former gives
+// 101 and the latter gives 102.
+//
+// Ties are broken according to the binary-to-decimal rounding policy, applied on the magnitude:
+// to_even (default), to_odd, away_from_zero, toward_zero, or do_not_care (which rounds away from
+// zero). Other policies are ignored.
+//
+// For to_scaled_integer, k must be in [min_scaled_integer_exponent, max_scaled_integer_exponent].
+// For 0 <= k <= 55, the entry of the full cache for 10^k is exact, so x * 10^k is computed exactly
+// by a single 64 x 128-bit multiplication. (The full cache is always used, because entries
+// recovered by the compact cache are not exact.) For -19 <= k < 0, 10^-k fits into 64 bits and the
+// computation is a 128 / 64-bit division. to_scaled_integer_shortest accepts any k.
+
+namespace jkj {
+    namespace dragonbox {
+        struct scaled_integer_result {
+            // Saturated to the minimum or the maximum if overflow is true, and 0 for NaN's.
+            detail::stdr::int_least64_t value;
+            // True if the result does not fit into int64_t or the input is not finite.
+            bool overflow;
+        };
+
+        constexpr int min_scaled_integer_exponent = -19;
+        constexpr int max_scaled_integer_exponent = 55;
+
+        namespace detail {
+            // The magnitude of the result as floor(|x| * 10^k), and the fractional part compared
+            // with 1/2. is_overflow is set if the floor does not fit into 64 bits.
+            struct scaled_integer_floor {
+                stdr::uint_least64_t integer_part;
+                bool is_overflow;
+                bool is_above_half;
+                bool is_half;
+            };
+
+            // 0 <= k <= 55. 10^k * 2^-(floor_log2_pow10(k) - 127) is an integer smaller than
+            // 2^128, so the cache entry is exact.
+            inline scaled_integer_floor scaled_integer_floor_nonnegative(stdr::uint_least64_t m,
+                                                                  int binary_exponent,
+                                                                  int k) noexcept {
+                auto const cache = policy::cache::full.template get_cache<ieee754_binary64,
+                                                                          stdr::int_least16_t>(k);
+                auto const shift =
+                    binary_exponent + int(log::floor_log2_pow10(k)) - 127;
+
+                // The 192-bit product w[2]:w[1]:w[0] = m * cache.
+                stdr::uint_least64_t w[3];
+                auto const low = wuint::umul128(m, cache.low());
+                auto high = wuint::umul128(m, cache.high());
+                high += low.high();
+                w[0] = low.low();
+                w[1] = high.low();
+                w[2] = high.high();
+
+                auto bit_at = [&w](int i) {
+                    return i < 0 || i >= 192 ? false : ((w[i / 64] >> (i % 64)) & 1) != 0;
+                };
+                // Bits [from, from + 64) of the product, where from may be negative.
+                auto bits_from = [&w](int from) {
+                    stdr::uint_least64_t result = 0;
+                    for (int word = 0; word < 3; ++word) {
+                        auto const offset = word * 64 - from;
+                        if (offset >= 64 || offset <= -64) {
+                            continue;
+                        }
+                        result |= offset >= 0 ? (w[word] << offset) : (w[word] >> -offset);
+                    }
+                    return result;
+                };
+                auto nonzero_from = [&w](int from) {
+                    for (int word = 2; word >= 0; --word) {
+                        auto const offset = from - word * 64;
+                        if (offset <= 0) {
+                            if (w[word] != 0) {
+                                return true;
+                            }
+                        }
+                        else if (offset < 64 && (w[word] >> offset) != 0) {
+                            return true;
+                        }
+                    }
+                    return false;
+                };
+                auto nonzero_below = [&w](int to) {
+                    for (int word = 0; word < 3; ++word) {
+                        auto const offset = to - word * 64;
+                        if (offset >= 64) {
+                            if (w[word] != 0) {
+                                return true;
+                            }
+                        }
+                        else if (offset > 0 &&
+                                 (w[word] & ((stdr::uint_least64_t(1) << offset) - 1)) != 0) {
+                            return true;
+                        }
+                    }
+                    return false;
+                };
+
+                // The result is the product shifted by shift bits.
+                if (shift >= 0) {
+                    if (shift >= 64 || nonzero_from(64 - shift)) {
+                        return {0, shift < 64 || w[0] != 0 || w[1] != 0 || w[2] != 0, false,
+                                false};
+                    }
+                    return {bits_from(-shift), false, false, false};
+                }
+                else {
+                    auto const s = -shift;
+                    if (nonzero_from(s + 64)) {
+                        return {0, true, false, false};
+                    }
+                    auto const half_bit = bit_at(s - 1);
+                    auto const sticky = nonzero_below(s - 1);
+                    return {s >= 192 ? 0 : bits_from(s), false, half_bit && sticky,
+                            half_bit && !sticky};
+                }
+            }
+
+            // -19 <= k < 0. Divides m * 2^binary_exponent by 10^-k.
+            inline scaled_integer_floor scaled_integer_floor_negative(stdr::uint_least64_t m,
+                                                                      int binary_exponent,
+                                                                      int k) noexcept {
+                auto const divisor = pow10_table_holder<>::table[-k];
+                auto const half_divisor = divisor / 2;
+
+                stdr::uint_least64_t quotient, remainder;
+                bool has_fractional_bits = false;
+                if (binary_exponent >= 0) {
+                    // The dividend m * 2^binary_exponent as a 128-bit integer.
+                    int m_bits = 0;
+                    for (auto n = m; n != 0; n >>= 1) {
+                        ++m_bits;
+                    }
+                    if (m_bits + binary_exponent > 128) {
+                        return {0, true, false, false};
+                    }
+                    stdr::uint_least64_t high, low;
+                    if (binary_exponent >= 64) {
+                        high = m << (binary_exponent - 64);
+                        low = 0;
+                    }
+                    else {
+                        high = binary_exponent == 0 ? 0 : m >> (64 - binary_exponent);
+                        low = m << binary_exponent;
+                    }
+                    if (high >= divisor) {
+                        return {0, true, false, false};
+                    }
+
+                    // Restoring division; the quotient fits into 64 bits since high < divisor.
+                    quotient = 0;
+                    remainder = high;
+                    for (int i = 63; i >= 0; --i) {
+                        auto const carry = (remainder >> 63) != 0;
+                        remainder = (remainder << 1) | ((low >> i) & 1);
+                        if (carry || remainder >= divisor) {
+                            remainder -= divisor;
+                            quotient |= stdr::uint_least64_t(1) << i;
+                        }
+                    }
+                }
+                else {
+                    auto const s = -binary_exponent;
+                    auto const integer_part = s >= 64 ? 0 : m >> s;
+                    has_fractional_bits =
+                        s >= 64 ? m != 0 : (m & ((stdr::uint_least64_t(1) << s) - 1)) != 0;
+                    quotient = integer_part / divisor;
+                    remainder = integer_part % divisor;
+                }
+
+                // The fractional part is (remainder + f) / divisor for some 0 <= f < 1, where f is
+                // nonzero if and only if has_fractional_bits. Since divisor is even, it is exactly
+                // 1/2 only if remainder == divisor / 2 and f == 0.
+                return {quotient, false,
+                        remainder > half_divisor ||
+                            (remainder == half_divisor && has_fractional_bits),
+                        remainder == half_divisor && !has_fractional_bits};
+            }
+
+            template <class BinaryToDecimalRoundingPolicy, class FormatTraits>
+            scaled_integer_result to_scaled_integer_impl(float_bits<FormatTraits> br,
+                                                         int k) noexcept {
+                static_assert(FormatTraits::format::significand_bits < 64, "");
+                assert(k >= min_scaled_integer_exponent && k <= max_scaled_integer_exponent);
+
+                auto const is_negative = br.is_negative();
+                auto const saturated = is_negative ? -INT64_C(0x7fffffffffffffff) - 1
+                                                   : INT64_C(0x7fffffffffffffff);
+                auto const exponent_bits = br.extract_exponent_bits();
+                if (!br.is_finite(exponent_bits)) {
+                    auto const is_nan = br.extract_significand_bits() != 0;
+                    return {is_nan ? 0 : saturated, true};
+                }
+                if (!br.is_nonzero()) {
+                    return {0, false};
+                }
+
+                auto const m = stdr::uint_least64_t(br.binary_significand());
+                auto const binary_exponent =
+                    int(br.binary_exponent()) - FormatTraits::format::significand_bits;
+                auto const r = k >= 0 ? scaled_integer_floor_nonnegative(m, binary_exponent, k)
+                                      : scaled_integer_floor_negative(m, binary_exponent, k);
+
+                auto magnitude = r.integer_part;
+                auto const limit =
+                    UINT64_C(0x7fffffffffffffff) + stdr::uint_least64_t(is_negative ? 1 : 0);
+                if (r.is_overflow || magnitude > limit) {
+                    return {saturated, true};
+                }
+                if (r.is_above_half ||
+                    (r.is_half && !BinaryToDecimalRoundingPolicy::prefer_round_down(magnitude + 1))) {
+                    if (magnitude == limit) {
+                        return {saturated, true};
+                    }
+                    ++magnitude;
+                }
+                return {is_negative ? stdr::int_least64_t(0 - magnitude)
+                                    : stdr::int_least64_t(magnitude),
+                        false};
+            }
+
+            template <class BinaryToDecimalRoundingPolicy, class FormatTraits>
+            scaled_integer_result to_scaled_integer_shortest_impl(float_bits<FormatTraits> br,
+                                                                  int k) noexcept {
+                static_assert(FormatTraits::format::decimal_significand_digits <= 19, "");
+
+                auto const is_negative = br.is_negative();
+                auto const saturated = is_negative ? -INT64_C(0x7fffffffffffffff) - 1
+                                                   : INT64_C(0x7fffffffffffffff);
+                auto const exponent_bits = br.extract_exponent_bits();
+                auto const s = br.remove_exponent_bits();
+                if (!br.is_finite(exponent_bits)) {
+                    return {s.has_all_zero_significand_bits() ? saturated : 0, true};
+                }
+                if (!br.is_nonzero()) {
+                    return {0, false};
+                }
+
+                auto const decimal = to_decimal_ex(s, exponent_bits, policy::sign::ignore,
+                                                   policy::trailing_zero::remove);
+                auto const significand = stdr::uint_least64_t(decimal.significand);
+                auto const limit =
+                    UINT64_C(0x7fffffffffffffff) + stdr::uint_least64_t(is_negative ? 1 : 0);
+                auto const scale = int(decimal.exponent) + k;
+
+                stdr::uint_least64_t magnitude;
+                if (scale >= 0) {
+                    // significand * 10^scale, where significand < 10^19.
+                    if (scale > 19) {
+                        return {saturated, true};
+                    }
+                    auto const product =
+                        wuint::umul128(significand, pow10_table_holder<>::table[scale]);
+                    if (product.high() != 0 || product.low() > limit) {
+                        return {saturated, true};
+                    }
+                    magnitude = product.low();
+                }
+                else if (scale < -19) {
+                    // significand / 10^-scale < 10^19 / 10^20 < 1/2.
+                    magnitude = 0;
+                }
+                else {
+                    auto const divisor = pow10_table_holder<>::table[-scale];
+                    magnitude = significand / divisor;
+                    auto const remainder = significand % divisor;
+                    if (remainder > divisor / 2 ||
+                        (remainder == divisor / 2 &&
+                         !BinaryToDecimalRoundingPolicy::prefer_round_down(magnitude + 1))) {
+                        ++magnitude;
+                    }
+                    if (magnitude > limit) {
+                        return {saturated, true};
+                    }
+                }
+                return {is_negative ? stdr::int_least64_t(0 - magnitude)
+                                    : stdr::int_least64_t(magnitude),
+                        false};
+            }
+        }
+
+        // Returns round(x * 10^k), where min_scaled_integer_exponent <= k <=
+        // max_scaled_integer_exponent.
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        scaled_integer_result to_scaled_integer(Float x, int k, Policies...) noexcept {
+            using policy_holder = detail::to_decimal_policy_holder<Policies...>;
+            return detail::to_scaled_integer_impl<
+                typename policy_holder::binary_to_decimal_rounding_policy>(
+                make_float_bits<Float, ConversionTraits, FormatTraits>(x), k);
+        }
+
+        // Stores to_scaled_integer(x[i], k, policies...).value into results[i] for each i < count,
+        // and returns the number of inputs for which overflow is true.
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        detail::stdr::size_t to_scaled_integer_n(Float const* x, detail::stdr::size_t count, int k,
+                                                 detail::stdr::int_least64_t* results,
+                                                 Policies... policies) noexcept {
+            detail::stdr::size_t number_of_overflows = 0;
+            for (detail::stdr::size_t i = 0; i < count; ++i) {
+                auto const r =
+                    to_scaled_integer<Float, ConversionTraits, FormatTraits>(x[i], k, policies...);
+                results[i] = r.value;
+                number_of_overflows += r.overflow ? 1 : 0;
+            }
+            return number_of_overflows;
+        }
+
+        // Returns round(d * 10^k), where d is the shortest decimal representation of x.
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        scaled_integer_result to_scaled_integer_shortest(Float x, int k, Policies...) noexcept {
+            using policy_holder = detail::to_decimal_policy_holder<Policies...>;
+            return detail::to_scaled_integer_shortest_impl<
+                typename policy_holder::binary_to_decimal_rounding_policy>(
+                make_float_bits<Float, ConversionTraits, FormatTraits>(x), k);
+        }
+
+        // Array version of to_scaled_integer_shortest; see to_scaled_integer_n.
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        detail::stdr::size_t to_scaled_integer_shortest_n(Float const* x, detail::stdr::size_t count,
+                                                          int k, detail::stdr::int_least64_t* results,
+                                                          Policies... policies) noexcept {
+            detail::stdr::size_t number_of_overflows = 0;
+            for (detail::stdr::size_t i = 0; i < count; ++i) {
+                auto const r = to_scaled_integer_shortest<Float, ConversionTraits, FormatTraits>(
+                    x[i], k, policies...);
+                results[i] = r.value;
+                number_of_overflows += r.overflow ? 1 : 0;
+            }
+            return number_of_overflows;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,41 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_DRAGONBOX_SIMD
+#define JKJ_HEADER_DRAGONBOX_SIMD
+
+#include "dragonbox.h"
+
+namespace jkj {
+    namespace dragonbox {
+        // Return type of to_decimal for binary32 with the default policies.
+        using binary32_decimal_fp = signed_decimal_fp<detail::stdr::uint_least32_t, int>;
+
+        // Converts count binary32 inputs at once; results[i] is identical to to_decimal(x[i]).
+        // The same precondition as to_decimal applies: every input must be finite and nonzero.
+        // For binary32, the whole computation fits into 64-bit integer arithmetic, so when the
+        // CPU supports AVX-512F, 8 inputs are processed in separate lanes of a vector register.
+        // Otherwise, or for the remaining inputs, the scalar to_decimal is called.
+        void to_decimal_n(float const* x, binary32_decimal_fp* results,
+                          detail::stdr::size_t count) noexcept;
+
+        // Returns true if to_decimal_n uses the AVX-512F kernel on this machine.
+        bool to_decimal_n_uses_avx512() noexcept;
+    }
+}
+
+#endif
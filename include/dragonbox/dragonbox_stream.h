@@ -0,0 +1,193 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_DRAGONBOX_STREAM
+#define JKJ_HEADER_DRAGONBOX_STREAM
+
+#include "dragonbox_to_chars.h"
+
+#if defined(__has_include)
+    #if __has_include(<version>)
+        #include <version>
+    #endif
+#endif
+#if defined(__cpp_lib_coroutine) && __cpp_lib_coroutine >= 201902L && defined(__cpp_lib_span) &&   \
+    __cpp_lib_span >= 202002L
+    #include <coroutine>
+    #include <cstddef>
+    #include <exception>
+    #include <iterator>
+    #include <memory>
+    #include <span>
+    #include <utility>
+    #define JKJ_HAS_DRAGONBOX_FORMAT_STREAM 1
+#endif
+
+// A generator lazily formatting an array of floating-point numbers into chunks of text, e.g.
+//
+//   std::vector<double> values = ...;
+//   for (std::span<char const> chunk :
+//        jkj::dragonbox::format_stream(std::span<double const>(values), 65536)) {
+//       send(socket, chunk.data(), chunk.size(), 0);
+//   }
+//
+// Float is deduced from the span, so a container has to be converted to std::span<Float const>
+// explicitly.
+// Each number is written by to_chars_n with the given policies and followed by '\n'. A chunk holds
+// as many whole numbers as fit into chunk_size characters, and at least one, so the text of
+// a multi-gigabyte array is never materialized. Nothing is formatted until the consumer advances
+// the generator, so a sender writing into a non-blocking socket can wait for the socket to drain
+// before asking for more.
+//
+// The chunks are formatted alternately into two buffers allocated once when the first chunk is
+// requested. A chunk thus stays valid until the generator is advanced twice, so the rest of one
+// chunk can be sent while the next one is formatted.
+//
+// This header requires coroutines and std::span of C++20; otherwise it defines nothing, and
+// JKJ_HAS_DRAGONBOX_FORMAT_STREAM is not defined.
+
+#if defined(JKJ_HAS_DRAGONBOX_FORMAT_STREAM)
+namespace jkj {
+    namespace dragonbox {
+        // An input range of std::span<char const>, returned by format_stream.
+        class chunk_generator {
+        public:
+            struct promise_type {
+                std::span<char const> chunk;
+                std::exception_ptr exception;
+
+                chunk_generator get_return_object() noexcept {
+                    return chunk_generator{
+                        std::coroutine_handle<promise_type>::from_promise(*this)};
+                }
+                std::suspend_always initial_suspend() const noexcept { return {}; }
+                std::suspend_always final_suspend() const noexcept { return {}; }
+                std::suspend_always yield_value(std::span<char const> next) noexcept {
+                    chunk = next;
+                    return {};
+                }
+                void return_void() const noexcept {}
+                void unhandled_exception() noexcept { exception = std::current_exception(); }
+            };
+
+            class iterator {
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = std::span<char const>;
+                using difference_type = std::ptrdiff_t;
+                using pointer = std::span<char const> const*;
+                using reference = std::span<char const> const&;
+
+                iterator() = default;
+
+                reference operator*() const noexcept { return handle_.promise().chunk; }
+                pointer operator->() const noexcept { return &handle_.promise().chunk; }
+
+                iterator& operator++() {
+                    advance(handle_);
+                    return *this;
+                }
+                void operator++(int) { ++*this; }
+
+                friend bool operator==(iterator const& it, std::default_sentinel_t) noexcept {
+                    return it.handle_.done();
+                }
+
+            private:
+                friend chunk_generator;
+                explicit iterator(std::coroutine_handle<promise_type> handle) noexcept
+                    : handle_{handle} {}
+
+                std::coroutine_handle<promise_type> handle_ = nullptr;
+            };
+
+            chunk_generator(chunk_generator&& other) noexcept
+                : handle_{std::exchange(other.handle_, nullptr)} {}
+            chunk_generator& operator=(chunk_generator&& other) noexcept {
+                if (this != &other) {
+                    if (handle_) {
+                        handle_.destroy();
+                    }
+                    handle_ = std::exchange(other.handle_, nullptr);
+                }
+                return *this;
+            }
+            ~chunk_generator() {
+                if (handle_) {
+                    handle_.destroy();
+                }
+            }
+
+            // Formats the first chunk. Should be called only once.
+            iterator begin() {
+                advance(handle_);
+                return iterator{handle_};
+            }
+            std::default_sentinel_t end() const noexcept { return {}; }
+
+        private:
+            explicit chunk_generator(std::coroutine_handle<promise_type> handle) noexcept
+                : handle_{handle} {}
+
+            // Formats the next chunk, and rethrows the exception thrown while doing so if any.
+            static void advance(std::coroutine_handle<promise_type> handle) {
+                handle.resume();
+                if (handle.promise().exception) {
+                    std::rethrow_exception(std::exchange(handle.promise().exception, nullptr));
+                }
+            }
+
+            std::coroutine_handle<promise_type> handle_;
+        };
+
+        template <class Float, class... Policies>
+        chunk_generator format_stream(std::span<Float const> values, std::size_t chunk_size,
+                                      Policies... policies) {
+            using format = typename default_float_bit_carrier_conversion_traits<Float>::format;
+            // The longest output together with '\n'.
+            constexpr std::size_t max_length =
+                max_notation_output_string_length<
+                    format, typename detail::to_chars_policy_holder<Policies...>::notation_policy> +
+                1;
+            if (chunk_size < max_length) {
+                chunk_size = max_length;
+            }
+
+            std::unique_ptr<char[]> const buffers{new char[2 * chunk_size]};
+            std::size_t buffer_index = 0;
+            auto it = values.begin();
+            while (it != values.end()) {
+                char* const first = buffers.get() + buffer_index * chunk_size;
+                // Another number fits if ptr is not past limit.
+                char* const limit = first + (chunk_size - max_length);
+                auto ptr = first;
+                do {
+                    ptr = to_chars_n(*it, ptr, policies...);
+                    *ptr = '\n';
+                    ++ptr;
+                    ++it;
+                } while (it != values.end() && ptr <= limit);
+
+                co_yield std::span<char const>(first, ptr);
+                buffer_index ^= 1;
+            }
+        }
+    }
+}
+#endif
+
+#endif
@@ -0,0 +1,172 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_DRAGONBOX_STRING
+#define JKJ_HEADER_DRAGONBOX_STRING
+
+#include "dragonbox_to_chars.h"
+
+#include <string>
+#if defined(__has_include)
+    #if __has_include(<version>)
+        #include <version>
+    #endif
+#endif
+#if defined(__cpp_lib_string_view) && __cpp_lib_string_view >= 201606L
+    #include <string_view>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Language feature detections.
+////////////////////////////////////////////////////////////////////////////////////////
+
+// C++20 constexpr with trivial default initialization
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201907L
+    #define JKJ_CONSTEXPR20 constexpr
+#elif defined(_MSC_VER) && _MSC_VER >= 1929 && _MSVC_LANG >= 202002L
+    #define JKJ_CONSTEXPR20 constexpr
+#else
+    #define JKJ_CONSTEXPR20
+#endif
+
+// Conversions into strings without a heap allocation, e.g.
+//
+//   auto s = jkj::dragonbox::to_string(1.5);   // s.view() == "1.5E0"
+//
+// to_string returns an inline_string, which holds the characters in an array sized by
+// max_notation_output_string_length of the notation policy, so it is trivially copyable and can
+// be returned, stored and copied without touching the heap. It converts to std::string_view if
+// available, and to std::string with str().
+//
+// append_to appends the output of to_chars_n to a std::string. With resize_and_overwrite of C++23
+// it is written directly into the string without zero-filling the new characters first, and
+// otherwise it is written into a buffer on the stack and then appended.
+
+namespace jkj {
+    namespace dragonbox {
+        // A null-terminated string of at most Capacity characters, stored inline.
+        template <detail::stdr::size_t Capacity>
+        class inline_string {
+        public:
+            using value_type = char;
+            using size_type = detail::stdr::size_t;
+            using const_pointer = char const*;
+            using const_iterator = char const*;
+
+            // Default-constructs an empty string.
+            JKJ_CONSTEXPR20 inline_string() noexcept { data_[0] = '\0'; }
+
+            static constexpr size_type capacity() noexcept { return Capacity; }
+
+            size_type size() const noexcept { return size_type(length_); }
+            size_type length() const noexcept { return size_type(length_); }
+            bool empty() const noexcept { return length_ == 0; }
+
+            char const* data() const noexcept { return data_; }
+            char const* c_str() const noexcept { return data_; }
+            char const* begin() const noexcept { return data_; }
+            char const* end() const noexcept { return data_ + length_; }
+            char operator[](size_type i) const noexcept { return data_[i]; }
+
+            std::string str() const { return std::string(data_, size()); }
+
+#if defined(__cpp_lib_string_view) && __cpp_lib_string_view >= 201606L
+            std::string_view view() const noexcept { return std::string_view(data_, size()); }
+            operator std::string_view() const noexcept { return view(); }
+#endif
+
+            // Replaces the contents by the output of to_chars_n with the given policies.
+            template <class Float,
+                      class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                      class FormatTraits =
+                          ieee754_binary_traits<typename ConversionTraits::format,
+                                                typename ConversionTraits::carrier_uint>,
+                      class... Policies>
+            void assign(Float x, Policies... policies) noexcept {
+                static_assert(
+                    max_notation_output_string_length<
+                        typename FormatTraits::format,
+                        typename detail::to_chars_policy_holder<Policies...>::notation_policy> <=
+                        Capacity,
+                    "jkj::dragonbox: the output may not fit into the inline_string");
+                auto const last =
+                    to_chars_n<Float, ConversionTraits, FormatTraits>(x, data_, policies...);
+                *last = '\0';
+                length_ = length_type(last - data_);
+            }
+
+        private:
+            // One byte is enough for the length of the scientific notation, so that
+            // inline_string<24> for double is as small as 26 bytes.
+            using length_type = typename detail::stdr::conditional<Capacity < 256, unsigned char,
+                                                                   size_type>::type;
+
+            char data_[Capacity + 1];
+            length_type length_ = 0;
+        };
+
+        // The inline_string just large enough for the output of to_chars_n with the given policies.
+        template <class FloatFormat, class... Policies>
+        using inline_string_for = inline_string<max_notation_output_string_length<
+            FloatFormat, typename detail::to_chars_policy_holder<Policies...>::notation_policy>>;
+
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        inline_string_for<typename FormatTraits::format, Policies...>
+        to_string(Float x, Policies... policies) noexcept {
+            inline_string_for<typename FormatTraits::format, Policies...> result;
+            result.template assign<Float, ConversionTraits, FormatTraits>(x, policies...);
+            return result;
+        }
+
+        // Appends the output of to_chars_n to str, and returns str.
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        std::string& append_to(std::string& str, Float x, Policies... policies) {
+            constexpr auto max_length = max_notation_output_string_length<
+                typename FormatTraits::format,
+                typename detail::to_chars_policy_holder<Policies...>::notation_policy>;
+#if defined(__cpp_lib_string_resize_and_overwrite) &&                                              \
+    __cpp_lib_string_resize_and_overwrite >= 202110L
+            auto const old_size = str.size();
+            str.resize_and_overwrite(old_size + max_length,
+                                     [&](char* buffer, std::string::size_type) noexcept {
+                                         return std::string::size_type(
+                                             to_chars_n<Float, ConversionTraits, FormatTraits>(
+                                                 x, buffer + old_size, policies...) -
+                                             buffer);
+                                     });
+#else
+            char buffer[max_length];
+            auto const last =
+                to_chars_n<Float, ConversionTraits, FormatTraits>(x, buffer, policies...);
+            str.append(buffer, detail::stdr::size_t(last - buffer));
+#endif
+            return str;
+        }
+    }
+}
+
+#undef JKJ_CONSTEXPR20
+
+#endif
@@ -151,28 +151,48 @@
 namespace jkj {
     namespace dragonbox {
         namespace detail {
+            // Defined in dragonbox_to_chars.cpp for char, wchar_t, char16_t and char32_t.
+            template <class FloatFormat, class CarrierUInt, class CharT>
+            extern CharT* to_chars(CarrierUInt significand, int exponent, CharT* buffer) noexcept;
+
+#if defined(__cpp_char8_t) && __cpp_char8_t >= 201811L
+            // The library may be compiled without char8_t, so the char version is reused.
             template <class FloatFormat, class CarrierUInt>
-            extern char* to_chars(CarrierUInt significand, int exponent, char* buffer) noexcept;
+            char8_t* to_chars(CarrierUInt significand, int exponent, char8_t* buffer) noexcept {
+                auto const first = reinterpret_cast<char*>(buffer);
+                return buffer + (to_chars<FloatFormat>(significand, exponent, first) - first);
+            }
+#endif
+
+            template <class CharT>
+            struct is_to_chars_character_type {
+                static constexpr bool value =
+                    stdr::is_same<CharT, char>::value || stdr::is_same<CharT, wchar_t>::value ||
+#if defined(__cpp_char8_t) && __cpp_char8_t >= 201811L
+                    stdr::is_same<CharT, char8_t>::value ||
+#endif
+                    stdr::is_same<CharT, char16_t>::value || stdr::is_same<CharT, char32_t>::value;
+            };
 
-            template <stdr::size_t max_digits, class UInt>
-            JKJ_CONSTEXPR14 char* print_integer_naive(UInt n, char* buffer) noexcept {
-                char temp[max_digits]{};
-                auto ptr = temp + sizeof(temp) - 1;
+            template <stdr::size_t max_digits, class UInt, class CharT>
+            JKJ_CONSTEXPR14 CharT* print_integer_naive(UInt n, CharT* buffer) noexcept {
+                CharT temp[max_digits]{};
+                auto ptr = temp + max_digits - 1;
                 do {
-                    *ptr = char('0' + n % 10);
+                    *ptr = CharT('0' + n % 10);
                     n /= 10;
                     --ptr;
                 } while (n != 0);
-                while (++ptr != temp + sizeof(temp)) {
+                while (++ptr != temp + max_digits) {
                     *buffer = *ptr;
                     ++buffer;
                 }
                 return buffer;
             }
 
-            template <class FloatFormat, class CarrierUInt>
-            JKJ_CONSTEXPR14 char* to_chars_naive(CarrierUInt significand, int exponent,
-                                                 char* buffer) noexcept {
+            template <class FloatFormat, class CarrierUInt, class CharT>
+            JKJ_CONSTEXPR14 CharT* to_chars_naive(CarrierUInt significand, int exponent,
+                                                  CharT* buffer) noexcept {
                 // Print significand.
                 {
                     auto ptr = print_integer_naive<FloatFormat::decimal_significand_digits>(significand,
@@ -213,10 +233,11 @@ namespace jkj {
                     using digit_generation_policy = fast_t;
 
                     template <class DecimalToBinaryRoundingPolicy, class BinaryToDecimalRoundingPolicy,
-                              class CachePolicy, class PreferredIntegerTypesPolicy, class FormatTraits>
-                    static char* to_chars(signed_significand_bits<FormatTraits> s,
-                                          typename FormatTraits::exponent_int exponent_bits,
-                                          char* buffer) noexcept {
+                              class CachePolicy, class PreferredIntegerTypesPolicy, class FormatTraits,
+                              class CharT>
+                    static CharT* to_chars(signed_significand_bits<FormatTraits> s,
+                                           typename FormatTraits::exponent_int exponent_bits,
+                                           CharT* buffer) noexcept {
                         auto result = to_decimal_ex(
                             s, exponent_bits, policy::sign::ignore, policy::trailing_zero::ignore,
                             DecimalToBinaryRoundingPolicy{}, BinaryToDecimalRoundingPolicy{},
@@ -231,10 +252,12 @@ namespace jkj {
                     using digit_generation_policy = compact_t;
 
                     template <class DecimalToBinaryRoundingPolicy, class BinaryToDecimalRoundingPolicy,
-                              class CachePolicy, class PreferredIntegerTypesPolicy, class FormatTraits>
-                    static JKJ_CONSTEXPR20 char*
+                              class CachePolicy, class PreferredIntegerTypesPolicy, class FormatTraits,
+                              class CharT>
+                    static JKJ_CONSTEXPR20 CharT*
                     to_chars(signed_significand_bits<FormatTraits> s,
-                             typename FormatTraits::exponent_int exponent_bits, char* buffer) noexcept {
+                             typename FormatTraits::exponent_int exponent_bits,
+                             CharT* buffer) noexcept {
                         auto result = to_decimal_ex(s, exponent_bits, policy::sign::ignore,
                                                     policy::trailing_zero::remove_compact,
                                                     DecimalToBinaryRoundingPolicy{},
@@ -248,6 +271,13 @@ namespace jkj {
             }
         }
 
+        namespace policy {
+            namespace notation {
+                // Defined below.
+                struct scientific_t;
+            }
+        }
+
         namespace detail {
             struct is_digit_generation_policy {
                 constexpr bool operator()(...) noexcept { return false; }
@@ -257,11 +287,35 @@ namespace jkj {
                 }
             };
 
+            struct is_notation_policy {
+                constexpr bool operator()(...) noexcept { return false; }
+                template <class Policy, class = typename Policy::notation_policy>
+                constexpr bool operator()(dummy<Policy>) noexcept {
+                    return true;
+                }
+            };
+
+            template <class... Policies>
+            using to_chars_policy_holder = make_policy_holder<
+                detector_default_pair_list<
+                    detector_default_pair<is_decimal_to_binary_rounding_policy,
+                                          policy::decimal_to_binary_rounding::nearest_to_even_t>,
+                    detector_default_pair<is_binary_to_decimal_rounding_policy,
+                                          policy::binary_to_decimal_rounding::to_even_t>,
+                    detector_default_pair<is_cache_policy, policy::cache::full_t>,
+                    detector_default_pair<is_preferred_integer_types_policy,
+                                          policy::preferred_integer_types::match_t>,
+                    detector_default_pair<is_digit_generation_policy,
+                                          policy::digit_generation::fast_t>,
+                    detector_default_pair<is_notation_policy, policy::notation::scientific_t>>,
+                Policies...>;
+
             // Avoid needless ABI overhead incurred by tag dispatch.
             template <class DecimalToBinaryRoundingPolicy, class BinaryToDecimalRoundingPolicy,
                       class CachePolicy, class PreferredIntegerTypesPolicy, class DigitGenerationPolicy,
-                      class FormatTraits>
-            JKJ_CONSTEXPR20 char* to_chars_n_impl(float_bits<FormatTraits> br, char* buffer) noexcept {
+                      class FormatTraits, class CharT>
+            JKJ_CONSTEXPR20 CharT* to_chars_n_impl(float_bits<FormatTraits> br,
+                                                   CharT* buffer) noexcept {
                 auto const exponent_bits = br.extract_exponent_bits();
                 auto const s = br.remove_exponent_bits();
 
@@ -295,20 +349,21 @@ namespace jkj {
                             ++buffer;
                         }
                         // MSVC generates two mov's for the below, so we guard it inside
-                        // JKJ_IF_CONSTEVAL.
-                        JKJ_IF_CONSTEVAL {
-                            buffer[0] = 'I';
-                            buffer[1] = 'n';
-                            buffer[2] = 'f';
-                            buffer[3] = 'i';
-                            buffer[4] = 'n';
-                            buffer[5] = 'i';
-                            buffer[6] = 't';
-                            buffer[7] = 'y';
-                        }
-                        else {
-                            stdr::memcpy(buffer, "Infinity", 8);
+                        // JKJ_IF_CONSTEVAL. Other character types are written one by one.
+                        JKJ_IF_NOT_CONSTEVAL {
+                            JKJ_IF_CONSTEXPR(stdr::is_same<CharT, char>::value) {
+                                stdr::memcpy(buffer, "Infinity", 8);
+                                return buffer + 8;
+                            }
                         }
+                        buffer[0] = 'I';
+                        buffer[1] = 'n';
+                        buffer[2] = 'f';
+                        buffer[3] = 'i';
+                        buffer[4] = 'n';
+                        buffer[5] = 'i';
+                        buffer[6] = 't';
+                        buffer[7] = 'y';
                         return buffer + 8;
                     }
                     else {
@@ -322,31 +377,29 @@ namespace jkj {
         }
 
         // Returns the next-to-end position
+        // The buffer may also be of wchar_t, char8_t, char16_t or char32_t, in which case the digits
+        // are written directly as characters of that type; only the scientific notation is
+        // supported then.
         template <class Float,
                   class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
                   class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
                                                              typename ConversionTraits::carrier_uint>,
-                  class... Policies>
-        JKJ_CONSTEXPR20 char* to_chars_n(Float x, char* buffer, Policies...) noexcept {
-            using policy_holder = detail::make_policy_holder<
-                detail::detector_default_pair_list<
-                    detail::detector_default_pair<
-                        detail::is_decimal_to_binary_rounding_policy,
-                        policy::decimal_to_binary_rounding::nearest_to_even_t>,
-                    detail::detector_default_pair<detail::is_binary_to_decimal_rounding_policy,
-                                                  policy::binary_to_decimal_rounding::to_even_t>,
-                    detail::detector_default_pair<detail::is_cache_policy, policy::cache::full_t>,
-                    detail::detector_default_pair<detail::is_preferred_integer_types_policy,
-                                                  policy::preferred_integer_types::match_t>,
-                    detail::detector_default_pair<detail::is_digit_generation_policy,
-                                                  policy::digit_generation::fast_t>>,
-                Policies...>;
+                  class CharT, class... Policies>
+        JKJ_CONSTEXPR20 CharT* to_chars_n(Float x, CharT* buffer, Policies...) noexcept {
+            using policy_holder = detail::to_chars_policy_holder<Policies...>;
+            static_assert(detail::is_to_chars_character_type<CharT>::value,
+                          "jkj::dragonbox: the buffer must be of a character type");
+            static_assert(detail::stdr::is_same<CharT, char>::value ||
+                              detail::stdr::is_same<typename policy_holder::notation_policy,
+                                                    policy::notation::scientific_t>::value,
+                          "jkj::dragonbox: notations other than scientific require a char buffer");
 
-            return detail::to_chars_n_impl<typename policy_holder::decimal_to_binary_rounding_policy,
-                                           typename policy_holder::binary_to_decimal_rounding_policy,
-                                           typename policy_holder::cache_policy,
-                                           typename policy_holder::preferred_integer_types_policy,
-                                           typename policy_holder::digit_generation_policy>(
+            return policy_holder::notation_policy::template to_chars_n<
+                typename policy_holder::decimal_to_binary_rounding_policy,
+                typename policy_holder::binary_to_decimal_rounding_policy,
+                typename policy_holder::cache_policy,
+                typename policy_holder::preferred_integer_types_policy,
+                typename policy_holder::digit_generation_policy>(
                 make_float_bits<Float, ConversionTraits, FormatTraits>(x), buffer);
         }
 
@@ -355,8 +408,8 @@ namespace jkj {
                   class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
                   class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
                                                              typename ConversionTraits::carrier_uint>,
-                  class... Policies>
-        JKJ_CONSTEXPR20 char* to_chars(Float x, char* buffer, Policies... policies) noexcept {
+                  class CharT, class... Policies>
+        JKJ_CONSTEXPR20 CharT* to_chars(Float x, CharT* buffer, Policies... policies) noexcept {
             auto ptr = to_chars_n<Float, ConversionTraits, FormatTraits>(x, buffer, policies...);
             *ptr = '\0';
             return ptr;
@@ -368,6 +421,763 @@ namespace jkj {
             // sign(1) + significand + decimal_point(1) + exp_marker(1) + exp_sign(1) + exp
             1 + FloatFormat::decimal_significand_digits + 1 + 1 + 1 +
             FloatFormat::decimal_exponent_digits;
+
+        namespace detail {
+            // Compute floor(log2(n)) for n != 0.
+            template <class UInt>
+            JKJ_CONSTEXPR14 int floor_log2(UInt n) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+                JKJ_IF_CONSTEXPR(value_bits<UInt>::value <= value_bits<unsigned int>::value) {
+                    return int(value_bits<unsigned int>::value) - 1 - __builtin_clz((unsigned int)(n));
+                }
+                else {
+                    return int(value_bits<unsigned long long>::value) - 1 -
+                           __builtin_clzll((unsigned long long)(n));
+                }
+#else
+                // Binary search without data-dependent branches.
+                int result = 0;
+                for (int shift = int(value_bits<UInt>::value / 2); shift > 0; shift /= 2) {
+                    auto const is_large = int((n >> shift) != 0);
+                    n >>= (shift * is_large);
+                    result += shift * is_large;
+                }
+                return result;
+#endif
+            }
+
+            // Number of decimal digits of n, where 0 is considered to have 1 digit.
+            // floor(log10(n)) is either floor(log10(2^floor(log2(n)))) or that plus one, so the
+            // result is obtained by a multiply-and-shift and a single comparison.
+            template <class UInt>
+            JKJ_CONSTEXPR14 int decimal_length(UInt n) noexcept {
+                static_assert(value_bits<UInt>::value <= 64, "");
+                auto const lower_bound = int(log::floor_log10_pow2(floor_log2(UInt(n | 1))));
+                return lower_bound + 1 +
+                       int(stdr::uint_least64_t(n) >= pow10_table_holder<>::table[lower_bound + 1]);
+            }
+
+            // Computes the number of characters to_chars_n_impl writes, without writing them.
+            template <class DecimalToBinaryRoundingPolicy, class BinaryToDecimalRoundingPolicy,
+                      class CachePolicy, class PreferredIntegerTypesPolicy, class FormatTraits>
+            JKJ_CONSTEXPR20 stdr::size_t formatted_size_impl(float_bits<FormatTraits> br) noexcept {
+                auto const exponent_bits = br.extract_exponent_bits();
+                auto const s = br.remove_exponent_bits();
+
+                if (br.is_finite(exponent_bits)) {
+                    auto const sign_length = stdr::size_t(s.is_negative() ? 1 : 0);
+                    if (br.is_nonzero()) {
+                        auto const result = to_decimal_ex(
+                            s, exponent_bits, policy::sign::ignore, policy::trailing_zero::remove,
+                            DecimalToBinaryRoundingPolicy{}, BinaryToDecimalRoundingPolicy{},
+                            CachePolicy{}, PreferredIntegerTypesPolicy{});
+
+                        // [-]d[.ddd]E[-]ddd
+                        auto const significand_length = decimal_length(result.significand);
+                        auto const exponent = int(result.exponent) + significand_length - 1;
+                        return sign_length + stdr::size_t(significand_length) +
+                               stdr::size_t(significand_length > 1 ? 1 : 0) + 1 +
+                               stdr::size_t(exponent < 0 ? 1 : 0) +
+                               stdr::size_t(decimal_length(unsigned(exponent < 0 ? -exponent
+                                                                                 : exponent)));
+                    }
+                    else {
+                        // [-]0E0
+                        return sign_length + 3;
+                    }
+                }
+                else {
+                    if (s.has_all_zero_significand_bits()) {
+                        // [-]Infinity
+                        return stdr::size_t(s.is_negative() ? 1 : 0) + 8;
+                    }
+                    else {
+                        return 3;
+                    }
+                }
+            }
+        }
+
+        // Returns the number of characters to_chars_n writes for x with the same policies, without
+        // generating the digits.
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        JKJ_CONSTEXPR20 detail::stdr::size_t formatted_size(Float x, Policies...) noexcept {
+            using policy_holder = detail::to_chars_policy_holder<Policies...>;
+            static_assert(detail::stdr::is_same<typename policy_holder::notation_policy,
+                                                policy::notation::scientific_t>::value,
+                          "formatted_size supports only the scientific notation");
+
+            return detail::formatted_size_impl<
+                typename policy_holder::decimal_to_binary_rounding_policy,
+                typename policy_holder::binary_to_decimal_rounding_policy,
+                typename policy_holder::cache_policy,
+                typename policy_holder::preferred_integer_types_policy>(
+                make_float_bits<Float, ConversionTraits, FormatTraits>(x));
+        }
+
+        // Stores formatted_size(x[i], policies...) into sizes[i] for each i < count and returns their
+        // sum.
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        JKJ_CONSTEXPR20 detail::stdr::size_t formatted_sizes(Float const* x,
+                                                             detail::stdr::size_t count,
+                                                             detail::stdr::size_t* sizes,
+                                                             Policies... policies) noexcept {
+            detail::stdr::size_t total = 0;
+            for (detail::stdr::size_t i = 0; i < count; ++i) {
+                sizes[i] = formatted_size<Float, ConversionTraits, FormatTraits>(x[i], policies...);
+                total += sizes[i];
+            }
+            return total;
+        }
+
+        // Two-pass bulk formatting.
+        // The first pass, to_chars_bulk_offsets, computes the exact output length of each of
+        // x[0], ... , x[count - 1] and stores their positions into offsets[0], ... , offsets[count],
+        // so that the output of x[i] followed by a separator occupies [offsets[i], offsets[i + 1]).
+        // The return value is offsets[count], the total length of the output.
+        // The second pass, to_chars_bulk_write, writes the output of x[first], ... , x[last - 1]
+        // directly into their final positions. Calls for disjoint ranges write into disjoint parts
+        // of the buffer, so they can run concurrently.
+        // Both passes must be given the same policies.
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        JKJ_CONSTEXPR20 detail::stdr::size_t to_chars_bulk_offsets(Float const* x,
+                                                                   detail::stdr::size_t count,
+                                                                   detail::stdr::size_t* offsets,
+                                                                   Policies...) noexcept {
+            auto length = [](Float value) {
+                // The output followed by a separator.
+                return formatted_size<Float, ConversionTraits, FormatTraits>(value, Policies{}...) +
+                       1;
+            };
+            // The prefix sum below works on 8 lengths packed into bytes.
+            static_assert(8 * (max_output_string_length<typename FormatTraits::format> + 1) < 256,
+                          "");
+
+            detail::stdr::size_t offset = 0;
+            offsets[0] = 0;
+            detail::stdr::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                detail::stdr::uint_least64_t packed = 0;
+                for (int j = 0; j < 8; ++j) {
+                    packed |= detail::stdr::uint_least64_t(length(x[i + j])) << (8 * j);
+                }
+                // Each byte of the product is the sum of the bytes at or below it.
+                auto const sums = packed * UINT64_C(0x0101010101010101);
+                for (int j = 0; j < 8; ++j) {
+                    offsets[i + j + 1] = offset + detail::stdr::size_t((sums >> (8 * j)) & 0xff);
+                }
+                offset += detail::stdr::size_t(sums >> 56);
+            }
+            for (; i < count; ++i) {
+                offset += length(x[i]);
+                offsets[i + 1] = offset;
+            }
+            return offset;
+        }
+
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        JKJ_CONSTEXPR20 void to_chars_bulk_write(Float const* x, detail::stdr::size_t first,
+                                                 detail::stdr::size_t last,
+                                                 detail::stdr::size_t const* offsets, char separator,
+                                                 char* buffer, Policies... policies) noexcept {
+            for (auto i = first; i < last; ++i) {
+                auto const ptr = to_chars_n<Float, ConversionTraits, FormatTraits>(
+                    x[i], buffer + offsets[i], policies...);
+                assert(ptr == buffer + offsets[i + 1] - 1);
+                *ptr = separator;
+            }
+        }
+
+        namespace detail {
+            template <class DecimalToBinaryRoundingPolicy>
+            struct is_directed_rounding_policy {
+                static constexpr bool value =
+                    stdr::is_same<DecimalToBinaryRoundingPolicy,
+                                  policy::decimal_to_binary_rounding::toward_plus_infinity_t>::value ||
+                    stdr::is_same<DecimalToBinaryRoundingPolicy,
+                                  policy::decimal_to_binary_rounding::toward_minus_infinity_t>::value ||
+                    stdr::is_same<DecimalToBinaryRoundingPolicy,
+                                  policy::decimal_to_binary_rounding::toward_zero_t>::value ||
+                    stdr::is_same<DecimalToBinaryRoundingPolicy,
+                                  policy::decimal_to_binary_rounding::away_from_zero_t>::value;
+            };
+
+            template <class DecimalToBinaryRoundingPolicy, class BinaryToDecimalRoundingPolicy,
+                      class CachePolicy, class PreferredIntegerTypesPolicy, class FormatTraits>
+            JKJ_CONSTEXPR20 char* to_chars_n_capped_impl(float_bits<FormatTraits> br, char* buffer,
+                                                         int max_significant_digits) noexcept {
+                static_assert(!is_directed_rounding_policy<DecimalToBinaryRoundingPolicy>::value,
+                              "to_chars_n_capped requires a round-to-nearest decimal-to-binary "
+                              "rounding policy");
+                static_assert(BinaryToDecimalRoundingPolicy::tag !=
+                                  policy::binary_to_decimal_rounding::tag_t::do_not_care,
+                              "to_chars_n_capped requires correct binary-to-decimal rounding");
+                assert(max_significant_digits >= 1);
+
+                auto const exponent_bits = br.extract_exponent_bits();
+                auto const s = br.remove_exponent_bits();
+                if (!br.is_finite(exponent_bits) || !br.is_nonzero()) {
+                    return to_chars_n_impl<DecimalToBinaryRoundingPolicy,
+                                           BinaryToDecimalRoundingPolicy, CachePolicy,
+                                           PreferredIntegerTypesPolicy,
+                                           policy::digit_generation::fast_t>(br, buffer);
+                }
+
+                if (s.is_negative()) {
+                    *buffer = '-';
+                    ++buffer;
+                }
+                auto result = to_decimal_ex(s, exponent_bits, policy::sign::ignore,
+                                            policy::trailing_zero::remove,
+                                            DecimalToBinaryRoundingPolicy{},
+                                            BinaryToDecimalRoundingPolicy{}, CachePolicy{},
+                                            PreferredIntegerTypesPolicy{});
+                using carrier_uint = typename FormatTraits::carrier_uint;
+                auto significand = carrier_uint(result.significand);
+                auto exponent = int(result.exponent);
+
+                auto const length = decimal_length(significand);
+                if (length > max_significant_digits) {
+                    // Round off the excess digits. Since the shortest representation lies within
+                    // the rounding interval of x and is the closest one to x among the candidates
+                    // of the same length, rounding it gives the same result as rounding x itself,
+                    // unless the digits rounded off are exactly one-half. Trailing zeros are already
+                    // removed, so that can only happen when exactly one digit 5 is rounded off, in
+                    // which case x is compared with the shortest representation exactly.
+                    auto const excess = length - max_significant_digits;
+                    auto const divisor = carrier_uint(pow10_table_holder<>::table[excess]);
+                    auto const remainder = carrier_uint(significand % divisor);
+                    significand /= divisor;
+                    exponent += excess;
+
+                    bool round_up = remainder > divisor / 2;
+                    if (remainder == divisor / 2) {
+                        auto const comparison = compare_binary_with_decimal(
+                            br.binary_significand(),
+                            int(br.binary_exponent()) - FormatTraits::format::significand_bits,
+                            result.significand, int(result.exponent));
+                        round_up =
+                            comparison > 0 ||
+                            (comparison == 0 &&
+                             !BinaryToDecimalRoundingPolicy::prefer_round_down(significand + 1));
+                    }
+                    if (round_up) {
+                        ++significand;
+                    }
+                    remove_trailing_zeros_traits<policy::trailing_zero::remove_t,
+                                                 typename FormatTraits::format, carrier_uint,
+                                                 int>::remove_trailing_zeros(significand, exponent);
+                }
+                return to_chars<typename FormatTraits::format>(significand, exponent, buffer);
+            }
+        }
+
+        // Same as to_chars_n, except that if the shortest representation has more than
+        // max_significant_digits significant digits, x correctly rounded to
+        // max_significant_digits significant digits is printed instead, with ties broken by the
+        // binary-to-decimal rounding policy. The output then no longer roundtrips.
+        // max_significant_digits must be at least 1, and the decimal-to-binary rounding policy
+        // must be one of the round-to-nearest policies.
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        JKJ_CONSTEXPR20 char* to_chars_n_capped(Float x, char* buffer, int max_significant_digits,
+                                                Policies...) noexcept {
+            using policy_holder = detail::to_chars_policy_holder<Policies...>;
+            static_assert(detail::stdr::is_same<typename policy_holder::notation_policy,
+                                                policy::notation::scientific_t>::value,
+                          "to_chars_n_capped supports only the scientific notation");
+
+            return detail::to_chars_n_capped_impl<
+                typename policy_holder::decimal_to_binary_rounding_policy,
+                typename policy_holder::binary_to_decimal_rounding_policy,
+                typename policy_holder::cache_policy,
+                typename policy_holder::preferred_integer_types_policy>(
+                make_float_bits<Float, ConversionTraits, FormatTraits>(x), buffer,
+                max_significant_digits);
+        }
+
+        // Null-terminate and bypass the return value of to_chars_n_capped.
+        template <class Float,
+                  class ConversionTraits = default_float_bit_carrier_conversion_traits<Float>,
+                  class FormatTraits = ieee754_binary_traits<typename ConversionTraits::format,
+                                                             typename ConversionTraits::carrier_uint>,
+                  class... Policies>
+        JKJ_CONSTEXPR20 char* to_chars_capped(Float x, char* buffer, int max_significant_digits,
+                                              Policies... policies) noexcept {
+            auto ptr = to_chars_n_capped<Float, ConversionTraits, FormatTraits>(
+                x, buffer, max_significant_digits, policies...);
+            *ptr = '\0';
+            return ptr;
+        }
+
+        namespace detail {
+            // si_prefixes lists the prefixes for 10^-30, 10^-27, ... , 10^30 in 2-character slots,
+            // padded with spaces. If it is null, or the exponent is out of that range, the exponent
+            // is written as in the scientific notation.
+            template <class DecimalToBinaryRoundingPolicy, class BinaryToDecimalRoundingPolicy,
+                      class CachePolicy, class PreferredIntegerTypesPolicy, class FormatTraits>
+            JKJ_CONSTEXPR20 char* to_chars_n_engineering_impl(float_bits<FormatTraits> br,
+                                                              char* buffer,
+                                                              char const* si_prefixes) noexcept {
+                using format = typename FormatTraits::format;
+                auto const exponent_bits = br.extract_exponent_bits();
+                auto const s = br.remove_exponent_bits();
+                if (!br.is_finite(exponent_bits) || (!br.is_nonzero() && si_prefixes == nullptr)) {
+                    return to_chars_n_impl<DecimalToBinaryRoundingPolicy,
+                                           BinaryToDecimalRoundingPolicy, CachePolicy,
+                                           PreferredIntegerTypesPolicy,
+                                           policy::digit_generation::fast_t>(br, buffer);
+                }
+
+                if (s.is_negative()) {
+                    *buffer = '-';
+                    ++buffer;
+                }
+                if (!br.is_nonzero()) {
+                    *buffer = '0';
+                    return buffer + 1;
+                }
+
+                // Print d[.ddd]E[-]ddd as in to_chars_n.
+                int exponent;
+                char* last;
+                JKJ_IF_CONSTEVAL {
+                    auto const result = to_decimal_ex(
+                        s, exponent_bits, policy::sign::ignore, policy::trailing_zero::remove_compact,
+                        DecimalToBinaryRoundingPolicy{}, BinaryToDecimalRoundingPolicy{},
+                        CachePolicy{}, PreferredIntegerTypesPolicy{});
+                    exponent = int(result.exponent) + decimal_length(result.significand) - 1;
+                    last = to_chars_naive<format>(result.significand, int(result.exponent), buffer);
+                }
+                else {
+                    auto const result = to_decimal_ex(
+                        s, exponent_bits, policy::sign::ignore, policy::trailing_zero::ignore,
+                        DecimalToBinaryRoundingPolicy{}, BinaryToDecimalRoundingPolicy{},
+                        CachePolicy{}, PreferredIntegerTypesPolicy{});
+                    exponent = int(result.exponent) + decimal_length(result.significand) - 1;
+                    last = to_chars<format>(result.significand, int(result.exponent), buffer);
+                }
+
+                // Then move the decimal point to the right by 0 to 2 digits, appending zeros if
+                // there are not enough digits, and rewrite the exponent. The shift, the sign and
+                // the length of the exponent are unpredictable, so branches are avoided for them.
+                auto const abs_exponent = exponent < 0 ? -exponent : exponent;
+                auto const exponent_marker = last - 2 - (exponent < 0 ? 1 : 0) -
+                                             (abs_exponent >= 10 ? 1 : 0) -
+                                             (abs_exponent >= 100 ? 1 : 0);
+                // exponent + 999 is nonnegative, so this compiles into a multiplication.
+                auto const shift = int(unsigned(exponent + 999) % 3);
+                exponent -= shift;
+                auto const fraction_length =
+                    exponent_marker - buffer > 1 ? int(exponent_marker - buffer) - 2 : 0;
+                if (fraction_length > shift) {
+                    // buffer[3] may be the exponent marker if shift == 0.
+                    auto const first = buffer[2];
+                    auto const second = buffer[3];
+                    buffer[1] = shift == 0 ? '.' : first;
+                    buffer[2] = shift == 0 ? first : (shift == 1 ? '.' : second);
+                    buffer[3] = shift == 2 ? '.' : second;
+                    buffer = exponent_marker;
+                }
+                else {
+                    for (int i = 1; i <= fraction_length; ++i) {
+                        buffer[i] = buffer[i + 1];
+                    }
+                    for (int i = fraction_length + 1; i <= shift; ++i) {
+                        buffer[i] = '0';
+                    }
+                    buffer += shift + 1;
+                }
+
+                if (si_prefixes != nullptr && exponent >= -30 && exponent <= 30) {
+                    auto const prefix = si_prefixes + (exponent / 3 + 10) * 2;
+                    if (prefix[0] != ' ') {
+                        *buffer = prefix[0];
+                        ++buffer;
+                    }
+                    if (prefix[1] != ' ') {
+                        *buffer = prefix[1];
+                        ++buffer;
+                    }
+                    return buffer;
+                }
+
+                buffer[0] = 'E';
+                buffer[1] = '-';
+                buffer += exponent < 0 ? 2 : 1;
+                exponent = exponent < 0 ? -exponent : exponent;
+                *buffer = char('0' + exponent / 100);
+                buffer += exponent >= 100 ? 1 : 0;
+                *buffer = char('0' + exponent / 10 % 10);
+                buffer += exponent >= 10 ? 1 : 0;
+                *buffer = char('0' + exponent % 10);
+                return buffer + 1;
+            }
+
+            // Zeros with GroupingSeparator at every GroupingSize + 1 characters from the right end.
+            constexpr int grouped_zeros_length = 512;
+
+            template <char GroupingSeparator, int GroupingSize>
+            JKJ_CONSTEXPR14 array<char, grouped_zeros_length> make_grouped_zeros() noexcept {
+                array<char, grouped_zeros_length> zeros{};
+                for (int offset = 1; offset <= grouped_zeros_length; ++offset) {
+                    zeros[stdr::size_t(grouped_zeros_length - offset)] =
+                        offset % (GroupingSize + 1) == 0 ? GroupingSeparator : '0';
+                }
+                return zeros;
+            }
+
+            template <char GroupingSeparator, int GroupingSize>
+            JKJ_INLINE_VARIABLE array<char, grouped_zeros_length> grouped_zeros =
+                make_grouped_zeros<GroupingSeparator, GroupingSize>();
+
+            // Copies the last length characters of grouped_zeros into first, in possibly
+            // overlapping chunks of a fixed size, which compile into a few moves, unlike a call to
+            // memcpy. length should not be larger than grouped_zeros_length.
+            template <char GroupingSeparator, int GroupingSize>
+            void copy_grouped_zeros(char* first, int length) noexcept {
+                auto const zeros = grouped_zeros<GroupingSeparator, GroupingSize>.data_ +
+                                   (grouped_zeros_length - length);
+                if (length >= 16) {
+                    for (auto remaining = length; remaining > 16;) {
+                        remaining -= 16;
+                        stdr::memcpy(first + remaining, zeros + remaining, 16);
+                    }
+                    stdr::memcpy(first, zeros, 16);
+                }
+                else if (length >= 8) {
+                    stdr::memcpy(first, zeros, 8);
+                    stdr::memcpy(first + length - 8, zeros + length - 8, 8);
+                }
+                else if (length >= 4) {
+                    stdr::memcpy(first, zeros, 4);
+                    stdr::memcpy(first + length - 4, zeros + length - 4, 4);
+                }
+                else {
+                    for (int i = 0; i < length; ++i) {
+                        first[i] = zeros[i];
+                    }
+                }
+            }
+
+            // Fills [first, first + length) with zeros, with GroupingSeparator at every
+            // GroupingSize + 1 characters from the right (including first itself) unless it is
+            // '\0'.
+            template <char GroupingSeparator, int GroupingSize>
+            JKJ_CONSTEXPR20 void fill_grouped_zeros(char* first, int length) noexcept {
+                JKJ_IF_NOT_CONSTEVAL {
+                    JKJ_IF_CONSTEXPR(GroupingSeparator != '\0' &&
+                                     GroupingSize < grouped_zeros_length) {
+                        // Longer runs are copied from the right end in chunks whose lengths are
+                        // multiples of GroupingSize + 1, so that the separators stay in place.
+                        constexpr int chunk_length =
+                            grouped_zeros_length - grouped_zeros_length % (GroupingSize + 1);
+                        while (length > grouped_zeros_length) {
+                            length -= chunk_length;
+                            copy_grouped_zeros<GroupingSeparator, GroupingSize>(first + length,
+                                                                                chunk_length);
+                        }
+                        copy_grouped_zeros<GroupingSeparator, GroupingSize>(first, length);
+                        return;
+                    }
+                }
+                for (int i = 0; i < length; ++i) {
+                    first[i] = '0';
+                }
+                if (GroupingSeparator != '\0') {
+                    for (int offset = GroupingSize + 1; offset <= length; offset += GroupingSize + 1) {
+                        first[length - offset] = GroupingSeparator;
+                    }
+                }
+            }
+
+            template <class DecimalToBinaryRoundingPolicy, class BinaryToDecimalRoundingPolicy,
+                      class CachePolicy, class PreferredIntegerTypesPolicy, char DecimalSeparator,
+                      char GroupingSeparator, int GroupingSize, class FormatTraits>
+            JKJ_CONSTEXPR20 char* to_chars_n_fixed_impl(float_bits<FormatTraits> br,
+                                                        char* buffer) noexcept {
+                auto const exponent_bits = br.extract_exponent_bits();
+                auto const s = br.remove_exponent_bits();
+                if (!br.is_finite(exponent_bits)) {
+                    return to_chars_n_impl<DecimalToBinaryRoundingPolicy,
+                                           BinaryToDecimalRoundingPolicy, CachePolicy,
+                                           PreferredIntegerTypesPolicy,
+                                           policy::digit_generation::fast_t>(br, buffer);
+                }
+
+                if (s.is_negative()) {
+                    *buffer = '-';
+                    ++buffer;
+                }
+                if (!br.is_nonzero()) {
+                    *buffer = '0';
+                    return buffer + 1;
+                }
+
+                auto const result = to_decimal_ex(
+                    s, exponent_bits, policy::sign::ignore, policy::trailing_zero::remove,
+                    DecimalToBinaryRoundingPolicy{}, BinaryToDecimalRoundingPolicy{}, CachePolicy{},
+                    PreferredIntegerTypesPolicy{});
+                auto significand = result.significand;
+                auto const exponent = int(result.exponent);
+                auto const significand_length = decimal_length(significand);
+
+                // The integer part is a single 0 if the number is less than 1. The lengths of the
+                // integer part and of the fraction are known in advance, so the digits are written
+                // from the right to the left in one pass, together with the separators.
+                auto const integer_length =
+                    significand_length + exponent > 0 ? significand_length + exponent : 1;
+                auto const fraction_length = exponent < 0 ? -exponent : 0;
+                auto const number_of_separators =
+                    GroupingSeparator != '\0' ? (integer_length - 1) / GroupingSize : 0;
+                auto const last = buffer + integer_length + number_of_separators +
+                                  (fraction_length > 0 ? fraction_length + 1 : 0);
+
+                auto ptr = last;
+                if (fraction_length > 0) {
+                    // The digits of the significand, and then zeros if the number is less than 1.
+                    auto const fraction_digits = fraction_length < significand_length
+                                                     ? fraction_length
+                                                     : significand_length;
+                    for (int i = 0; i < fraction_digits; ++i) {
+                        --ptr;
+                        *ptr = char('0' + significand % 10);
+                        significand /= 10;
+                    }
+                    for (int i = fraction_digits; i < fraction_length; ++i) {
+                        --ptr;
+                        *ptr = '0';
+                    }
+                    --ptr;
+                    *ptr = DecimalSeparator;
+                }
+
+                // Zeros appended to the significand, which may be hundreds of digits, are written
+                // at once together with the separators between them, and the one to their left if
+                // they end a group.
+                auto const appended_zeros = exponent > 0 ? exponent : 0;
+                if (appended_zeros > 0) {
+                    auto const zeros_length =
+                        appended_zeros +
+                        (GroupingSeparator != '\0' ? appended_zeros / GroupingSize : 0);
+                    ptr -= zeros_length;
+                    fill_grouped_zeros<GroupingSeparator, GroupingSize>(ptr, zeros_length);
+                }
+
+                // Then the remaining digits of the significand, which is already 0 if the number
+                // is less than 1.
+                auto const significand_digits = integer_length - appended_zeros;
+                JKJ_IF_CONSTEXPR(GroupingSeparator == '\0') {
+                    for (int i = 0; i < significand_digits; ++i) {
+                        --ptr;
+                        *ptr = char('0' + significand % 10);
+                        significand /= 10;
+                    }
+                    return last;
+                }
+
+                // With grouping, they are printed into a temporary buffer padded by zeros to
+                // a whole group, and then copied from the left one whole group at a time, so that
+                // no branch is taken per digit. The padding overwrites the appended zeros with
+                // zeros.
+                char digits[FormatTraits::format::decimal_significand_digits + GroupingSize];
+                for (auto& digit : digits) {
+                    digit = '0';
+                }
+                for (int i = significand_digits - 1; i >= 0; --i) {
+                    digits[i] = char('0' + significand % 10);
+                    significand /= 10;
+                }
+                auto const first_group_length = (integer_length - 1) % GroupingSize + 1;
+                for (int i = 0; i < first_group_length; ++i) {
+                    buffer[i] = digits[i];
+                }
+                buffer += first_group_length;
+                for (int copied = first_group_length; copied < significand_digits;
+                     copied += GroupingSize) {
+                    *buffer = GroupingSeparator;
+                    for (int i = 0; i < GroupingSize; ++i) {
+                        buffer[i + 1] = digits[copied + i];
+                    }
+                    buffer += GroupingSize + 1;
+                }
+                return last;
+            }
+        }
+
+        namespace policy {
+            // Notation policies select the form of the output of to_chars_n and to_chars. Other than
+            // scientific_t, they print the shortest digits given by to_decimal, like
+            // policy::trailing_zero::remove, and ignore the digit generation policy.
+            namespace notation {
+                // d.dddE[-]ddd, the default.
+                JKJ_INLINE_VARIABLE struct scientific_t {
+                    using notation_policy = scientific_t;
+
+                    template <class FloatFormat>
+                    static constexpr detail::stdr::size_t max_output_length() noexcept {
+                        return max_output_string_length<FloatFormat>;
+                    }
+
+                    template <class DecimalToBinaryRoundingPolicy, class BinaryToDecimalRoundingPolicy,
+                              class CachePolicy, class PreferredIntegerTypesPolicy,
+                              class DigitGenerationPolicy, class FormatTraits, class CharT>
+                    static JKJ_CONSTEXPR20 CharT* to_chars_n(float_bits<FormatTraits> br,
+                                                             CharT* buffer) noexcept {
+                        return detail::to_chars_n_impl<DecimalToBinaryRoundingPolicy,
+                                                       BinaryToDecimalRoundingPolicy, CachePolicy,
+                                                       PreferredIntegerTypesPolicy,
+                                                       DigitGenerationPolicy>(br, buffer);
+                    }
+                } scientific = {};
+
+                // The exponent is a multiple of 3, e.g. 12.5E3, 340E-6 or 100E3 for 1E5.
+                JKJ_INLINE_VARIABLE struct engineering_t {
+                    using notation_policy = engineering_t;
+
+                    template <class FloatFormat>
+                    static constexpr detail::stdr::size_t max_output_length() noexcept {
+                        return max_output_string_length<FloatFormat>;
+                    }
+
+                    template <class DecimalToBinaryRoundingPolicy, class BinaryToDecimalRoundingPolicy,
+                              class CachePolicy, class PreferredIntegerTypesPolicy,
+                              class DigitGenerationPolicy, class FormatTraits>
+                    static JKJ_CONSTEXPR20 char* to_chars_n(float_bits<FormatTraits> br,
+                                                            char* buffer) noexcept {
+                        return detail::to_chars_n_engineering_impl<
+                            DecimalToBinaryRoundingPolicy, BinaryToDecimalRoundingPolicy,
+                            CachePolicy, PreferredIntegerTypesPolicy>(br, buffer, nullptr);
+                    }
+                } engineering = {};
+
+                // Same as engineering_t, except that the exponents from -30 to 30 are replaced by SI
+                // prefixes, e.g. 12.5k, 1.5 or 0. Micro is the micro sign U+00B5 encoded in UTF-8.
+                // Exponents out of that range are written as in engineering_t.
+                JKJ_INLINE_VARIABLE struct si_prefix_t {
+                    using notation_policy = si_prefix_t;
+
+                    template <class FloatFormat>
+                    static constexpr detail::stdr::size_t max_output_length() noexcept {
+                        return max_output_string_length<FloatFormat>;
+                    }
+
+                    template <class DecimalToBinaryRoundingPolicy, class BinaryToDecimalRoundingPolicy,
+                              class CachePolicy, class PreferredIntegerTypesPolicy,
+                              class DigitGenerationPolicy, class FormatTraits>
+                    static JKJ_CONSTEXPR20 char* to_chars_n(float_bits<FormatTraits> br,
+                                                            char* buffer) noexcept {
+                        return detail::to_chars_n_engineering_impl<
+                            DecimalToBinaryRoundingPolicy, BinaryToDecimalRoundingPolicy,
+                            CachePolicy, PreferredIntegerTypesPolicy>(
+                            br, buffer, "q r y z a f p n \xc2\xb5" "m   k M G T P E Z Y R Q ");
+                    }
+                } si_prefix = {};
+
+                // Same as si_prefix_t, except that u is used for micro.
+                JKJ_INLINE_VARIABLE struct si_prefix_ascii_t {
+                    using notation_policy = si_prefix_ascii_t;
+
+                    template <class FloatFormat>
+                    static constexpr detail::stdr::size_t max_output_length() noexcept {
+                        return max_output_string_length<FloatFormat>;
+                    }
+
+                    template <class DecimalToBinaryRoundingPolicy, class BinaryToDecimalRoundingPolicy,
+                              class CachePolicy, class PreferredIntegerTypesPolicy,
+                              class DigitGenerationPolicy, class FormatTraits>
+                    static JKJ_CONSTEXPR20 char* to_chars_n(float_bits<FormatTraits> br,
+                                                            char* buffer) noexcept {
+                        return detail::to_chars_n_engineering_impl<
+                            DecimalToBinaryRoundingPolicy, BinaryToDecimalRoundingPolicy,
+                            CachePolicy, PreferredIntegerTypesPolicy>(
+                            br, buffer, "q r y z a f p n u m   k M G T P E Z Y R Q ");
+                    }
+                } si_prefix_ascii = {};
+
+                // Positional notation with DecimalSeparator as the decimal point, e.g. 1234567.89,
+                // 0.00034 or 100000 for 1E5. If GroupingSeparator is not '\0', it is inserted
+                // between every GroupingSize digits of the integer part, e.g. fixed_t<',', '.', 3>
+                // gives 1.234.567,89. Zeros are appended to the shortest digits, e.g. 1E23 is
+                // 100000000000000000000000, whereas std::to_chars prints the exact binary value.
+                // The output is longer than max_output_string_length; use
+                // max_notation_output_string_length to size the buffer.
+                template <char DecimalSeparator = '.', char GroupingSeparator = '\0',
+                          int GroupingSize = 3>
+                struct fixed_t {
+                    using notation_policy = fixed_t;
+                    static_assert(GroupingSize > 0,
+                                  "jkj::dragonbox: the grouping size must be positive");
+
+                    template <class DecimalToBinaryRoundingPolicy, class BinaryToDecimalRoundingPolicy,
+                              class CachePolicy, class PreferredIntegerTypesPolicy,
+                              class DigitGenerationPolicy, class FormatTraits>
+                    static JKJ_CONSTEXPR20 char* to_chars_n(float_bits<FormatTraits> br,
+                                                            char* buffer) noexcept {
+                        return detail::to_chars_n_fixed_impl<
+                            DecimalToBinaryRoundingPolicy, BinaryToDecimalRoundingPolicy,
+                            CachePolicy, PreferredIntegerTypesPolicy, DecimalSeparator,
+                            GroupingSeparator, GroupingSize>(br, buffer);
+                    }
+
+                    // Either the number is at least 1, so that the fraction is shorter than
+                    // decimal_significand_digits, or the integer part is 0 and the fraction ends
+                    // less than decimal_significand_digits digits after the smallest subnormal.
+                    template <class FloatFormat>
+                    static constexpr detail::stdr::size_t max_output_length() noexcept {
+                        return detail::stdr::size_t(larger(
+                            // sign(1) + integer + separators + decimal_point(1) + fraction
+                            1 + max_integer_length<FloatFormat>() +
+                                number_of_separators(max_integer_length<FloatFormat>()) +
+                                FloatFormat::decimal_significand_digits,
+                            // sign(1) + 0(1) + decimal_point(1) + fraction
+                            3 + max_fraction_length<FloatFormat>()));
+                    }
+
+                private:
+                    template <class FloatFormat>
+                    static constexpr int max_integer_length() noexcept {
+                        return int(detail::log::floor_log10_pow2(FloatFormat::max_exponent + 1)) + 1;
+                    }
+                    template <class FloatFormat>
+                    static constexpr int max_fraction_length() noexcept {
+                        return FloatFormat::decimal_significand_digits - 1 -
+                               int(detail::log::floor_log10_pow2(FloatFormat::min_exponent -
+                                                                 FloatFormat::significand_bits));
+                    }
+                    static constexpr int number_of_separators(int integer_length) noexcept {
+                        return GroupingSeparator != '\0' ? (integer_length - 1) / GroupingSize : 0;
+                    }
+                    static constexpr int larger(int a, int b) noexcept { return a > b ? a : b; }
+                };
+
+                JKJ_INLINE_VARIABLE fixed_t<> fixed = {};
+            }
+        }
+
+        // Maximum required buffer size (excluding null-terminator) with the given notation policy
+        template <class FloatFormat, class NotationPolicy>
+        JKJ_INLINE_VARIABLE detail::stdr::size_t max_notation_output_string_length =
+            NotationPolicy::template max_output_length<FloatFormat>();
     }
 }
 
@@ -0,0 +1,97 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+
+#include "dragonbox/dragonbox_runtime_rounding.h"
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace jkj {
+    namespace dragonbox {
+        namespace {
+            // In the order of decimal_to_binary_rounding_mode.
+            using decimal_to_binary_rounding_policies =
+                std::tuple<policy::decimal_to_binary_rounding::nearest_to_even_t,
+                           policy::decimal_to_binary_rounding::nearest_to_odd_t,
+                           policy::decimal_to_binary_rounding::nearest_toward_plus_infinity_t,
+                           policy::decimal_to_binary_rounding::nearest_toward_minus_infinity_t,
+                           policy::decimal_to_binary_rounding::nearest_toward_zero_t,
+                           policy::decimal_to_binary_rounding::nearest_away_from_zero_t,
+                           policy::decimal_to_binary_rounding::toward_plus_infinity_t,
+                           policy::decimal_to_binary_rounding::toward_minus_infinity_t,
+                           policy::decimal_to_binary_rounding::toward_zero_t,
+                           policy::decimal_to_binary_rounding::away_from_zero_t>;
+
+            // In the order of binary_to_decimal_rounding_mode.
+            using binary_to_decimal_rounding_policies =
+                std::tuple<policy::binary_to_decimal_rounding::do_not_care_t,
+                           policy::binary_to_decimal_rounding::to_even_t,
+                           policy::binary_to_decimal_rounding::to_odd_t,
+                           policy::binary_to_decimal_rounding::away_from_zero_t,
+                           policy::binary_to_decimal_rounding::toward_zero_t>;
+
+            static_assert(std::tuple_size<decimal_to_binary_rounding_policies>::value ==
+                              detail::number_of_decimal_to_binary_rounding_modes,
+                          "");
+            static_assert(std::tuple_size<binary_to_decimal_rounding_policies>::value ==
+                              detail::number_of_binary_to_decimal_rounding_modes,
+                          "");
+            static_assert(std::size_t(decimal_to_binary_rounding_mode::away_from_zero) + 1 ==
+                              detail::number_of_decimal_to_binary_rounding_modes,
+                          "");
+            static_assert(std::size_t(binary_to_decimal_rounding_mode::toward_zero) + 1 ==
+                              detail::number_of_binary_to_decimal_rounding_modes,
+                          "");
+
+            template <class Float, class DecimalToBinaryRoundingPolicy,
+                      class BinaryToDecimalRoundingPolicy>
+            char* to_chars_n_with(Float x, char* buffer) {
+                return to_chars_n(x, buffer, DecimalToBinaryRoundingPolicy{},
+                                  BinaryToDecimalRoundingPolicy{});
+            }
+
+            template <class Float, std::size_t index>
+            constexpr to_chars_n_function<Float> table_entry() noexcept {
+                constexpr auto n = detail::number_of_binary_to_decimal_rounding_modes;
+                return &to_chars_n_with<
+                    Float,
+                    typename std::tuple_element<index / n, decimal_to_binary_rounding_policies>::type,
+                    typename std::tuple_element<index % n, binary_to_decimal_rounding_policies>::type>;
+            }
+
+            template <class Float, std::size_t... indices>
+            constexpr detail::to_chars_n_table<Float>
+            make_to_chars_n_table(std::index_sequence<indices...>) noexcept {
+                return {{table_entry<Float, indices>()...}};
+            }
+
+            template <class Float>
+            constexpr detail::to_chars_n_table<Float> make_to_chars_n_table() noexcept {
+                return make_to_chars_n_table<Float>(
+                    std::make_index_sequence<detail::number_of_decimal_to_binary_rounding_modes *
+                                             detail::number_of_binary_to_decimal_rounding_modes>{});
+            }
+        }
+
+        namespace detail {
+            to_chars_n_table<float> const binary32_to_chars_n_table = make_to_chars_n_table<float>();
+            to_chars_n_table<double> const binary64_to_chars_n_table = make_to_chars_n_table<double>();
+        }
+    }
+}
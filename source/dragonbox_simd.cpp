@@ -0,0 +1,311 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+
+#include "dragonbox/dragonbox_simd.h"
+
+#include <cstring>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+    #include <immintrin.h>
+    #define JKJ_HAS_AVX512_KERNEL 1
+    #define JKJ_AVX512_TARGET __attribute__((target("avx512f")))
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    #include <immintrin.h>
+    #include <intrin.h>
+    #define JKJ_HAS_AVX512_KERNEL 1
+    // MSVC allows AVX-512 intrinsics without any compiler flag.
+    #define JKJ_AVX512_TARGET
+#else
+    #define JKJ_HAS_AVX512_KERNEL 0
+#endif
+
+namespace jkj {
+    namespace dragonbox {
+        static_assert(std::is_same<binary32_decimal_fp, decltype(to_decimal(1.0f))>::value,
+                      "binary32_decimal_fp must be the return type of to_decimal");
+
+        namespace {
+#if JKJ_HAS_AVX512_KERNEL
+            bool cpu_supports_avx512f() noexcept {
+    #if defined(_MSC_VER) && !defined(__clang__)
+                int info[4];
+                __cpuid(info, 0);
+                if (info[0] < 7) {
+                    return false;
+                }
+                // The OS must save the ZMM registers; check OSXSAVE and then XCR0.
+                __cpuid(info, 1);
+                if ((info[2] & (1 << 27)) == 0) {
+                    return false;
+                }
+                if ((_xgetbv(0) & 0xe6) != 0xe6) {
+                    return false;
+                }
+                __cpuidex(info, 7, 0);
+                return (info[1] & (1 << 16)) != 0;
+    #else
+                return __builtin_cpu_supports("avx512f");
+    #endif
+            }
+
+            using format = ieee754_binary32;
+            using format_traits = ieee754_binary_traits<format, detail::stdr::uint_least32_t>;
+            using impl = detail::impl<format_traits>;
+            using cache_holder_type = cache_holder<format>;
+
+            // Lower 64-bits of the 96-bit product of the lower 32-bits of x and y.
+            JKJ_AVX512_TARGET inline __m512i umul96_lower64(__m512i x, __m512i y) noexcept {
+                auto const xyh = _mm512_mul_epu32(x, _mm512_srli_epi64(y, 32));
+                auto const xyl = _mm512_mul_epu32(x, y);
+                return _mm512_add_epi64(_mm512_slli_epi64(xyh, 32), xyl);
+            }
+
+            // Upper 64-bits of the 96-bit product of the lower 32-bits of x and y.
+            JKJ_AVX512_TARGET inline __m512i umul96_upper64(__m512i x, __m512i y) noexcept {
+                auto const xyh = _mm512_mul_epu32(x, _mm512_srli_epi64(y, 32));
+                auto const xyl = _mm512_mul_epu32(x, y);
+                return _mm512_add_epi64(xyh, _mm512_srli_epi64(xyl, 32));
+            }
+
+            // Lane-parallel version of multiplication_traits::compute_mul_parity.
+            JKJ_AVX512_TARGET inline void compute_mul_parity(__m512i two_f, __m512i cache,
+                                                             __m512i beta, __mmask8& parity,
+                                                             __mmask8& is_integer) noexcept {
+                auto const low32 = _mm512_set1_epi64(0xffffffff);
+                auto const r = umul96_lower64(two_f, cache);
+                parity = _mm512_test_epi64_mask(
+                    _mm512_srlv_epi64(r, _mm512_sub_epi64(_mm512_set1_epi64(64), beta)),
+                    _mm512_set1_epi64(1));
+                is_integer = _mm512_testn_epi64_mask(
+                    _mm512_srlv_epi64(r, _mm512_sub_epi64(_mm512_set1_epi64(32), beta)), low32);
+            }
+
+            // Lane-parallel version of remove_trailing_zeros_traits<remove_t, binary32>, applied
+            // only to the lanes in the mask.
+            JKJ_AVX512_TARGET inline void remove_trailing_zeros(__mmask8 mask, __m512i& significand,
+                                                                __m512i& exponent) noexcept {
+                auto const low32 = _mm512_set1_epi64(0xffffffff);
+
+                auto r = _mm512_and_si512(
+                    _mm512_ror_epi32(
+                        _mm512_mul_epu32(significand, _mm512_set1_epi64(UINT32_C(184254097))), 4),
+                    low32);
+                auto b = _mm512_mask_cmplt_epu64_mask(mask, r, _mm512_set1_epi64(UINT32_C(429497)));
+                significand = _mm512_mask_mov_epi64(significand, b, r);
+                exponent = _mm512_mask_add_epi64(exponent, b, exponent, _mm512_set1_epi64(4));
+
+                r = _mm512_and_si512(
+                    _mm512_ror_epi32(
+                        _mm512_mul_epu32(significand, _mm512_set1_epi64(UINT32_C(42949673))), 2),
+                    low32);
+                b = _mm512_mask_cmplt_epu64_mask(mask, r, _mm512_set1_epi64(UINT32_C(42949673)));
+                significand = _mm512_mask_mov_epi64(significand, b, r);
+                exponent = _mm512_mask_add_epi64(exponent, b, exponent, _mm512_set1_epi64(2));
+
+                r = _mm512_and_si512(
+                    _mm512_ror_epi32(
+                        _mm512_mul_epu32(significand, _mm512_set1_epi64(UINT32_C(1288490189))), 1),
+                    low32);
+                b = _mm512_mask_cmplt_epu64_mask(mask, r, _mm512_set1_epi64(UINT32_C(429496730)));
+                significand = _mm512_mask_mov_epi64(significand, b, r);
+                exponent = _mm512_mask_add_epi64(exponent, b, exponent, _mm512_set1_epi64(1));
+            }
+
+    #if defined(__GNUC__) && !defined(__clang__)
+            // GCC bug 105593: spurious -Wuninitialized from the intrinsics in avx512fintrin.h.
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wuninitialized"
+    #endif
+            // Converts 8 inputs, following impl::compute_nearest with the default policies step by
+            // step. Inputs falling into the shorter interval case are delegated to the scalar path.
+            JKJ_AVX512_TARGET void to_decimal_x8_avx512(float const* x,
+                                                         binary32_decimal_fp* results) noexcept {
+                static_assert(impl::kappa == 1, "");
+                static_assert(format::significand_bits == 23 && format::exponent_bits == 8, "");
+
+                auto const zero = _mm512_setzero_si512();
+                auto const one = _mm512_set1_epi64(1);
+                auto const low32 = _mm512_set1_epi64(0xffffffff);
+
+                auto const bits =
+                    _mm512_cvtepu32_epi64(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(x)));
+                auto const exponent_bits =
+                    _mm512_and_si512(_mm512_srli_epi64(bits, format::significand_bits),
+                                     _mm512_set1_epi64((1 << format::exponent_bits) - 1));
+                auto const significand_bits = _mm512_and_si512(
+                    bits, _mm512_set1_epi64((UINT32_C(1) << format::significand_bits) - 1));
+                auto const is_normal = _mm512_test_epi64_mask(exponent_bits, exponent_bits);
+                auto const is_shorter_interval =
+                    _mm512_mask_testn_epi64_mask(is_normal, significand_bits, significand_bits);
+                // nearest_to_even: the interval is closed if and only if the significand is even.
+                auto const include_endpoints = _mm512_testn_epi64_mask(bits, one);
+
+                auto two_fc = _mm512_slli_epi64(significand_bits, 1);
+                two_fc = _mm512_mask_or_epi64(
+                    two_fc, is_normal, two_fc,
+                    _mm512_set1_epi64(UINT64_C(1) << (format::significand_bits + 1)));
+                auto const binary_exponent = _mm512_mask_add_epi64(
+                    _mm512_set1_epi64(format::min_exponent - format::significand_bits), is_normal,
+                    exponent_bits,
+                    _mm512_set1_epi64(format::exponent_bias - format::significand_bits));
+
+                //////////////////////////////////////////////////////////////////////
+                // Step 1: Schubfach multiplier calculation.
+                //////////////////////////////////////////////////////////////////////
+
+                // floor_log10_pow2 and floor_log2_pow10 with the same magic numbers as detail::log.
+                auto const minus_k = _mm512_sub_epi64(
+                    _mm512_srai_epi64(
+                        _mm512_mul_epi32(binary_exponent, _mm512_set1_epi64(INT64_C(315653))), 20),
+                    _mm512_set1_epi64(impl::kappa));
+                auto const k = _mm512_sub_epi64(zero, minus_k);
+                auto const cache = _mm512_i64gather_epi64(
+                    _mm512_sub_epi64(k, _mm512_set1_epi64(cache_holder_type::min_k)),
+                    cache_holder_type::cache.data_, 8);
+                auto const beta = _mm512_add_epi64(
+                    binary_exponent,
+                    _mm512_srai_epi64(_mm512_mul_epi32(k, _mm512_set1_epi64(INT64_C(1741647))), 19));
+
+                auto const deltai =
+                    _mm512_srlv_epi64(cache, _mm512_sub_epi64(_mm512_set1_epi64(63), beta));
+                auto const z = umul96_upper64(
+                    _mm512_and_si512(_mm512_sllv_epi64(_mm512_or_si512(two_fc, one), beta), low32),
+                    cache);
+                auto const zi = _mm512_srli_epi64(z, 32);
+                auto const z_is_integer = _mm512_testn_epi64_mask(z, low32);
+
+                //////////////////////////////////////////////////////////////////////
+                // Step 2: Try larger divisor; remove trailing zeros if necessary.
+                //////////////////////////////////////////////////////////////////////
+
+                auto const big_divisor = _mm512_set1_epi64(100);
+                auto decimal_significand = _mm512_srli_epi64(
+                    _mm512_mul_epu32(zi, _mm512_set1_epi64(UINT32_C(1374389535))), 37);
+                auto r = _mm512_sub_epi64(zi, _mm512_mul_epu32(decimal_significand, big_divisor));
+
+                auto const r_less = _mm512_cmplt_epu64_mask(r, deltai);
+                auto const r_equal = _mm512_cmpeq_epu64_mask(r, deltai);
+
+                // Exclude the right endpoint if necessary.
+                auto const exclude_right_endpoint = r_less & _mm512_testn_epi64_mask(r, r) &
+                                                    z_is_integer & __mmask8(~include_endpoints);
+                decimal_significand = _mm512_mask_sub_epi64(
+                    decimal_significand, exclude_right_endpoint, decimal_significand, one);
+                r = _mm512_mask_mov_epi64(r, exclude_right_endpoint, big_divisor);
+
+                // r == deltai; compare fractional parts.
+                __mmask8 x_parity, x_is_integer;
+                compute_mul_parity(_mm512_sub_epi64(two_fc, one), cache, beta, x_parity,
+                                   x_is_integer);
+                auto const left_endpoint_excluded =
+                    r_equal & __mmask8(~(x_parity | (x_is_integer & include_endpoints)));
+
+                auto const use_small_divisor =
+                    __mmask8(~(r_less | r_equal)) | exclude_right_endpoint | left_endpoint_excluded;
+
+                auto exponent = _mm512_add_epi64(minus_k, _mm512_set1_epi64(impl::kappa + 1));
+                remove_trailing_zeros(__mmask8(~use_small_divisor), decimal_significand, exponent);
+
+                //////////////////////////////////////////////////////////////////////
+                // Step 3: Find the significand with the smaller divisor.
+                //////////////////////////////////////////////////////////////////////
+
+                auto const small_decimal_significand =
+                    _mm512_mul_epu32(decimal_significand, _mm512_set1_epi64(10));
+                exponent = _mm512_mask_sub_epi64(exponent, use_small_divisor, exponent, one);
+
+                auto dist = _mm512_add_epi64(_mm512_sub_epi64(r, _mm512_srli_epi64(deltai, 1)),
+                                             _mm512_set1_epi64(5));
+                auto const approx_y_parity =
+                    _mm512_test_epi64_mask(_mm512_xor_si512(dist, _mm512_set1_epi64(5)), one);
+
+                // check_divisibility_and_divide_by_pow10<1>.
+                auto const prod = _mm512_mul_epu32(dist, _mm512_set1_epi64(6554));
+                auto const divisible_by_small_divisor = _mm512_cmplt_epu64_mask(
+                    _mm512_and_si512(prod, _mm512_set1_epi64(0xffff)), _mm512_set1_epi64(6554));
+                dist = _mm512_srli_epi64(prod, 16);
+
+                auto small_result = _mm512_add_epi64(small_decimal_significand, dist);
+
+                __mmask8 y_parity, y_is_integer;
+                compute_mul_parity(two_fc, cache, beta, y_parity, y_is_integer);
+                // binary_to_decimal_rounding::to_even prefers rounding down for odd significands.
+                auto const prefer_round_down = _mm512_test_epi64_mask(small_result, one);
+                auto const round_down =
+                    divisible_by_small_divisor &
+                    __mmask8((y_parity ^ approx_y_parity) | (prefer_round_down & y_is_integer));
+                small_result = _mm512_mask_sub_epi64(small_result, round_down, small_result, one);
+
+                decimal_significand =
+                    _mm512_mask_mov_epi64(decimal_significand, use_small_divisor, small_result);
+
+                alignas(32) detail::stdr::uint_least32_t significands[8];
+                alignas(32) detail::stdr::int_least32_t exponents[8];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(significands),
+                                   _mm512_cvtepi64_epi32(decimal_significand));
+                _mm256_store_si256(reinterpret_cast<__m256i*>(exponents),
+                                   _mm512_cvtepi64_epi32(exponent));
+                auto const is_negative =
+                    _mm512_test_epi64_mask(bits, _mm512_set1_epi64(UINT32_C(0x80000000)));
+
+                for (int i = 0; i < 8; ++i) {
+                    if ((is_shorter_interval >> i) & 1) {
+                        results[i] = to_decimal(x[i]);
+                    }
+                    else {
+                        results[i].significand = significands[i];
+                        results[i].exponent = exponents[i];
+                        results[i].is_negative = ((is_negative >> i) & 1) != 0;
+                    }
+                }
+            }
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic pop
+    #endif
+#endif
+        }
+
+        bool to_decimal_n_uses_avx512() noexcept {
+#if JKJ_HAS_AVX512_KERNEL
+            static bool const result = cpu_supports_avx512f();
+            return result;
+#else
+            return false;
+#endif
+        }
+
+        void to_decimal_n(float const* x, binary32_decimal_fp* results,
+                          detail::stdr::size_t count) noexcept {
+            detail::stdr::size_t i = 0;
+#if JKJ_HAS_AVX512_KERNEL
+            if (to_decimal_n_uses_avx512()) {
+                for (; i + 8 <= count; i += 8) {
+                    to_decimal_x8_avx512(x + i, results + i);
+                }
+            }
+#endif
+            for (; i < count; ++i) {
+                results[i] = to_decimal(x[i]);
+            }
+        }
+    }
+}
+
+#undef JKJ_AVX512_TARGET
+#undef JKJ_HAS_AVX512_KERNEL
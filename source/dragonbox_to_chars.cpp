@@ -53,7 +53,10 @@ namespace jkj {
             // These "//"'s are to prevent clang-format to ruin this nice alignment.
             // Thanks to reddit user u/mcmcc:
             // https://www.reddit.com/r/cpp/comments/so3wx9/dragonbox_110_is_released_a_fast_floattostring/hw8z26r/?context=3
-            static constexpr char radix_100_table[200] JKJ_STATIC_DATA_SECTION = {
+            // The tables are instantiated for each output character type, so that the digits are
+            // copied into a buffer of wchar_t, char16_t or char32_t without a widening pass.
+            template <class CharT>
+            static constexpr CharT radix_100_table[200] JKJ_STATIC_DATA_SECTION = {
                 '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', //
                 '0', '5', '0', '6', '0', '7', '0', '8', '0', '9', //
                 '1', '0', '1', '1', '1', '2', '1', '3', '1', '4', //
@@ -75,7 +78,8 @@ namespace jkj {
                 '9', '0', '9', '1', '9', '2', '9', '3', '9', '4', //
                 '9', '5', '9', '6', '9', '7', '9', '8', '9', '9'  //
             };
-            static constexpr char radix_100_head_table[200] JKJ_STATIC_DATA_SECTION = {
+            template <class CharT>
+            static constexpr CharT radix_100_head_table[200] JKJ_STATIC_DATA_SECTION = {
                 '0', '.', '1', '.', '2', '.', '3', '.', '4', '.', //
                 '5', '.', '6', '.', '7', '.', '8', '.', '9', '.', //
                 '1', '.', '1', '.', '1', '.', '1', '.', '1', '.', //
@@ -98,15 +102,23 @@ namespace jkj {
                 '9', '.', '9', '.', '9', '.', '9', '.', '9', '.'  //
             };
 
-            static void print_1_digit(int n, char* buffer) noexcept {
-                JKJ_IF_CONSTEXPR(('0' & 0xf) == 0) { *buffer = char('0' | n); }
+            template <class CharT>
+            static void print_1_digit(int n, CharT* buffer) noexcept {
+                JKJ_IF_CONSTEXPR(('0' & 0xf) == 0) { *buffer = CharT('0' | n); }
                 else {
-                    *buffer = char('0' + n);
+                    *buffer = CharT('0' + n);
                 }
             }
 
-            static void print_2_digits(int n, char* buffer) noexcept {
-                stdr::memcpy(buffer, radix_100_table + n * 2, 2);
+            template <class CharT>
+            static void print_2_digits(int n, CharT* buffer) noexcept {
+                stdr::memcpy(buffer, radix_100_table<CharT> + n * 2, 2 * sizeof(CharT));
+            }
+
+            // Prints the leading digit of n followed by '.', or just n if n is of 1 digit.
+            template <class CharT>
+            static void print_head_digits(int n, CharT* buffer) noexcept {
+                stdr::memcpy(buffer, radix_100_head_table<CharT> + n * 2, 2 * sizeof(CharT));
             }
 
             // These digit generation routines are inspired by James Anhalt's itoa algorithm:
@@ -120,8 +132,9 @@ namespace jkj {
             // floor(10^2 * ((10^4 * y) mod 2^32) / 2^32) = 67.
             // See https://jk-jeon.github.io/posts/2022/02/jeaiii-algorithm/ for more explanation.
 
+            template <class CharT>
             JKJ_FORCEINLINE static void print_9_digits(stdr::uint_least32_t s32, int& exponent,
-                                                       char*& buffer) noexcept {
+                                                       CharT*& buffer) noexcept {
                 // -- IEEE-754 binary32
                 // Since we do not cut trailing zeros in advance, s32 must be of 6~9 digits
                 // unless the original input was subnormal.
@@ -134,7 +147,7 @@ namespace jkj {
                     // 1441151882 = ceil(2^57 / 1'0000'0000) + 1
                     auto prod = s32 * UINT64_C(1441151882);
                     prod >>= 25;
-                    stdr::memcpy(buffer, radix_100_head_table + int(prod >> 32) * 2, 2);
+                    print_head_digits(int(prod >> 32), buffer);
 
                     prod = (prod & UINT32_C(0xffffffff)) * 100;
                     print_2_digits(int(prod >> 32), buffer + 2);
@@ -159,9 +172,9 @@ namespace jkj {
                     exponent += (6 + int(head_digits >= 10));
 
                     // Write the first digit and the decimal point.
-                    stdr::memcpy(buffer, radix_100_head_table + head_digits * 2, 2);
+                    print_head_digits(head_digits, buffer);
                     // This third character may be overwritten later but we don't care.
-                    buffer[2] = radix_100_table[head_digits * 2 + 1];
+                    buffer[2] = radix_100_table<CharT>[head_digits * 2 + 1];
 
                     // Remaining 6 digits are all zero?
                     if ((prod & UINT32_C(0xffffffff)) <=
@@ -221,9 +234,9 @@ namespace jkj {
                     exponent += (4 + int(head_digits >= 10));
 
                     // Write the first digit and the decimal point.
-                    stdr::memcpy(buffer, radix_100_head_table + head_digits * 2, 2);
+                    print_head_digits(head_digits, buffer);
                     // This third character may be overwritten later but we don't care.
-                    buffer[2] = radix_100_table[head_digits * 2 + 1];
+                    buffer[2] = radix_100_table<CharT>[head_digits * 2 + 1];
 
                     // Remaining 4 digits are all zero?
                     if ((prod & UINT32_C(0xffffffff)) <=
@@ -266,9 +279,9 @@ namespace jkj {
                     exponent += (2 + int(head_digits >= 10));
 
                     // Write the first digit and the decimal point.
-                    stdr::memcpy(buffer, radix_100_head_table + head_digits * 2, 2);
+                    print_head_digits(head_digits, buffer);
                     // This third character may be overwritten later but we don't care.
-                    buffer[2] = radix_100_table[head_digits * 2 + 1];
+                    buffer[2] = radix_100_table<CharT>[head_digits * 2 + 1];
 
                     // Remaining 2 digits are all zero?
                     if ((prod & UINT32_C(0xffffffff)) <=
@@ -295,9 +308,9 @@ namespace jkj {
                     exponent += int(s32 >= 10);
 
                     // Write the first digit and the decimal point.
-                    stdr::memcpy(buffer, radix_100_head_table + s32 * 2, 2);
+                    print_head_digits(int(s32), buffer);
                     // This third character may be overwritten later but we don't care.
-                    buffer[2] = radix_100_table[s32 * 2 + 1];
+                    buffer[2] = radix_100_table<CharT>[s32 * 2 + 1];
 
                     // The number of characters actually written is 1 or 3, similarly to the case of
                     // 7 or 8 digits.
@@ -305,16 +318,16 @@ namespace jkj {
                 }
             }
 
-            template <>
-            char* to_chars<ieee754_binary32, stdr::uint_least32_t>(stdr::uint_least32_t s32,
-                                                                   int exponent,
-                                                                   char* buffer) noexcept {
+            template <class CharT>
+            static CharT* to_chars_binary32(stdr::uint_least32_t s32, int exponent,
+                                            CharT* buffer) noexcept {
                 // Print significand.
                 print_9_digits(s32, exponent, buffer);
 
                 // Print exponent and return
                 if (exponent < 0) {
-                    stdr::memcpy(buffer, "E-", 2);
+                    buffer[0] = 'E';
+                    buffer[1] = '-';
                     buffer += 2;
                     exponent = -exponent;
                 }
@@ -335,10 +348,9 @@ namespace jkj {
                 return buffer;
             }
 
-            template <>
-            char*
-            to_chars<ieee754_binary64, stdr::uint_least64_t>(stdr::uint_least64_t const significand,
-                                                             int exponent, char* buffer) noexcept {
+            template <class CharT>
+            static CharT* to_chars_binary64(stdr::uint_least64_t const significand, int exponent,
+                                            CharT* buffer) noexcept {
                 // Print significand by decomposing it into a 9-digit block and a 8-digit block.
                 stdr::uint_least32_t first_block, second_block;
                 bool no_second_block;
@@ -367,7 +379,7 @@ namespace jkj {
                         // 1441151882 = ceil(2^57 / 1'0000'0000) + 1
                         auto prod = first_block * UINT64_C(1441151882);
                         prod >>= 25;
-                        stdr::memcpy(buffer, radix_100_head_table + int(prod >> 32) * 2, 2);
+                        print_head_digits(int(prod >> 32), buffer);
                         prod = (prod & UINT32_C(0xffffffff)) * 100;
                         print_2_digits(int(prod >> 32), buffer + 2);
                         prod = (prod & UINT32_C(0xffffffff)) * 100;
@@ -401,8 +413,8 @@ namespace jkj {
                             prod >>= 16;
                             auto const head_digits = int(prod >> 32);
 
-                            stdr::memcpy(buffer, radix_100_head_table + head_digits * 2, 2);
-                            buffer[2] = radix_100_table[head_digits * 2 + 1];
+                            print_head_digits(head_digits, buffer);
+                            buffer[2] = radix_100_table<CharT>[head_digits * 2 + 1];
 
                             exponent += (6 + int(head_digits >= 10));
                             buffer += int(head_digits >= 10);
@@ -423,8 +435,8 @@ namespace jkj {
                             auto prod = first_block * UINT64_C(429497);
                             auto const head_digits = int(prod >> 32);
 
-                            stdr::memcpy(buffer, radix_100_head_table + head_digits * 2, 2);
-                            buffer[2] = radix_100_table[head_digits * 2 + 1];
+                            print_head_digits(head_digits, buffer);
+                            buffer[2] = radix_100_table<CharT>[head_digits * 2 + 1];
 
                             exponent += (4 + int(head_digits >= 10));
                             buffer += int(head_digits >= 10);
@@ -443,8 +455,8 @@ namespace jkj {
                             auto prod = first_block * UINT64_C(42949673);
                             auto const head_digits = int(prod >> 32);
 
-                            stdr::memcpy(buffer, radix_100_head_table + head_digits * 2, 2);
-                            buffer[2] = radix_100_table[head_digits * 2 + 1];
+                            print_head_digits(head_digits, buffer);
+                            buffer[2] = radix_100_table<CharT>[head_digits * 2 + 1];
 
                             exponent += (2 + int(head_digits >= 10));
                             buffer += int(head_digits >= 10);
@@ -457,8 +469,8 @@ namespace jkj {
                         }
                         else {
                             // 1 or 2 digits.
-                            stdr::memcpy(buffer, radix_100_head_table + first_block * 2, 2);
-                            buffer[2] = radix_100_table[first_block * 2 + 1];
+                            print_head_digits(int(first_block), buffer);
+                            buffer[2] = radix_100_table<CharT>[first_block * 2 + 1];
 
                             exponent += int(first_block >= 10);
                             buffer += (2 + int(first_block >= 10));
@@ -510,7 +522,8 @@ namespace jkj {
 
                 // Print exponent and return
                 if (exponent < 0) {
-                    stdr::memcpy(buffer, "E-", 2);
+                    buffer[0] = 'E';
+                    buffer[1] = '-';
                     buffer += 2;
                     exponent = -exponent;
                 }
@@ -541,6 +554,55 @@ namespace jkj {
 
                 return buffer;
             }
+
+            template <>
+            char* to_chars<ieee754_binary32, stdr::uint_least32_t, char>(stdr::uint_least32_t s32,
+                                                                         int exponent,
+                                                                         char* buffer) noexcept {
+                return to_chars_binary32(s32, exponent, buffer);
+            }
+            template <>
+            wchar_t*
+            to_chars<ieee754_binary32, stdr::uint_least32_t, wchar_t>(stdr::uint_least32_t s32,
+                                                                      int exponent,
+                                                                      wchar_t* buffer) noexcept {
+                return to_chars_binary32(s32, exponent, buffer);
+            }
+            template <>
+            char16_t*
+            to_chars<ieee754_binary32, stdr::uint_least32_t, char16_t>(stdr::uint_least32_t s32,
+                                                                       int exponent,
+                                                                       char16_t* buffer) noexcept {
+                return to_chars_binary32(s32, exponent, buffer);
+            }
+            template <>
+            char32_t*
+            to_chars<ieee754_binary32, stdr::uint_least32_t, char32_t>(stdr::uint_least32_t s32,
+                                                                       int exponent,
+                                                                       char32_t* buffer) noexcept {
+                return to_chars_binary32(s32, exponent, buffer);
+            }
+
+            template <>
+            char* to_chars<ieee754_binary64, stdr::uint_least64_t, char>(
+                stdr::uint_least64_t significand, int exponent, char* buffer) noexcept {
+                return to_chars_binary64(significand, exponent, buffer);
+            }
+            template <>
+            wchar_t* to_chars<ieee754_binary64, stdr::uint_least64_t, wchar_t>(
+                stdr::uint_least64_t significand, int exponent, wchar_t* buffer) noexcept {
+                return to_chars_binary64(significand, exponent, buffer);
+            }
+            template <>
+            char16_t* to_chars<ieee754_binary64, stdr::uint_least64_t, char16_t>(
+                stdr::uint_least64_t significand, int exponent, char16_t* buffer) noexcept {
+                return to_chars_binary64(significand, exponent, buffer);
+            }
+            template <>
+            char32_t* to_chars<ieee754_binary64, stdr::uint_least64_t, char32_t>(
+                stdr::uint_least64_t significand, int exponent, char32_t* buffer) noexcept {
+                return to_chars_binary64(significand, exponent, buffer);
+            }
         }
     }
 }
@@ -0,0 +1,394 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_ALP_CODEC
+#define JKJ_HEADER_ALP_CODEC
+
+#include "dragonbox/dragonbox.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Lossless columnar compression of binary64 data in the style of ALP (Adaptive Lossless
+// floating-Point compression, Afroozeh et al., SIGMOD 2024).
+//
+// Data is split into blocks of block_size values. For each block, a common decimal exponent e is
+// chosen, and each value x is encoded as the integer d with x == d / 10^e (or d * 10^-e if e is
+// negative). The integers are stored relative to their minimum (frame of reference) and bit-packed
+// with the smallest width that fits. Values that cannot be encoded this way (NaN's, infinities,
+// -0, and values needing too many digits) are stored verbatim as exceptions. A block for which
+// this costs more than the raw data is stored raw, marked by a bit width of 64.
+//
+// Unlike the original ALP, which tries candidate exponents by multiplying and checking the round
+// trip, whether x can be encoded with e is decided from to_decimal(x) = s * 10^k: it can be if and
+// only if d = s * 10^(k + e) is an integer of at most 53 bits. In that case, since both d and 10^e
+// are exactly representable, the correctly rounded quotient d / 10^e is the correctly rounded
+// value of s * 10^k, which is x by the roundtrip guarantee of Dragonbox. Therefore, decoding is a
+// single division (or multiplication) by an exact power of 10 per value, which compilers
+// vectorize, and no trial decoding is needed when encoding.
+//
+// Stream layout (native byte order):
+//   uint64 number of values
+//   for each block:
+//     uint16 number of values, int8 exponent, uint8 bit width, uint16 number of exceptions,
+//     uint16 (reserved), int64 frame of reference,
+//     uint64[] bit-packed integers,
+//     uint16[] positions of the exceptions, uint64[] bit patterns of the exceptions.
+
+namespace jkj {
+    namespace alp {
+        constexpr std::size_t block_size = 1024;
+        constexpr int min_exponent = -22;
+        constexpr int max_exponent = 22;
+
+        namespace detail {
+            struct block_header {
+                std::uint16_t count;
+                std::int8_t exponent;
+                std::uint8_t bit_width;
+                std::uint16_t exception_count;
+                std::uint16_t reserved;
+                std::int64_t frame_of_reference;
+            };
+            static_assert(sizeof(block_header) == 16, "");
+
+            // 10^0, ... , 10^22 are exactly representable.
+            inline double exact_pow10(int e) noexcept {
+                constexpr double table[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                            1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                            1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+                return table[e];
+            }
+
+            // 10^16 already exceeds 2^53.
+            inline std::uint64_t pow10_uint(int e) noexcept {
+                constexpr std::uint64_t table[] = {1ull,
+                                                   10ull,
+                                                   100ull,
+                                                   1000ull,
+                                                   10000ull,
+                                                   100000ull,
+                                                   1000000ull,
+                                                   10000000ull,
+                                                   100000000ull,
+                                                   1000000000ull,
+                                                   10000000000ull,
+                                                   100000000000ull,
+                                                   1000000000000ull,
+                                                   10000000000000ull,
+                                                   100000000000000ull,
+                                                   1000000000000000ull};
+                return table[e];
+            }
+
+            constexpr std::uint64_t max_integer = std::uint64_t(1) << 53;
+            constexpr std::uint8_t raw_bit_width = 64;
+
+            // Shortest decimal representation of each value.
+            struct decimal_digits {
+                std::uint64_t significand;
+                int exponent;
+                bool is_negative;
+                bool is_encodable; // finite and not -0
+            };
+
+            inline decimal_digits analyze(double x) noexcept {
+                if (!std::isfinite(x)) {
+                    return {0, 0, false, false};
+                }
+                if (x == 0) {
+                    // -0 can't be recovered from the integer 0.
+                    return {0, 0, false, !std::signbit(x)};
+                }
+                auto const r = jkj::dragonbox::to_decimal(x);
+                return {r.significand, r.exponent, r.is_negative, true};
+            }
+
+            // Computes d = s * 10^(k + e); returns false if it is not an integer of at most 53 bits.
+            inline bool encode(decimal_digits const& v, int e, std::int64_t& d) noexcept {
+                if (!v.is_encodable) {
+                    return false;
+                }
+                if (v.significand == 0) {
+                    d = 0;
+                    return true;
+                }
+                auto const shift = v.exponent + e;
+                if (shift < 0 || shift > 15) {
+                    return false;
+                }
+                auto const p = pow10_uint(shift);
+                if (v.significand > max_integer / p) {
+                    return false;
+                }
+                auto const magnitude = v.significand * p;
+                if (magnitude > max_integer) {
+                    return false;
+                }
+                d = v.is_negative ? -std::int64_t(magnitude) : std::int64_t(magnitude);
+                return true;
+            }
+
+            inline int bit_width(std::uint64_t n) noexcept {
+                int width = 0;
+                while (n != 0) {
+                    n >>= 1;
+                    ++width;
+                }
+                return width;
+            }
+
+            struct block_plan {
+                int exponent;
+                int bit_width;
+                std::size_t exception_count;
+                std::int64_t frame_of_reference;
+                std::size_t cost_in_bits;
+            };
+
+            inline block_plan evaluate(decimal_digits const* values, std::size_t count,
+                                       int e) noexcept {
+                block_plan plan{e, 0, 0, 0, 0};
+                std::int64_t min_value = 0, max_value = 0;
+                bool first = true;
+                for (std::size_t i = 0; i < count; ++i) {
+                    std::int64_t d;
+                    if (!encode(values[i], e, d)) {
+                        ++plan.exception_count;
+                        continue;
+                    }
+                    if (first || d < min_value) {
+                        min_value = d;
+                    }
+                    if (first || d > max_value) {
+                        max_value = d;
+                    }
+                    first = false;
+                }
+                plan.frame_of_reference = min_value;
+                plan.bit_width = bit_width(std::uint64_t(max_value - min_value));
+                plan.cost_in_bits = count * std::size_t(plan.bit_width) +
+                                    plan.exception_count * (16 + 64);
+                return plan;
+            }
+
+            // The exponent that makes x an integer is -k (after removing trailing zeros). Try
+            // each such exponent appearing in the block, and pick the cheapest one.
+            inline block_plan choose_plan(decimal_digits const* values, std::size_t count) noexcept {
+                bool candidates[max_exponent - min_exponent + 1] = {};
+                for (std::size_t i = 0; i < count; ++i) {
+                    if (values[i].is_encodable && values[i].significand != 0) {
+                        auto const e = -values[i].exponent;
+                        if (e >= min_exponent && e <= max_exponent) {
+                            candidates[e - min_exponent] = true;
+                        }
+                    }
+                }
+
+                auto best = evaluate(values, count, 0);
+                for (int e = min_exponent; e <= max_exponent; ++e) {
+                    if (candidates[e - min_exponent] && e != 0) {
+                        auto const plan = evaluate(values, count, e);
+                        if (plan.cost_in_bits < best.cost_in_bits) {
+                            best = plan;
+                        }
+                    }
+                }
+                return best;
+            }
+
+            inline std::size_t packed_words(std::size_t count, int bit_width) noexcept {
+                return (count * std::size_t(bit_width) + 63) / 64;
+            }
+
+            template <class T>
+            void write(unsigned char*& ptr, T const& value) noexcept {
+                std::memcpy(ptr, &value, sizeof(T));
+                ptr += sizeof(T);
+            }
+
+            template <class T>
+            T read(unsigned char const*& ptr) noexcept {
+                T value;
+                std::memcpy(&value, ptr, sizeof(T));
+                ptr += sizeof(T);
+                return value;
+            }
+        }
+
+        // An upper bound on the size of the output of compress.
+        constexpr std::size_t max_compressed_size(std::size_t count) noexcept {
+            // Blocks are never larger than the raw data plus the header.
+            return sizeof(std::uint64_t) +
+                   (count + block_size - 1) / block_size * sizeof(detail::block_header) +
+                   count * sizeof(double);
+        }
+
+        // Compresses count values into output, which must have at least max_compressed_size(count)
+        // bytes. Returns the number of bytes written.
+        inline std::size_t compress(double const* input, std::size_t count,
+                                    unsigned char* output) noexcept {
+            auto ptr = output;
+            detail::write(ptr, std::uint64_t(count));
+
+            detail::decimal_digits values[block_size];
+            std::uint64_t offsets[block_size];
+            std::uint64_t words[block_size];
+            std::uint16_t exception_positions[block_size];
+            for (std::size_t block_start = 0; block_start < count; block_start += block_size) {
+                auto const n = count - block_start < block_size ? count - block_start : block_size;
+                for (std::size_t i = 0; i < n; ++i) {
+                    values[i] = detail::analyze(input[block_start + i]);
+                }
+                auto const plan = detail::choose_plan(values, n);
+
+                if (plan.cost_in_bits >= n * 64) {
+                    detail::block_header header{std::uint16_t(n), 0, detail::raw_bit_width, 0, 0, 0};
+                    detail::write(ptr, header);
+                    std::memcpy(ptr, input + block_start, n * sizeof(double));
+                    ptr += n * sizeof(double);
+                    continue;
+                }
+
+                detail::block_header header{std::uint16_t(n), std::int8_t(plan.exponent),
+                                            std::uint8_t(plan.bit_width),
+                                            std::uint16_t(plan.exception_count), 0,
+                                            plan.frame_of_reference};
+                detail::write(ptr, header);
+
+                // Bit-pack the offsets from the frame of reference; exceptions are packed as 0.
+                std::size_t number_of_exceptions = 0;
+                for (std::size_t i = 0; i < n; ++i) {
+                    std::int64_t d;
+                    if (detail::encode(values[i], plan.exponent, d)) {
+                        offsets[i] = std::uint64_t(d - plan.frame_of_reference);
+                    }
+                    else {
+                        offsets[i] = 0;
+                        exception_positions[number_of_exceptions++] = std::uint16_t(i);
+                    }
+                }
+
+                auto const number_of_words = detail::packed_words(n, plan.bit_width);
+                std::memset(words, 0, number_of_words * sizeof(std::uint64_t));
+                if (plan.bit_width != 0) {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        auto const bit_position = i * std::size_t(plan.bit_width);
+                        auto const word = bit_position / 64;
+                        auto const shift = int(bit_position % 64);
+                        words[word] |= offsets[i] << shift;
+                        if (shift + plan.bit_width > 64) {
+                            words[word + 1] |= offsets[i] >> (64 - shift);
+                        }
+                    }
+                }
+                std::memcpy(ptr, words, number_of_words * sizeof(std::uint64_t));
+                ptr += number_of_words * sizeof(std::uint64_t);
+
+                // Exceptions.
+                std::memcpy(ptr, exception_positions, number_of_exceptions * sizeof(std::uint16_t));
+                ptr += number_of_exceptions * sizeof(std::uint16_t);
+                for (std::size_t i = 0; i < number_of_exceptions; ++i) {
+                    std::memcpy(ptr, &input[block_start + exception_positions[i]], sizeof(double));
+                    ptr += sizeof(double);
+                }
+            }
+            return std::size_t(ptr - output);
+        }
+
+        // Returns the number of values stored in the compressed stream.
+        inline std::size_t decompressed_count(unsigned char const* input) noexcept {
+            return std::size_t(detail::read<std::uint64_t>(input));
+        }
+
+        // Decompresses the stream into output, which must have room for decompressed_count(input)
+        // values. Returns the number of bytes consumed.
+        inline std::size_t decompress(unsigned char const* input, double* output) noexcept {
+            auto ptr = input;
+            auto const count = std::size_t(detail::read<std::uint64_t>(ptr));
+
+            std::int64_t integers[block_size];
+            for (std::size_t block_start = 0; block_start < count; block_start += block_size) {
+                auto const header = detail::read<detail::block_header>(ptr);
+                std::size_t const n = header.count;
+                int const bit_width = header.bit_width;
+                auto const out = output + block_start;
+
+                if (bit_width == detail::raw_bit_width) {
+                    std::memcpy(out, ptr, n * sizeof(double));
+                    ptr += n * sizeof(double);
+                    continue;
+                }
+
+                // Unpack.
+                auto const number_of_words = detail::packed_words(n, bit_width);
+                auto const words = ptr;
+                ptr += number_of_words * sizeof(std::uint64_t);
+                if (bit_width == 0) {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        integers[i] = header.frame_of_reference;
+                    }
+                }
+                else {
+                    auto const mask = (std::uint64_t(1) << bit_width) - 1;
+                    for (std::size_t i = 0; i < n; ++i) {
+                        auto const bit_position = i * std::size_t(bit_width);
+                        auto const word = bit_position / 64;
+                        auto const shift = int(bit_position % 64);
+                        std::uint64_t low, high = 0;
+                        std::memcpy(&low, words + word * sizeof(std::uint64_t), sizeof(low));
+                        if (shift + bit_width > 64) {
+                            std::memcpy(&high, words + (word + 1) * sizeof(std::uint64_t),
+                                        sizeof(high));
+                        }
+                        auto const offset =
+                            ((low >> shift) | (shift == 0 ? 0 : high << (64 - shift))) & mask;
+                        integers[i] = std::int64_t(std::uint64_t(header.frame_of_reference) + offset);
+                    }
+                }
+
+                // Scale by the exact power of 10; this loop is vectorized.
+                if (header.exponent >= 0) {
+                    auto const divisor = detail::exact_pow10(header.exponent);
+                    for (std::size_t i = 0; i < n; ++i) {
+                        out[i] = double(integers[i]) / divisor;
+                    }
+                }
+                else {
+                    auto const multiplier = detail::exact_pow10(-header.exponent);
+                    for (std::size_t i = 0; i < n; ++i) {
+                        out[i] = double(integers[i]) * multiplier;
+                    }
+                }
+
+                // Patch exceptions.
+                auto positions = ptr;
+                auto bit_patterns = ptr + header.exception_count * sizeof(std::uint16_t);
+                for (std::size_t i = 0; i < header.exception_count; ++i) {
+                    auto const position = detail::read<std::uint16_t>(positions);
+                    std::memcpy(&out[position], bit_patterns, sizeof(double));
+                    bit_patterns += sizeof(std::uint64_t);
+                }
+                ptr = bit_patterns;
+            }
+            return std::size_t(ptr - input);
+        }
+    }
+}
+
+#endif
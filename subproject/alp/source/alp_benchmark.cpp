@@ -0,0 +1,280 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Compares the ALP codec against a plain memcpy and against XOR encoding (as in Gorilla, Pelkonen
+// et al., VLDB 2015) on a few synthetic columns. Reports compression ratio and the throughput of
+// compression and decompression, measured in GB/s of uncompressed data.
+//
+// Usage: alp_benchmark [number of values]
+
+#include "alp_codec.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    // XOR encoding: each value is XOR'ed with the previous one. A zero result takes 1 bit. Otherwise,
+    // the meaningful bits are stored either within the window of the previous result (2 bits of
+    // control), or together with a new window (2 + 5 + 6 bits of control).
+    class bit_writer {
+    public:
+        explicit bit_writer(std::uint64_t* words) : words_{words} {}
+
+        void write(std::uint64_t value, int bits) noexcept {
+            if (bits == 0) {
+                return;
+            }
+            if (bits < 64) {
+                value &= (std::uint64_t(1) << bits) - 1;
+            }
+            buffer_ |= value << filled_;
+            if (filled_ + bits >= 64) {
+                *words_++ = buffer_;
+                buffer_ = filled_ == 0 ? 0 : value >> (64 - filled_);
+                filled_ = filled_ + bits - 64;
+            }
+            else {
+                filled_ += bits;
+            }
+        }
+
+        std::uint64_t* finish() noexcept {
+            if (filled_ != 0) {
+                *words_++ = buffer_;
+            }
+            return words_;
+        }
+
+    private:
+        std::uint64_t* words_;
+        std::uint64_t buffer_ = 0;
+        int filled_ = 0;
+    };
+
+    class bit_reader {
+    public:
+        explicit bit_reader(std::uint64_t const* words) : words_{words} {}
+
+        std::uint64_t read(int bits) noexcept {
+            if (bits == 0) {
+                return 0;
+            }
+            std::uint64_t value = words_[0] >> position_;
+            if (position_ + bits > 64) {
+                value |= words_[1] << (64 - position_);
+            }
+            position_ += bits;
+            if (position_ >= 64) {
+                ++words_;
+                position_ -= 64;
+            }
+            return bits == 64 ? value : value & ((std::uint64_t(1) << bits) - 1);
+        }
+
+    private:
+        std::uint64_t const* words_;
+        int position_ = 0;
+    };
+
+    int count_leading_zeros(std::uint64_t x) noexcept { return x == 0 ? 64 : __builtin_clzll(x); }
+    int count_trailing_zeros(std::uint64_t x) noexcept { return x == 0 ? 64 : __builtin_ctzll(x); }
+
+    std::size_t xor_max_compressed_words(std::size_t count) noexcept {
+        return (count * (64 + 13) + 63) / 64 + 1;
+    }
+
+    std::size_t xor_compress(double const* input, std::size_t count, std::uint64_t* output) {
+        bit_writer writer{output};
+        std::uint64_t previous = 0;
+        int leading = 65, trailing = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &input[i], sizeof(bits));
+            auto const x = bits ^ previous;
+            previous = bits;
+            if (x == 0) {
+                writer.write(0, 1);
+                continue;
+            }
+            auto const new_leading = std::min(count_leading_zeros(x), 31);
+            auto const new_trailing = count_trailing_zeros(x);
+            if (leading <= new_leading && trailing <= new_trailing) {
+                writer.write(0b01, 2);
+                writer.write(x >> trailing, 64 - leading - trailing);
+            }
+            else {
+                leading = new_leading;
+                trailing = new_trailing;
+                auto const meaningful = 64 - leading - trailing;
+                writer.write(0b11, 2);
+                writer.write(std::uint64_t(leading), 5);
+                // meaningful is in [1, 64]; 64 is stored as 0.
+                writer.write(std::uint64_t(meaningful & 63), 6);
+                writer.write(x >> trailing, meaningful);
+            }
+        }
+        return std::size_t(writer.finish() - output) * sizeof(std::uint64_t);
+    }
+
+    void xor_decompress(std::uint64_t const* input, std::size_t count, double* output) {
+        bit_reader reader{input};
+        std::uint64_t previous = 0;
+        int leading = 0, trailing = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (reader.read(1) != 0) {
+                if (reader.read(1) != 0) {
+                    leading = int(reader.read(5));
+                    auto meaningful = int(reader.read(6));
+                    if (meaningful == 0) {
+                        meaningful = 64;
+                    }
+                    trailing = 64 - leading - meaningful;
+                }
+                previous ^= reader.read(64 - leading - trailing) << trailing;
+            }
+            std::memcpy(&output[i], &previous, sizeof(previous));
+        }
+    }
+
+    struct measurement {
+        double compression_ratio;
+        double compress_gbps;
+        double decompress_gbps;
+    };
+
+    template <class Function>
+    double best_seconds(Function&& f) {
+        constexpr int repetitions = 5;
+        double best = 1e300;
+        for (int i = 0; i < repetitions; ++i) {
+            auto const from = std::chrono::steady_clock::now();
+            f();
+            auto const to = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double>(to - from).count());
+        }
+        return best;
+    }
+
+    void verify(std::vector<double> const& data, std::vector<double> const& decoded,
+                char const* codec) {
+        if (std::memcmp(data.data(), decoded.data(), data.size() * sizeof(double)) != 0) {
+            std::cout << codec << " failed to roundtrip.\n";
+            std::exit(-1);
+        }
+    }
+
+    void print(char const* codec, measurement const& m) {
+        std::cout << "  " << std::left << std::setw(8) << codec << std::right << std::fixed
+                  << std::setprecision(2) << "ratio " << std::setw(6) << m.compression_ratio
+                  << "   compress " << std::setw(7) << m.compress_gbps << " GB/s"
+                  << "   decompress " << std::setw(7) << m.decompress_gbps << " GB/s\n";
+    }
+
+    void benchmark(std::string const& name, std::vector<double> const& data) {
+        auto const bytes = double(data.size() * sizeof(double));
+        std::vector<double> decoded(data.size());
+        std::cout << name << " (" << data.size() << " values)\n";
+
+        {
+            std::vector<double> copy(data.size());
+            auto const encode = best_seconds(
+                [&] { std::memcpy(copy.data(), data.data(), data.size() * sizeof(double)); });
+            auto const decode = best_seconds(
+                [&] { std::memcpy(decoded.data(), copy.data(), data.size() * sizeof(double)); });
+            verify(data, decoded, "memcpy");
+            print("memcpy", {1.0, bytes / encode / 1e9, bytes / decode / 1e9});
+        }
+
+        {
+            std::vector<std::uint64_t> compressed(xor_max_compressed_words(data.size()));
+            std::size_t compressed_size = 0;
+            auto const encode = best_seconds([&] {
+                compressed_size = xor_compress(data.data(), data.size(), compressed.data());
+            });
+            auto const decode = best_seconds(
+                [&] { xor_decompress(compressed.data(), data.size(), decoded.data()); });
+            verify(data, decoded, "XOR");
+            print("XOR", {bytes / double(compressed_size), bytes / encode / 1e9,
+                          bytes / decode / 1e9});
+        }
+
+        {
+            std::vector<unsigned char> compressed(jkj::alp::max_compressed_size(data.size()));
+            std::size_t compressed_size = 0;
+            auto const encode = best_seconds([&] {
+                compressed_size = jkj::alp::compress(data.data(), data.size(), compressed.data());
+            });
+            auto const decode =
+                best_seconds([&] { jkj::alp::decompress(compressed.data(), decoded.data()); });
+            verify(data, decoded, "ALP");
+            print("ALP", {bytes / double(compressed_size), bytes / encode / 1e9,
+                          bytes / decode / 1e9});
+        }
+        std::cout << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = std::size_t(1) << 22;
+    if (argc > 1) {
+        count = std::size_t(std::strtoull(argv[1], nullptr, 10));
+    }
+
+    std::mt19937_64 rg{20220101};
+
+    // Stock prices with 2 decimal places, following a random walk.
+    {
+        std::vector<double> data(count);
+        std::int64_t cents = 10000;
+        std::uniform_int_distribution<int> step{-50, 50};
+        for (auto& x : data) {
+            cents = std::max<std::int64_t>(1, cents + step(rg));
+            x = double(cents) / 100;
+        }
+        benchmark("Prices (2 decimal places, random walk)", data);
+    }
+
+    // Sensor readings with 1 decimal place.
+    {
+        std::vector<double> data(count);
+        std::normal_distribution<double> noise{0, 3};
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const reading = 20 + 10 * std::sin(double(i) / 5000) + noise(rg);
+            data[i] = std::round(reading * 10) / 10;
+        }
+        benchmark("Sensor readings (1 decimal place)", data);
+    }
+
+    // Uniformly random doubles in [0, 1), which have 15 to 17 digits.
+    {
+        std::vector<double> data(count);
+        std::uniform_real_distribution<double> dist{0, 1};
+        for (auto& x : data) {
+            x = dist(rg);
+        }
+        benchmark("Uniformly random doubles in [0, 1)", data);
+    }
+}
@@ -0,0 +1,153 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "alp_codec.h"
+#include "random_float.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    // Compresses and decompresses the data, and checks that every bit is recovered.
+    bool check_roundtrip(std::string const& name, std::vector<double> const& data) {
+        std::vector<unsigned char> compressed(jkj::alp::max_compressed_size(data.size()));
+        auto const compressed_size = jkj::alp::compress(data.data(), data.size(), compressed.data());
+        if (compressed_size > compressed.size()) {
+            std::cout << name << ": compressed size exceeds max_compressed_size.\n";
+            return false;
+        }
+        if (jkj::alp::decompressed_count(compressed.data()) != data.size()) {
+            std::cout << name << ": wrong number of values.\n";
+            return false;
+        }
+
+        std::vector<double> decompressed(data.size());
+        auto const consumed = jkj::alp::decompress(compressed.data(), decompressed.data());
+        if (consumed != compressed_size) {
+            std::cout << name << ": consumed " << consumed << " bytes out of " << compressed_size
+                      << ".\n";
+            return false;
+        }
+
+        std::size_t number_of_errors = 0;
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            std::uint64_t expected, actual;
+            std::memcpy(&expected, &data[i], sizeof(expected));
+            std::memcpy(&actual, &decompressed[i], sizeof(actual));
+            if (expected != actual && ++number_of_errors <= 10) {
+                std::cout << name << ": error detected! [Index = " << i << ", input = 0x"
+                          << std::hex << std::setfill('0') << std::setw(16) << expected
+                          << ", output = 0x" << std::setw(16) << actual << std::dec
+                          << std::setfill(' ') << "]\n";
+            }
+        }
+        if (number_of_errors != 0) {
+            return false;
+        }
+
+        std::cout << name << ": " << data.size() << " values, compression ratio "
+                  << double(data.size() * sizeof(double)) / double(compressed_size) << "\n";
+        return true;
+    }
+}
+
+int main() {
+    std::cout << "[Testing ALP codec roundtrip...]\n";
+
+    auto rg = generate_correctly_seeded_mt19937_64();
+    bool success = true;
+
+    // Empty input and partial blocks.
+    success &= check_roundtrip("empty", {});
+    for (std::size_t count : {std::size_t(1), jkj::alp::block_size - 1, jkj::alp::block_size,
+                              jkj::alp::block_size + 1, 5 * jkj::alp::block_size + 17}) {
+        std::vector<double> data(count);
+        std::uniform_int_distribution<int> cents{-100000, 100000};
+        for (auto& x : data) {
+            x = cents(rg) / 100.0;
+        }
+        success &= check_roundtrip("prices (" + std::to_string(count) + ")", data);
+    }
+
+    // Values with a fixed number of digits and varying magnitude.
+    for (unsigned int digits = 1; digits <= 17; digits += 4) {
+        std::vector<double> data(3000);
+        for (auto& x : data) {
+            x = randomly_generate_float_with_given_digits<double>(digits, rg);
+        }
+        success &= check_roundtrip(std::to_string(digits) + " digits", data);
+    }
+
+    // Decimals sharing an exponent, with the largest integers still representable.
+    {
+        std::vector<double> data;
+        for (int e = 0; e <= 22; ++e) {
+            auto const scale = std::pow(10.0, e);
+            for (std::int64_t d : {std::int64_t(1), std::int64_t(-7), (std::int64_t(1) << 53) - 1,
+                                   -(std::int64_t(1) << 53), std::int64_t(1) << 53}) {
+                data.push_back(double(d) / scale);
+                data.push_back(double(d) * scale);
+            }
+        }
+        success &= check_roundtrip("boundaries", data);
+    }
+
+    // Special values mixed into encodable ones.
+    {
+        std::vector<double> data(2000);
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            data[i] = double(i) / 8;
+        }
+        data[0] = -0.0;
+        data[1] = std::numeric_limits<double>::infinity();
+        data[2] = -std::numeric_limits<double>::infinity();
+        data[3] = std::numeric_limits<double>::quiet_NaN();
+        data[4] = std::numeric_limits<double>::denorm_min();
+        data[5] = std::numeric_limits<double>::max();
+        data[1500] = -0.0;
+        data[1999] = std::numeric_limits<double>::signaling_NaN();
+        success &= check_roundtrip("special values", data);
+    }
+
+    // Arbitrary bit patterns, which are mostly exceptions.
+    {
+        std::vector<double> data(10000);
+        for (auto& x : data) {
+            x = uniformly_randomly_generate_general_float<double>(rg);
+        }
+        success &= check_roundtrip("random bits", data);
+    }
+
+    if (success) {
+        std::cout << "All cases are verified.\n";
+    }
+    else {
+        std::cout << "Errors detected.\n";
+    }
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
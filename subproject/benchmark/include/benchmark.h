@@ -18,6 +18,8 @@
 #ifndef JKJ_BENCHMARK
 #define JKJ_BENCHMARK
 
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 
 struct register_function_for_benchmark {
@@ -37,4 +39,19 @@ struct register_function_for_benchmark {
 		void(*func_double)(double, char*));
 };
 
+// Functions converting a whole array at once, for throughput measurement.
+// The return value is a checksum of the results, to prevent them from being optimized away.
+struct register_batch_function_for_benchmark {
+	register_batch_function_for_benchmark() = default;
+
+	register_batch_function_for_benchmark(
+		std::string_view name,
+		std::uint64_t(*func)(float const*, std::size_t));
+
+	register_batch_function_for_benchmark(
+		std::string_view name,
+		std::uint64_t(*func_float)(float const*, std::size_t),
+		std::uint64_t(*func_double)(double const*, std::size_t));
+};
+
 #endif
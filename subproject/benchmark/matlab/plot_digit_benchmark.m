@@ -37,7 +37,7 @@ for algorithm_idx=1:number_of_algorithms
     end
 end
 
-color_array = {[.8 .06 .1],[.1 .7 .06],[.06 .1 .8],[.6 .2 .8],[.8 .9 0],[.5 .6 .7],[.8 .2 .6]};
+color_array = {[.8 .06 .1],[.1 .7 .06],[.06 .1 .8],[.6 .2 .8],[.8 .9 0],[.5 .6 .7],[.8 .2 .6],[.2 .5 .5],[.9 .5 .1],[.4 .3 .1]};
 avg = zeros(number_of_algorithms, max_digits);
 for algorithm_idx=1:number_of_algorithms
     for digits_idx=1:max_digits
@@ -35,7 +35,7 @@ for algorithm_idx=1:number_of_algorithms
 end
 bit_representations = sscanf(strjoin(string(table{1:samples, 2})', ' '), '%lu');
 
-color_array = {[.8 .06 .1],[.1 .7 .06],[.06 .1 .8],[.6 .2 .8],[.8 .9 0],[.5 .6 .7],[.8 .2 .6]};
+color_array = {[.8 .06 .1],[.1 .7 .06],[.06 .1 .8],[.6 .2 .8],[.8 .9 0],[.5 .6 .7],[.8 .2 .6],[.2 .5 .5],[.9 .5 .1],[.4 .3 .1]};
 
 % compute statistics
 av = mean(measured_times');
@@ -17,9 +17,12 @@
 
 #include "benchmark.h"
 #include "random_float.h"
+#include "sample_cache.h"
 #include "dragonbox/dragonbox_to_chars.h"
 #include <array>
 #include <chrono>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
@@ -39,17 +42,63 @@ public:
         return inst;
     }
 
-    // Generate random samples
-    void prepare_samples(std::size_t number_of_general_samples,
+    // Generate random samples, or load them from the sample cache if they were generated before
+    void prepare_samples(std::uint64_t seed, std::size_t number_of_general_samples,
                          std::size_t number_of_digits_samples_per_digits) {
-        samples_[0].resize(number_of_general_samples);
-        for (auto& sample : samples_[0])
-            sample = uniformly_randomly_generate_general_float<Float>(rg_);
+        samples_[0] = load_or_generate_samples<Float>(
+            sample_cache_directory, seed, 0, number_of_general_samples,
+            [](std::mt19937_64& rg) { return uniformly_randomly_generate_general_float<Float>(rg); });
 
         for (unsigned int digits = 1; digits <= max_digits; ++digits) {
-            samples_[digits].resize(number_of_digits_samples_per_digits);
-            for (auto& sample : samples_[digits])
-                sample = randomly_generate_float_with_given_digits<Float>(digits, rg_);
+            samples_[digits] = load_or_generate_samples<Float>(
+                sample_cache_directory, seed, digits, number_of_digits_samples_per_digits,
+                [digits](std::mt19937_64& rg) {
+                    return randomly_generate_float_with_given_digits<Float>(digits, rg);
+                });
+        }
+    }
+
+    // Check that the output of each registered function reads back to the input.
+    // Functions failing the check are excluded from the measurement.
+    void check_round_trip(std::string_view float_name) {
+        char buffer[40];
+        for (auto itr = name_func_pairs_.begin(); itr != name_func_pairs_.end();) {
+            std::cout << "Checking round trip of " << itr->first << " with " << float_name
+                      << "'s...\n";
+
+            std::size_t number_of_failures = 0;
+            for (auto const& samples : samples_) {
+                for (Float sample : samples) {
+                    itr->second(sample, buffer);
+
+                    char* str_end;
+                    Float roundtrip;
+                    if constexpr (sizeof(Float) == 4) {
+                        roundtrip = std::strtof(buffer, &str_end);
+                    }
+                    else {
+                        roundtrip = std::strtod(buffer, &str_end);
+                    }
+
+                    if (*str_end == '\0' && (std::memcmp(&roundtrip, &sample, sizeof(Float)) == 0 ||
+                                              (std::isnan(roundtrip) && std::isnan(sample)))) {
+                        continue;
+                    }
+                    if (++number_of_failures <= 10) {
+                        std::cout << "    " << std::hexfloat << sample << std::defaultfloat
+                                  << " is printed as \"" << buffer << "\"\n";
+                    }
+                }
+            }
+
+            if (number_of_failures != 0) {
+                std::cout << "    " << number_of_failures
+                          << " failures; excluded from the benchmark.\n";
+                itr = name_func_pairs_.erase(itr);
+            }
+            else {
+                ++itr;
+            }
         }
     }
 
@@ -108,13 +157,58 @@ public:
         name_func_pairs_.emplace(name, func);
     }
 
+    // Measure the throughput of the batch functions over the finite nonzero general samples.
+    // Unlike run(), which measures the latency of each sample separately, the whole array is
+    // converted at once so that independent conversions can overlap.
+    // { "name" : average time per sample }
+    std::unordered_map<std::string, double> run_batch(std::size_t number_of_iterations,
+                                                      std::string_view float_name) {
+        assert(number_of_iterations >= 1);
+        std::vector<Float> samples;
+        samples.reserve(samples_[0].size());
+        for (Float sample : samples_[0]) {
+            if (std::isfinite(sample) && sample != 0) {
+                samples.push_back(sample);
+            }
+        }
+
+        std::unordered_map<std::string, double> out;
+        std::uint64_t checksum = 0;
+        for (auto const& name_func_pair : name_batch_func_pairs_) {
+            std::cout << "Benchmarking the throughput of " << name_func_pair.first
+                      << " with uniformly random " << float_name << "'s...\n";
+
+            auto from = std::chrono::high_resolution_clock::now();
+            for (std::size_t i = 0; i < number_of_iterations; ++i) {
+                checksum += name_func_pair.second(samples.data(), samples.size());
+            }
+            auto dur = std::chrono::high_resolution_clock::now() - from;
+
+            auto const time_per_sample =
+                double(std::chrono::duration_cast<std::chrono::nanoseconds>(dur).count()) /
+                double(number_of_iterations * samples.size());
+            std::cout << "    " << time_per_sample << "ns per sample\n";
+            out.insert_or_assign(name_func_pair.first, time_per_sample);
+        }
+        std::cout << "(checksum: " << checksum << ")\n";
+        return out;
+    }
+
+    void register_batch_function(std::string_view name,
+                                 std::uint64_t (*func)(Float const*, std::size_t)) {
+        name_batch_func_pairs_.emplace(name, func);
+    }
+
 private:
-    benchmark_holder() : rg_(generate_correctly_seeded_mt19937_64()) {}
+    static constexpr char const* sample_cache_directory = "sample_cache";
+
+    benchmark_holder() = default;
 
     // Digits samples for [1] ~ [max_digits], general samples for [0]
-    std::array<std::vector<Float>, max_digits + 1> samples_;
-    std::mt19937_64 rg_;
+    std::array<sample_set<Float>, max_digits + 1> samples_;
     std::unordered_map<std::string, void (*)(Float, char*)> name_func_pairs_;
+    std::unordered_map<std::string, std::uint64_t (*)(Float const*, std::size_t)>
+        name_batch_func_pairs_;
 };
 
 register_function_for_benchmark::register_function_for_benchmark(std::string_view name,
@@ -134,6 +228,18 @@ register_function_for_benchmark::register_function_for_benchmark(std::string_vie
     benchmark_holder<double>::get_instance().register_function(name, func_double);
 };
 
+register_batch_function_for_benchmark::register_batch_function_for_benchmark(
+    std::string_view name, std::uint64_t (*func_float)(float const*, std::size_t)) {
+    benchmark_holder<float>::get_instance().register_batch_function(name, func_float);
+};
+
+register_batch_function_for_benchmark::register_batch_function_for_benchmark(
+    std::string_view name, std::uint64_t (*func_float)(float const*, std::size_t),
+    std::uint64_t (*func_double)(double const*, std::size_t)) {
+    benchmark_holder<float>::get_instance().register_batch_function(name, func_float);
+    benchmark_holder<double>::get_instance().register_batch_function(name, func_double);
+};
+
 
 #define RUN_MATLAB
 #ifdef RUN_MATLAB
@@ -148,13 +254,16 @@ void run_matlab() {
 #endif
 
 template <class Float>
-static void benchmark_test(std::string_view float_name, std::size_t number_of_uniform_samples,
+static void benchmark_test(std::string_view float_name, std::uint64_t seed,
+                           std::size_t number_of_uniform_samples,
                            std::size_t number_of_digits_samples_per_digits,
                            std::size_t number_of_iterations) {
     auto& inst = benchmark_holder<Float>::get_instance();
-    std::cout << "Generating random samples...\n";
-    inst.prepare_samples(number_of_uniform_samples, number_of_digits_samples_per_digits);
+    std::cout << "Preparing random samples...\n";
+    inst.prepare_samples(seed, number_of_uniform_samples, number_of_digits_samples_per_digits);
+    inst.check_round_trip(float_name);
     auto out = inst.run(number_of_iterations, float_name);
+    auto batch_out = inst.run_batch(number_of_iterations, float_name);
 
     std::cout << "Benchmarking done.\n"
               << "Now writing to files...\n";
@@ -206,9 +315,23 @@ static void benchmark_test(std::string_view float_name, std::size_t number_of_un
         }
     }
     out_file.close();
+
+    // Write batch benchmark results
+    filename = std::string("results/batch_benchmark_");
+    filename += float_name;
+    filename += ".csv";
+    out_file.open(filename);
+    out_file << "name,time_per_sample\n";
+    for (auto& name_time_pair : batch_out) {
+        out_file << "\"" << name_time_pair.first << "\"," << name_time_pair.second << "\n";
+    }
+    out_file.close();
 }
 
 int main() {
+    // Samples are cached on disk, keyed by this seed and the number of samples.
+    constexpr std::uint64_t sample_seed = UINT64_C(0x6a09e667f3bcc908);
+
     constexpr bool benchmark_float = true;
     constexpr std::size_t number_of_uniform_benchmark_samples_float = 1000000;
     constexpr std::size_t number_of_digits_benchmark_samples_per_digits_float = 100000;
@@ -221,14 +344,14 @@ int main() {
 
     if constexpr (benchmark_float) {
         std::cout << "[Running benchmark for binary32...]\n";
-        benchmark_test<float>("binary32", number_of_uniform_benchmark_samples_float,
+        benchmark_test<float>("binary32", sample_seed, number_of_uniform_benchmark_samples_float,
                               number_of_digits_benchmark_samples_per_digits_float,
                               number_of_benchmark_iterations_float);
         std::cout << "Done.\n\n\n";
     }
     if constexpr (benchmark_double) {
         std::cout << "[Running benchmark for binary64...]\n";
-        benchmark_test<double>("binary64", number_of_uniform_benchmark_samples_double,
+        benchmark_test<double>("binary64", sample_seed, number_of_uniform_benchmark_samples_double,
                                number_of_digits_benchmark_samples_per_digits_double,
                                number_of_benchmark_iterations_double);
         std::cout << "Done.\n\n\n";
@@ -0,0 +1,127 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Measures the multiplication and the division of big_uint, which dominate the time of the
+// programs generating and verifying the cache tables, at sizes from a few words up to those needed
+// for binary128 (5^4966 has about 180 words), and the generation of a binary128-sized cache table.
+//
+// Usage: big_uint_benchmark [maximum number of words]
+
+#include "big_uint.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    jkj::big_uint random_big_uint(std::size_t number_of_words, std::mt19937_64& rg) {
+        std::vector<std::uint64_t> words(number_of_words);
+        for (auto& word : words) {
+            word = rg();
+        }
+        words.back() |= std::uint64_t(1) << 63;
+        return jkj::big_uint(words.begin(), words.end());
+    }
+
+    // Returns the best of a few runs of f, in microseconds per call.
+    template <class Func>
+    double measure(std::size_t number_of_calls, Func&& f) {
+        double best = 0;
+        for (int run = 0; run < 5; ++run) {
+            auto const from = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < number_of_calls; ++i) {
+                f();
+            }
+            auto const dur = std::chrono::steady_clock::now() - from;
+            auto const time_per_call =
+                double(std::chrono::duration_cast<std::chrono::nanoseconds>(dur).count()) /
+                double(number_of_calls) / 1000;
+            if (run == 0 || time_per_call < best) {
+                best = time_per_call;
+            }
+        }
+        return best;
+    }
+
+    // The same computation as generate_cache in subproject/meta for 256-bit entries, over the
+    // range of decimal exponents of binary128.
+    std::size_t generate_binary128_cache(int step) {
+        constexpr std::size_t cache_bits = 256;
+        constexpr int min_k = -4966;
+        constexpr int max_k = 4933;
+
+        std::size_t checksum = 0;
+        for (int k = min_k; k <= max_k; k += step) {
+            auto const exp_2 = k - int(std::floor(k * 3.321928094887362347870319429489)) - 1;
+            jkj::big_uint numerator = 1;
+            jkj::big_uint denominator = 1;
+            if (k >= 0) {
+                numerator = jkj::big_uint::pow(5, std::size_t(k));
+            }
+            else {
+                denominator = jkj::big_uint::pow(5, std::size_t(-k));
+            }
+            if (exp_2 >= 0) {
+                numerator *= jkj::big_uint::power_of_2(std::size_t(exp_2));
+            }
+            else {
+                denominator *= jkj::big_uint::power_of_2(std::size_t(-exp_2));
+            }
+            auto const result = div(jkj::big_uint::power_of_2(cache_bits) * numerator, denominator);
+            checksum += log2p1(result.quot);
+        }
+        return checksum;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t max_words = 1024;
+    if (argc > 1) {
+        max_words = std::size_t(std::strtoull(argv[1], nullptr, 10));
+    }
+
+    std::mt19937_64 rg{20240101};
+    std::size_t checksum = 0;
+
+    std::cout << "[Running big_uint benchmark...]\n";
+    std::cout << " words   n*n mul (us)   2n/n div (us)\n";
+    for (std::size_t words = 4; words <= max_words; words *= 2) {
+        auto const x = random_big_uint(words, rg);
+        auto const y = random_big_uint(words, rg);
+        auto const dividend = x * y + random_big_uint(words - 1, rg);
+        auto const number_of_calls = std::max<std::size_t>(1, 200000 / (words * words));
+
+        auto const mul = measure(number_of_calls, [&] { checksum += log2p1(x * y); });
+        auto const division =
+            measure(number_of_calls, [&] { checksum += log2p1(div(dividend, y).quot); });
+        std::cout << std::setw(6) << words << std::setw(15) << std::fixed << std::setprecision(3)
+                  << mul << std::setw(16) << division << "\n";
+    }
+
+    // Every 16th entry of the table.
+    auto const cache = measure(1, [&] { checksum += generate_binary128_cache(16); });
+    std::cout << "binary128 cache, every 16th of 9900 entries: " << std::setprecision(1)
+              << cache / 1000 << " ms\n";
+
+    std::cout << "Checksum: " << checksum << "\nDone.\n\n\n";
+}
@@ -0,0 +1,134 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Compares the cache policies on data whose magnitudes are known to lie in [1e-6, 1e9), which is
+// what policy::cache::restricted_t is for. Each conversion is followed by a number of random
+// updates into a large buffer, standing for the rest of a query pipeline competing for the data
+// cache. The time of the co-workload alone is measured separately and subtracted.
+//
+// Usage: cache_policy_benchmark [number of values] [updates per value] [buffer size in KiB]
+
+#include "dragonbox/dragonbox.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr int min_decimal_exponent = -6;
+    constexpr int max_decimal_exponent = 8;
+    using restricted_cache =
+        jkj::dragonbox::policy::cache::restricted_t<min_decimal_exponent, max_decimal_exponent>;
+
+    struct co_workload {
+        std::vector<std::uint64_t> buffer;
+        std::uint64_t state = 1;
+        std::size_t updates_per_value;
+
+        void run() noexcept {
+            for (std::size_t i = 0; i < updates_per_value; ++i) {
+                state = state * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+                buffer[std::size_t(state >> 33) % buffer.size()] += state;
+            }
+        }
+    };
+
+    struct no_conversion {};
+
+    template <class CachePolicy>
+    std::uint64_t convert(double x, CachePolicy) noexcept {
+        auto const result = jkj::dragonbox::to_decimal(x, CachePolicy{});
+        return std::uint64_t(result.significand) + std::uint64_t(result.exponent);
+    }
+    std::uint64_t convert(double, no_conversion) noexcept { return 0; }
+
+    // Returns the best of a few runs, in nanoseconds per value.
+    template <class CachePolicy>
+    double measure(std::vector<double> const& samples, co_workload& work, std::uint64_t& checksum) {
+        double best = 0;
+        for (int run = 0; run < 5; ++run) {
+            auto const from = std::chrono::steady_clock::now();
+            for (double x : samples) {
+                checksum += convert(x, CachePolicy{});
+                work.run();
+            }
+            auto const dur = std::chrono::steady_clock::now() - from;
+            auto const time_per_value =
+                double(std::chrono::duration_cast<std::chrono::nanoseconds>(dur).count()) /
+                double(samples.size());
+            if (run == 0 || time_per_value < best) {
+                best = time_per_value;
+            }
+        }
+        return best;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t const number_of_values = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::size_t const updates_per_value = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16;
+    std::size_t const buffer_kib = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 8192;
+
+    // Log-uniformly distributed values with 1 to 9 significant digits.
+    std::mt19937_64 rg{UINT64_C(0x3c6ef372fe94f82b)};
+    std::uniform_int_distribution<int> exponent_dist{min_decimal_exponent, max_decimal_exponent};
+    std::uniform_int_distribution<int> digits_dist{1, 9};
+    std::vector<double> samples(number_of_values);
+    for (auto& x : samples) {
+        auto const digits = digits_dist(rg);
+        auto const significand = std::uniform_int_distribution<std::uint64_t>{
+            std::uint64_t(std::pow(10, digits - 1)), std::uint64_t(std::pow(10, digits)) - 1}(rg);
+        x = double(significand) * std::pow(10.0, exponent_dist(rg) - digits + 1);
+    }
+
+    co_workload work{std::vector<std::uint64_t>(buffer_kib * 1024 / sizeof(std::uint64_t), 0), 1,
+                     updates_per_value};
+    std::uint64_t checksum = 0;
+
+    auto const baseline = measure<no_conversion>(samples, work, checksum);
+    auto const full = measure<jkj::dragonbox::policy::cache::full_t>(samples, work, checksum);
+    auto const compact = measure<jkj::dragonbox::policy::cache::compact_t>(samples, work, checksum);
+    auto const restricted = measure<restricted_cache>(samples, work, checksum);
+
+    using full_holder = jkj::dragonbox::cache_holder<jkj::dragonbox::ieee754_binary64>;
+    using compact_holder = jkj::dragonbox::compressed_cache_holder<jkj::dragonbox::ieee754_binary64>;
+    using restricted_holder =
+        restricted_cache::cache_holder_type<jkj::dragonbox::ieee754_binary64>;
+
+    std::cout << number_of_values << " values in [1e" << min_decimal_exponent << ", 1e"
+              << max_decimal_exponent + 1 << "), " << updates_per_value
+              << " random updates into " << buffer_kib << " KiB after each conversion\n"
+              << "co-workload alone: " << std::fixed << std::setprecision(2) << baseline
+              << " ns per value\n\n"
+              << std::left << std::setw(12) << "policy" << std::right << std::setw(14)
+              << "table bytes" << std::setw(20) << "ns per conversion\n";
+
+    auto print = [&](char const* name, std::size_t table_bytes, double time) {
+        std::cout << std::left << std::setw(12) << name << std::right << std::setw(14)
+                  << table_bytes << std::setw(19) << time - baseline << "\n";
+    };
+    print("full", sizeof(full_holder::cache), full);
+    print("compact", sizeof(compact_holder::cache) + sizeof(compact_holder::pow5_table), compact);
+    print("restricted", sizeof(restricted_holder::cache), restricted);
+
+    std::cout << "(checksum: " << checksum << ")\n";
+}
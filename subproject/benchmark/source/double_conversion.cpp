@@ -0,0 +1,42 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "benchmark.h"
+#include <double-conversion/double-conversion.h>
+
+namespace {
+    // Same as EcmaScriptConverter() except that the sign of zero is kept.
+    double_conversion::DoubleToStringConverter const converter{
+        double_conversion::DoubleToStringConverter::NO_FLAGS, "Infinity", "NaN", 'e', -6, 21, 6, 0};
+
+    void double_conversion_float(float x, char* buffer) {
+        double_conversion::StringBuilder builder{buffer, 40};
+        converter.ToShortestSingle(x, &builder);
+        builder.Finalize();
+    }
+    void double_conversion_double(double x, char* buffer) {
+        double_conversion::StringBuilder builder{buffer, 40};
+        converter.ToShortest(x, &builder);
+        builder.Finalize();
+    }
+
+#if 1
+    auto dummy = []() -> register_function_for_benchmark {
+        return {"double-conversion", double_conversion_float, double_conversion_double};
+    }();
+#endif
+}
@@ -17,6 +17,14 @@
 
 #include "benchmark.h"
 #include "dragonbox/dragonbox_to_chars.h"
+#include "dragonbox/dragonbox_simd.h"
+#include "dragonbox/dragonbox_runtime_rounding.h"
+#include "dragonbox/dragonbox_hexfloat.h"
+#include "dragonbox/dragonbox_charconv.h"
+#include "dragonbox/dragonbox_string.h"
+#include <cstring>
+#include <string>
+#include <vector>
 
 namespace {
     void dragonbox_float_to_chars(float x, char* buffer) { jkj::dragonbox::to_chars(x, buffer); }
@@ -27,4 +35,535 @@ namespace {
         return {"Dragonbox", dragonbox_float_to_chars, dragonbox_double_to_chars};
     }();
 #endif
+
+    template <class Float>
+    std::uint64_t dragonbox_to_decimal_x1(Float const* x, std::size_t count) {
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const result = jkj::dragonbox::to_decimal(x[i]);
+            checksum += std::uint64_t(result.significand) + std::uint64_t(result.exponent);
+        }
+        return checksum;
+    }
+
+    template <class Float, std::size_t N>
+    std::uint64_t dragonbox_to_decimal_xn(Float const* x, std::size_t count) {
+        std::uint64_t checksum = 0;
+        std::size_t i = 0;
+        for (; i + N <= count; i += N) {
+            decltype(jkj::dragonbox::to_decimal(x[i])) results[N];
+            jkj::dragonbox::to_decimal_xn<N>(x + i, results);
+            for (auto const& result : results) {
+                checksum += std::uint64_t(result.significand) + std::uint64_t(result.exponent);
+            }
+        }
+        return checksum + dragonbox_to_decimal_x1(x + i, count - i);
+    }
+
+#if 1
+    auto dummy_batch_x1 = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_decimal", dragonbox_to_decimal_x1<float>,
+                dragonbox_to_decimal_x1<double>};
+    }();
+    auto dummy_batch_x2 = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_decimal_x2", dragonbox_to_decimal_xn<float, 2>,
+                dragonbox_to_decimal_xn<double, 2>};
+    }();
+    auto dummy_batch_x4 = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_decimal_x4", dragonbox_to_decimal_xn<float, 4>,
+                dragonbox_to_decimal_xn<double, 4>};
+    }();
+#endif
+
+    template <class Float>
+    std::uint64_t dragonbox_to_chars_n(Float const* x, std::size_t count) {
+        char buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            checksum += std::uint64_t(jkj::dragonbox::to_chars_n(x[i], buffer) - buffer);
+        }
+        return checksum;
+    }
+
+    template <class Float>
+    std::uint64_t dragonbox_formatted_size(Float const* x, std::size_t count) {
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            checksum += std::uint64_t(jkj::dragonbox::formatted_size(x[i]));
+        }
+        return checksum;
+    }
+
+#if 1
+    auto dummy_batch_to_chars_n = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n", dragonbox_to_chars_n<float>, dragonbox_to_chars_n<double>};
+    }();
+    auto dummy_batch_formatted_size = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox formatted_size", dragonbox_formatted_size<float>,
+                dragonbox_formatted_size<double>};
+    }();
+#endif
+
+    template <class Float>
+    std::uint64_t dragonbox_to_chars_n_capped_7(Float const* x, std::size_t count) {
+        char buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            checksum += std::uint64_t(jkj::dragonbox::to_chars_n_capped(x[i], buffer, 7) - buffer);
+        }
+        return checksum;
+    }
+
+#if 1
+    auto dummy_batch_capped = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n_capped (7 digits)", dragonbox_to_chars_n_capped_7<float>,
+                dragonbox_to_chars_n_capped_7<double>};
+    }();
+#endif
+
+    template <class Float>
+    std::uint64_t dragonbox_to_chars_hex_n(Float const* x, std::size_t count) {
+        char buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            checksum += std::uint64_t(jkj::dragonbox::to_chars_hex_n(x[i], buffer) - buffer);
+        }
+        return checksum;
+    }
+
+    template <class Float>
+    std::uint64_t dragonbox_hexfloat_roundtrip(Float const* x, std::size_t count) {
+        char buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const end = jkj::dragonbox::to_chars_hex_n(x[i], buffer);
+            Float parsed = 0;
+            if (jkj::dragonbox::from_chars_hex(buffer, end, parsed) == end) {
+                checksum += parsed == x[i] ? 1 : 0;
+            }
+        }
+        return checksum;
+    }
+
+#if 1
+    auto dummy_batch_hex = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_hex_n", dragonbox_to_chars_hex_n<float>,
+                dragonbox_to_chars_hex_n<double>};
+    }();
+    auto dummy_batch_hex_roundtrip = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_hex_n + from_chars_hex", dragonbox_hexfloat_roundtrip<float>,
+                dragonbox_hexfloat_roundtrip<double>};
+    }();
+#endif
+
+    template <class Float>
+    std::uint64_t dragonbox_to_chars_n_engineering(Float const* x, std::size_t count) {
+        char buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            checksum += std::uint64_t(
+                jkj::dragonbox::to_chars_n(x[i], buffer,
+                                           jkj::dragonbox::policy::notation::engineering) -
+                buffer);
+        }
+        return checksum;
+    }
+
+    // The two-pass approach: rewrites the output of to_chars_n into the engineering notation.
+    char* rewrite_into_engineering_notation(char const* first, char const* last, char* buffer) {
+        if (*first == '-') {
+            *buffer++ = *first++;
+        }
+        char digits[32];
+        int number_of_digits = 0;
+        for (; *first != 'E'; ++first) {
+            if (*first != '.') {
+                digits[number_of_digits++] = *first;
+            }
+        }
+        bool const is_negative_exponent = *++first == '-';
+        first += is_negative_exponent ? 1 : 0;
+        int exponent = 0;
+        for (; first != last; ++first) {
+            exponent = exponent * 10 + (*first - '0');
+        }
+        exponent = is_negative_exponent ? -exponent : exponent;
+
+        auto const integer_length = (exponent % 3 + 3) % 3 + 1;
+        exponent -= integer_length - 1;
+        for (int i = 0; i < integer_length; ++i) {
+            *buffer++ = i < number_of_digits ? digits[i] : '0';
+        }
+        if (number_of_digits > integer_length) {
+            *buffer++ = '.';
+            for (int i = integer_length; i < number_of_digits; ++i) {
+                *buffer++ = digits[i];
+            }
+        }
+        *buffer++ = 'E';
+        if (exponent < 0) {
+            *buffer++ = '-';
+            exponent = -exponent;
+        }
+        if (exponent >= 100) {
+            *buffer++ = char('0' + exponent / 100);
+        }
+        if (exponent >= 10) {
+            *buffer++ = char('0' + exponent / 10 % 10);
+        }
+        *buffer++ = char('0' + exponent % 10);
+        return buffer;
+    }
+
+    template <class Float>
+    std::uint64_t dragonbox_to_chars_n_then_rewrite(Float const* x, std::size_t count) {
+        char temp[64];
+        char buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const end = jkj::dragonbox::to_chars_n(x[i], temp);
+            checksum +=
+                std::uint64_t(rewrite_into_engineering_notation(temp, end, buffer) - buffer);
+        }
+        return checksum;
+    }
+
+#if 1
+    auto dummy_batch_engineering = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n (engineering)", dragonbox_to_chars_n_engineering<float>,
+                dragonbox_to_chars_n_engineering<double>};
+    }();
+    auto dummy_batch_engineering_rewrite = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n + rewrite into engineering",
+                dragonbox_to_chars_n_then_rewrite<float>, dragonbox_to_chars_n_then_rewrite<double>};
+    }();
+#endif
+
+    template <class Float, class NotationPolicy>
+    std::uint64_t dragonbox_to_chars_n_with_notation(Float const* x, std::size_t count) {
+        char buffer[512];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            checksum +=
+                std::uint64_t(jkj::dragonbox::to_chars_n(x[i], buffer, NotationPolicy{}) - buffer);
+        }
+        return checksum;
+    }
+
+    // The two-pass approach: inserts the separators into the output of the fixed notation.
+    char* rewrite_into_grouped_notation(char const* first, char const* last, char* buffer) {
+        if (*first == '-') {
+            *buffer++ = *first++;
+        }
+        auto integer_last = first;
+        while (integer_last != last && *integer_last != '.') {
+            ++integer_last;
+        }
+        for (auto ptr = first; ptr != integer_last; ++ptr) {
+            if (ptr != first && (integer_last - ptr) % 3 == 0) {
+                *buffer++ = '.';
+            }
+            *buffer++ = *ptr;
+        }
+        if (integer_last != last) {
+            *buffer++ = ',';
+            for (auto ptr = integer_last + 1; ptr != last; ++ptr) {
+                *buffer++ = *ptr;
+            }
+        }
+        return buffer;
+    }
+
+    template <class Float>
+    std::uint64_t dragonbox_to_chars_n_fixed_then_group(Float const* x, std::size_t count) {
+        char temp[512];
+        char buffer[512];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const end =
+                jkj::dragonbox::to_chars_n(x[i], temp, jkj::dragonbox::policy::notation::fixed);
+            checksum += std::uint64_t(rewrite_into_grouped_notation(temp, end, buffer) - buffer);
+        }
+        return checksum;
+    }
+
+#if 1
+    using european_fixed_notation = jkj::dragonbox::policy::notation::fixed_t<',', '.', 3>;
+    auto dummy_batch_fixed = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n (fixed)",
+                dragonbox_to_chars_n_with_notation<float, jkj::dragonbox::policy::notation::fixed_t<>>,
+                dragonbox_to_chars_n_with_notation<double,
+                                                   jkj::dragonbox::policy::notation::fixed_t<>>};
+    }();
+    auto dummy_batch_fixed_grouped = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n (fixed, grouped)",
+                dragonbox_to_chars_n_with_notation<float, european_fixed_notation>,
+                dragonbox_to_chars_n_with_notation<double, european_fixed_notation>};
+    }();
+    auto dummy_batch_fixed_group_rewrite = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n (fixed) + grouping pass",
+                dragonbox_to_chars_n_fixed_then_group<float>,
+                dragonbox_to_chars_n_fixed_then_group<double>};
+    }();
+#endif
+
+    // The rounding modes are read from volatile variables so that the compiler cannot see them.
+    // They select the default policies, so the results can be compared with to_chars_n above to
+    // get the cost of the dispatch.
+    volatile auto runtime_decimal_to_binary_rounding =
+        jkj::dragonbox::decimal_to_binary_rounding_mode::nearest_to_even;
+    volatile auto runtime_binary_to_decimal_rounding =
+        jkj::dragonbox::binary_to_decimal_rounding_mode::to_even;
+
+    // Looks up the table for every call.
+    template <class Float>
+    std::uint64_t dragonbox_to_chars_n_runtime_rounding(Float const* x, std::size_t count) {
+        auto const dbr = runtime_decimal_to_binary_rounding;
+        auto const bdr = runtime_binary_to_decimal_rounding;
+        char buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            checksum += std::uint64_t(jkj::dragonbox::to_chars_n(x[i], buffer, dbr, bdr) - buffer);
+        }
+        return checksum;
+    }
+
+    // Looks up the table once.
+    template <class Float>
+    std::uint64_t dragonbox_to_chars_n_selected(Float const* x, std::size_t count) {
+        auto const func = jkj::dragonbox::select_to_chars_n<Float>(
+            runtime_decimal_to_binary_rounding, runtime_binary_to_decimal_rounding);
+        char buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            checksum += std::uint64_t(func(x[i], buffer) - buffer);
+        }
+        return checksum;
+    }
+
+#if 1
+    auto dummy_batch_runtime_rounding = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n (runtime rounding modes)",
+                dragonbox_to_chars_n_runtime_rounding<float>,
+                dragonbox_to_chars_n_runtime_rounding<double>};
+    }();
+    auto dummy_batch_selected = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n (select_to_chars_n)", dragonbox_to_chars_n_selected<float>,
+                dragonbox_to_chars_n_selected<double>};
+    }();
+#endif
+
+    // Writes the outputs one after another into a frame of 4 KiB, starting over when it is full,
+    // as a call site serializing into a shared output buffer does. Compare with
+    // "std::to_chars (4 KiB frame)" and others in std_to_chars.cpp.
+    template <class Float, class Format>
+    std::uint64_t write_into_frame(Float const* x, std::size_t count, Format const& format) {
+        static char frame[4096];
+        char* ptr = frame;
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto result = format(ptr, frame + sizeof(frame), x[i]);
+            if (result.ec != std::errc{}) {
+                checksum += std::uint64_t(ptr - frame);
+                ptr = frame;
+                result = format(ptr, frame + sizeof(frame), x[i]);
+            }
+            ptr = result.ptr;
+        }
+        return checksum + std::uint64_t(ptr - frame);
+    }
+
+    template <class Float>
+    std::uint64_t dragonbox_charconv_frame(Float const* x, std::size_t count) {
+        return write_into_frame(x, count, [](char* first, char* last, Float y) {
+            return jkj::dragonbox::charconv::to_chars(first, last, y);
+        });
+    }
+
+    // What call sites did before charconv::to_chars: format into a scratch buffer and copy.
+    template <class Float>
+    std::uint64_t dragonbox_to_chars_n_copy_frame(Float const* x, std::size_t count) {
+        return write_into_frame(x, count, [](char* first, char* last, Float y) {
+            char buffer[64];
+            auto const length = std::size_t(jkj::dragonbox::to_chars_n(y, buffer) - buffer);
+            if (length > std::size_t(last - first)) {
+                return jkj::dragonbox::charconv::to_chars_result{last, std::errc::value_too_large};
+            }
+            std::memcpy(first, buffer, length);
+            return jkj::dragonbox::charconv::to_chars_result{first + length, std::errc{}};
+        });
+    }
+
+    template <class Float>
+    std::uint64_t dragonbox_charconv_scientific_frame(Float const* x, std::size_t count) {
+        return write_into_frame(x, count, [](char* first, char* last, Float y) {
+            return jkj::dragonbox::charconv::to_chars(
+                first, last, y, jkj::dragonbox::charconv::chars_format::scientific);
+        });
+    }
+
+    template <class Float>
+    std::uint64_t dragonbox_charconv_general_frame(Float const* x, std::size_t count) {
+        return write_into_frame(x, count, [](char* first, char* last, Float y) {
+            return jkj::dragonbox::charconv::to_chars(
+                first, last, y, jkj::dragonbox::charconv::chars_format::general);
+        });
+    }
+
+    template <class Float>
+    std::uint64_t dragonbox_charconv_scientific_6_frame(Float const* x, std::size_t count) {
+        return write_into_frame(x, count, [](char* first, char* last, Float y) {
+            return jkj::dragonbox::charconv::to_chars(
+                first, last, y, jkj::dragonbox::charconv::chars_format::scientific, 6);
+        });
+    }
+
+#if 1
+    auto dummy_batch_charconv = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox charconv::to_chars (4 KiB frame)", dragonbox_charconv_frame<float>,
+                dragonbox_charconv_frame<double>};
+    }();
+    auto dummy_batch_copy = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n + copy (4 KiB frame)", dragonbox_to_chars_n_copy_frame<float>,
+                dragonbox_to_chars_n_copy_frame<double>};
+    }();
+    auto dummy_batch_charconv_scientific = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox charconv::to_chars scientific (4 KiB frame)",
+                dragonbox_charconv_scientific_frame<float>,
+                dragonbox_charconv_scientific_frame<double>};
+    }();
+    auto dummy_batch_charconv_general = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox charconv::to_chars general (4 KiB frame)",
+                dragonbox_charconv_general_frame<float>, dragonbox_charconv_general_frame<double>};
+    }();
+    auto dummy_batch_charconv_scientific_6 = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox charconv::to_chars scientific, precision 6 (4 KiB frame)",
+                dragonbox_charconv_scientific_6_frame<float>,
+                dragonbox_charconv_scientific_6_frame<double>};
+    }();
+#endif
+
+    // Writes the digits directly into a buffer of CharT.
+    template <class Float, class CharT>
+    std::uint64_t dragonbox_to_chars_n_wide(Float const* x, std::size_t count) {
+        CharT buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const end = jkj::dragonbox::to_chars_n(x[i], buffer);
+            checksum += std::uint64_t(end - buffer) + std::uint64_t(end[-1]);
+        }
+        return checksum;
+    }
+
+    // The widening pass: formats into a char buffer, and then converts it into CharT.
+    template <class Float, class CharT>
+    std::uint64_t dragonbox_to_chars_n_then_widen(Float const* x, std::size_t count) {
+        char temp[64];
+        CharT buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const temp_end = jkj::dragonbox::to_chars_n(x[i], temp);
+            auto end = buffer;
+            for (char const* ptr = temp; ptr != temp_end; ++ptr) {
+                *end++ = CharT(*ptr);
+            }
+            checksum += std::uint64_t(end - buffer) + std::uint64_t(end[-1]);
+        }
+        return checksum;
+    }
+
+#if 1
+    auto dummy_batch_char16 = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n (char16_t)", dragonbox_to_chars_n_wide<float, char16_t>,
+                dragonbox_to_chars_n_wide<double, char16_t>};
+    }();
+    auto dummy_batch_char16_widen = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n + widen into char16_t",
+                dragonbox_to_chars_n_then_widen<float, char16_t>,
+                dragonbox_to_chars_n_then_widen<double, char16_t>};
+    }();
+    auto dummy_batch_char32 = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n (char32_t)", dragonbox_to_chars_n_wide<float, char32_t>,
+                dragonbox_to_chars_n_wide<double, char32_t>};
+    }();
+    auto dummy_batch_char32_widen = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n + widen into char32_t",
+                dragonbox_to_chars_n_then_widen<float, char32_t>,
+                dragonbox_to_chars_n_then_widen<double, char32_t>};
+    }();
+    auto dummy_batch_wchar = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n (wchar_t)", dragonbox_to_chars_n_wide<float, wchar_t>,
+                dragonbox_to_chars_n_wide<double, wchar_t>};
+    }();
+#endif
+
+    // A std::string per value, which allocates if the output does not fit into the small buffer.
+    template <class Float>
+    std::uint64_t dragonbox_to_chars_n_into_std_string(Float const* x, std::size_t count) {
+        char buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string const str(buffer, jkj::dragonbox::to_chars_n(x[i], buffer));
+            checksum += std::uint64_t(str.size()) + std::uint64_t(str.back());
+        }
+        return checksum;
+    }
+
+    template <class Float>
+    std::uint64_t dragonbox_to_string(Float const* x, std::size_t count) {
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const str = jkj::dragonbox::to_string(x[i]);
+            checksum += std::uint64_t(str.size()) + std::uint64_t(str[str.size() - 1]);
+        }
+        return checksum;
+    }
+
+    // Appends everything into one string, which is cleared every 1000 values.
+    template <class Float>
+    std::uint64_t dragonbox_append_to(Float const* x, std::size_t count) {
+        static std::string str;
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i % 1000 == 0) {
+                checksum += std::uint64_t(str.size());
+                str.clear();
+            }
+            jkj::dragonbox::append_to(str, x[i]);
+        }
+        return checksum + std::uint64_t(str.size());
+    }
+
+#if 1
+    auto dummy_batch_std_string = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n + std::string", dragonbox_to_chars_n_into_std_string<float>,
+                dragonbox_to_chars_n_into_std_string<double>};
+    }();
+    auto dummy_batch_to_string = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_string", dragonbox_to_string<float>, dragonbox_to_string<double>};
+    }();
+    auto dummy_batch_append_to = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox append_to", dragonbox_append_to<float>, dragonbox_append_to<double>};
+    }();
+#endif
+
+    std::uint64_t dragonbox_to_decimal_n(float const* x, std::size_t count) {
+        static std::vector<jkj::dragonbox::binary32_decimal_fp> results;
+        results.resize(count);
+        jkj::dragonbox::to_decimal_n(x, results.data(), count);
+
+        std::uint64_t checksum = 0;
+        for (auto const& result : results) {
+            checksum += std::uint64_t(result.significand) + std::uint64_t(result.exponent);
+        }
+        return checksum;
+    }
+
+#if 1
+    auto dummy_batch_n = []() -> register_batch_function_for_benchmark {
+        return {jkj::dragonbox::to_decimal_n_uses_avx512() ? "Dragonbox to_decimal_n (AVX-512)"
+                                                           : "Dragonbox to_decimal_n (scalar)",
+                dragonbox_to_decimal_n};
+    }();
+#endif
 }
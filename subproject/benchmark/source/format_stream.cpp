@@ -0,0 +1,129 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "benchmark.h"
+#include "dragonbox/dragonbox_stream.h"
+
+#if defined(JKJ_HAS_DRAGONBOX_FORMAT_STREAM) && defined(__has_include)
+    #if __has_include(<sys/socket.h>) && __has_include(<fcntl.h>) && __has_include(<unistd.h>)
+        #define DRAGONBOX_BENCHMARK_SOCKETPAIR 1
+    #endif
+#endif
+
+#if defined(DRAGONBOX_BENCHMARK_SOCKETPAIR)
+    #include <cerrno>
+    #include <string>
+    #include <fcntl.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+
+namespace {
+    // A non-blocking local socketpair. The sender drains the other end whenever the socket buffer
+    // is full, so the measurements include the system calls and the copies through the kernel.
+    class local_socket {
+    public:
+        local_socket() {
+            if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds_) == 0) {
+                ::fcntl(fds_[0], F_SETFL, ::fcntl(fds_[0], F_GETFL) | O_NONBLOCK);
+                ::fcntl(fds_[1], F_SETFL, ::fcntl(fds_[1], F_GETFL) | O_NONBLOCK);
+            }
+        }
+        ~local_socket() {
+            ::close(fds_[0]);
+            ::close(fds_[1]);
+        }
+
+        static local_socket& get() {
+            static local_socket socket;
+            return socket;
+        }
+
+        // Returns the number of bytes received.
+        std::uint64_t send(char const* data, std::size_t size) {
+            std::uint64_t received = 0;
+            while (size != 0) {
+                auto const written = ::write(fds_[0], data, size);
+                if (written > 0) {
+                    data += written;
+                    size -= std::size_t(written);
+                }
+                else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    received += receive();
+                }
+                else {
+                    break;
+                }
+            }
+            return received;
+        }
+
+        std::uint64_t receive() {
+            char buffer[65536];
+            std::uint64_t received = 0;
+            for (;;) {
+                auto const read = ::read(fds_[1], buffer, sizeof(buffer));
+                if (read <= 0) {
+                    return received;
+                }
+                received += std::uint64_t(read);
+            }
+        }
+
+    private:
+        int fds_[2] = {-1, -1};
+    };
+
+    constexpr std::size_t chunk_size = 65536;
+
+    template <class Float>
+    std::uint64_t dragonbox_format_stream_into_socket(Float const* x, std::size_t count) {
+        auto& socket = local_socket::get();
+        std::uint64_t received = 0;
+        for (auto const chunk :
+             jkj::dragonbox::format_stream(std::span<Float const>(x, count), chunk_size)) {
+            received += socket.send(chunk.data(), chunk.size());
+        }
+        return received + socket.receive();
+    }
+
+    // The whole text is materialized before being sent.
+    template <class Float>
+    std::uint64_t dragonbox_to_chars_n_into_string_then_socket(Float const* x, std::size_t count) {
+        auto& socket = local_socket::get();
+        std::string text;
+        char buffer[64];
+        for (std::size_t i = 0; i < count; ++i) {
+            text.append(buffer, jkj::dragonbox::to_chars_n(x[i], buffer));
+            text += '\n';
+        }
+        return socket.send(text.data(), text.size()) + socket.receive();
+    }
+
+    #if 1
+    auto dummy_batch_format_stream = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox format_stream into a socketpair",
+                dragonbox_format_stream_into_socket<float>,
+                dragonbox_format_stream_into_socket<double>};
+    }();
+    auto dummy_batch_materialized = []() -> register_batch_function_for_benchmark {
+        return {"Dragonbox to_chars_n into a string, then into a socketpair",
+                dragonbox_to_chars_n_into_string_then_socket<float>,
+                dragonbox_to_chars_n_into_string_then_socket<double>};
+    }();
+    #endif
+}
+#endif
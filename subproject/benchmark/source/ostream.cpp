@@ -0,0 +1,100 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "benchmark.h"
+#include "dragonbox/dragonbox_num_put.h"
+#include <locale>
+#include <sstream>
+
+namespace {
+    // Writes the values separated by spaces into an std::ostringstream imbued with locale, going
+    // back to the beginning every 256 values so that the buffer stays small.
+    template <class Float>
+    std::uint64_t write_into_ostringstream(Float const* x, std::size_t count,
+                                           std::locale const& locale, std::streamsize precision) {
+        static std::ostringstream stream;
+        stream.imbue(locale);
+        stream.precision(precision);
+        stream.seekp(0);
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            stream << x[i] << ' ';
+            if (i % 256 == 255) {
+                checksum += std::uint64_t(stream.tellp());
+                stream.seekp(0);
+            }
+        }
+        return checksum + std::uint64_t(stream.tellp());
+    }
+
+    std::locale const& dragonbox_locale() {
+        static std::locale const locale{std::locale::classic(), new jkj::dragonbox::num_put<>};
+        return locale;
+    }
+
+    std::locale const& dragonbox_shortest_locale() {
+        static std::locale const locale{std::locale::classic(), new jkj::dragonbox::num_put<>(true)};
+        return locale;
+    }
+
+    template <class Float>
+    std::uint64_t ostringstream_std(Float const* x, std::size_t count) {
+        return write_into_ostringstream(x, count, std::locale::classic(), 6);
+    }
+
+    template <class Float>
+    std::uint64_t ostringstream_dragonbox(Float const* x, std::size_t count) {
+        return write_into_ostringstream(x, count, dragonbox_locale(), 6);
+    }
+
+    template <class Float>
+    std::uint64_t ostringstream_std_17(Float const* x, std::size_t count) {
+        return write_into_ostringstream(x, count, std::locale::classic(), 17);
+    }
+
+    template <class Float>
+    std::uint64_t ostringstream_dragonbox_17(Float const* x, std::size_t count) {
+        return write_into_ostringstream(x, count, dragonbox_locale(), 17);
+    }
+
+    template <class Float>
+    std::uint64_t ostringstream_dragonbox_shortest(Float const* x, std::size_t count) {
+        return write_into_ostringstream(x, count, dragonbox_shortest_locale(), 6);
+    }
+
+#if 1
+    auto dummy_std = []() -> register_batch_function_for_benchmark {
+        return {"std::ostringstream <<", ostringstream_std<float>, ostringstream_std<double>};
+    }();
+    auto dummy_dragonbox = []() -> register_batch_function_for_benchmark {
+        return {"std::ostringstream << with jkj::dragonbox::num_put",
+                ostringstream_dragonbox<float>, ostringstream_dragonbox<double>};
+    }();
+    auto dummy_std_17 = []() -> register_batch_function_for_benchmark {
+        return {"std::ostringstream << (precision 17)", ostringstream_std_17<float>,
+                ostringstream_std_17<double>};
+    }();
+    auto dummy_dragonbox_17 = []() -> register_batch_function_for_benchmark {
+        return {"std::ostringstream << (precision 17) with jkj::dragonbox::num_put",
+                ostringstream_dragonbox_17<float>, ostringstream_dragonbox_17<double>};
+    }();
+    auto dummy_dragonbox_shortest = []() -> register_batch_function_for_benchmark {
+        return {"std::ostringstream << with jkj::dragonbox::num_put (shortest)",
+                ostringstream_dragonbox_shortest<float>, ostringstream_dragonbox_shortest<double>};
+    }();
+#endif
+}
@@ -0,0 +1,81 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "benchmark.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+    // The shortest precisions that guarantee round trip, not the shortest representations.
+    void snprintf_float(float x, char* buffer) { std::snprintf(buffer, 40, "%.9g", double(x)); }
+    void snprintf_double(double x, char* buffer) { std::snprintf(buffer, 40, "%.17g", x); }
+
+#if 1
+    auto dummy = []() -> register_function_for_benchmark {
+        return {"snprintf", snprintf_float, snprintf_double};
+    }();
+#endif
+
+    // Compare with "Dragonbox to_chars_n_capped (7 digits)".
+    template <class Float>
+    std::uint64_t snprintf_7g(Float const* x, std::size_t count) {
+        char buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            checksum += std::uint64_t(std::snprintf(buffer, sizeof(buffer), "%.7g", double(x[i])));
+        }
+        return checksum;
+    }
+
+#if 1
+    auto dummy_batch_7g = []() -> register_batch_function_for_benchmark {
+        return {"snprintf %.7g", snprintf_7g<float>, snprintf_7g<double>};
+    }();
+#endif
+
+    // Compare with "Dragonbox to_chars_hex_n" and "Dragonbox to_chars_hex_n + from_chars_hex".
+    template <class Float>
+    std::uint64_t snprintf_a(Float const* x, std::size_t count) {
+        char buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            checksum += std::uint64_t(std::snprintf(buffer, sizeof(buffer), "%a", double(x[i])));
+        }
+        return checksum;
+    }
+
+    template <class Float>
+    std::uint64_t snprintf_a_strtod(Float const* x, std::size_t count) {
+        char buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::snprintf(buffer, sizeof(buffer), "%a", double(x[i]));
+            checksum += Float(std::strtod(buffer, nullptr)) == x[i] ? 1 : 0;
+        }
+        return checksum;
+    }
+
+#if 1
+    auto dummy_batch_a = []() -> register_batch_function_for_benchmark {
+        return {"snprintf %a", snprintf_a<float>, snprintf_a<double>};
+    }();
+    auto dummy_batch_a_strtod = []() -> register_batch_function_for_benchmark {
+        return {"snprintf %a + strtod", snprintf_a_strtod<float>, snprintf_a_strtod<double>};
+    }();
+#endif
+}
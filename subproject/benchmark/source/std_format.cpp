@@ -0,0 +1,56 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "benchmark.h"
+#include "dragonbox/dragonbox_format.h"
+
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+namespace {
+    // Same as the {fmt} ones in fmt.cpp.
+    template <class Float>
+    std::uint64_t std_format_to_aligned(Float const* x, std::size_t count) {
+        char buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            checksum += std::uint64_t(std::format_to(buffer, "{:>24}", x[i]) - buffer);
+        }
+        return checksum;
+    }
+
+    template <class Float>
+    std::uint64_t std_format_to_aligned_dragonbox(Float const* x, std::size_t count) {
+        char buffer[64];
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            checksum += std::uint64_t(
+                std::format_to(buffer, "{:>24}", jkj::dragonbox::shortest(x[i])) - buffer);
+        }
+        return checksum;
+    }
+
+    #if 1
+    auto dummy_batch = []() -> register_batch_function_for_benchmark {
+        return {"std::format_to {:>24}", std_format_to_aligned<float>,
+                std_format_to_aligned<double>};
+    }();
+    auto dummy_batch_dragonbox = []() -> register_batch_function_for_benchmark {
+        return {"std::format_to {:>24} with jkj::dragonbox::shortest",
+                std_format_to_aligned_dragonbox<float>, std_format_to_aligned_dragonbox<double>};
+    }();
+    #endif
+}
+#endif
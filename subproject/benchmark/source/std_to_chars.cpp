@@ -0,0 +1,102 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "benchmark.h"
+#include <charconv>
+#include <cstdint>
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+namespace {
+    void std_to_chars_float(float x, char* buffer) {
+        *std::to_chars(buffer, buffer + 40, x).ptr = '\0';
+    }
+    void std_to_chars_double(double x, char* buffer) {
+        *std::to_chars(buffer, buffer + 40, x).ptr = '\0';
+    }
+
+    #if 1
+    auto dummy = []() -> register_function_for_benchmark {
+        return {"std::to_chars", std_to_chars_float, std_to_chars_double};
+    }();
+    #endif
+
+    // Same as write_into_frame in dragonbox.cpp.
+    template <class Float, class Format>
+    std::uint64_t write_into_frame(Float const* x, std::size_t count, Format const& format) {
+        static char frame[4096];
+        char* ptr = frame;
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto result = format(ptr, frame + sizeof(frame), x[i]);
+            if (result.ec != std::errc{}) {
+                checksum += std::uint64_t(ptr - frame);
+                ptr = frame;
+                result = format(ptr, frame + sizeof(frame), x[i]);
+            }
+            ptr = result.ptr;
+        }
+        return checksum + std::uint64_t(ptr - frame);
+    }
+
+    template <class Float>
+    std::uint64_t std_to_chars_frame(Float const* x, std::size_t count) {
+        return write_into_frame(x, count, [](char* first, char* last, Float y) {
+            return std::to_chars(first, last, y);
+        });
+    }
+
+    template <class Float>
+    std::uint64_t std_to_chars_scientific_frame(Float const* x, std::size_t count) {
+        return write_into_frame(x, count, [](char* first, char* last, Float y) {
+            return std::to_chars(first, last, y, std::chars_format::scientific);
+        });
+    }
+
+    template <class Float>
+    std::uint64_t std_to_chars_general_frame(Float const* x, std::size_t count) {
+        return write_into_frame(x, count, [](char* first, char* last, Float y) {
+            return std::to_chars(first, last, y, std::chars_format::general);
+        });
+    }
+
+    template <class Float>
+    std::uint64_t std_to_chars_scientific_6_frame(Float const* x, std::size_t count) {
+        return write_into_frame(x, count, [](char* first, char* last, Float y) {
+            return std::to_chars(first, last, y, std::chars_format::scientific, 6);
+        });
+    }
+
+    #if 1
+    auto dummy_batch_frame = []() -> register_batch_function_for_benchmark {
+        return {"std::to_chars (4 KiB frame)", std_to_chars_frame<float>,
+                std_to_chars_frame<double>};
+    }();
+    auto dummy_batch_scientific = []() -> register_batch_function_for_benchmark {
+        return {"std::to_chars scientific (4 KiB frame)", std_to_chars_scientific_frame<float>,
+                std_to_chars_scientific_frame<double>};
+    }();
+    auto dummy_batch_general = []() -> register_batch_function_for_benchmark {
+        return {"std::to_chars general (4 KiB frame)", std_to_chars_general_frame<float>,
+                std_to_chars_general_frame<double>};
+    }();
+    auto dummy_batch_scientific_6 = []() -> register_batch_function_for_benchmark {
+        return {"std::to_chars scientific, precision 6 (4 KiB frame)",
+                std_to_chars_scientific_6_frame<float>, std_to_chars_scientific_6_frame<double>};
+    }();
+    #endif
+}
+#endif
@@ -0,0 +1,261 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_BID_REFERENCE
+#define JKJ_HEADER_BID_REFERENCE
+
+#include "dragonbox/dragonbox_bid.h"
+#include "dragonbox/dragonbox_to_chars.h"
+#include "big_uint.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Reference implementation going through the output of to_chars: parse the digits, round them to
+// the precision of the decimal format on the string, and then encode. The binary number is rounded
+// correctly, so if the digits rounded off are exactly one-half, the direction is decided by
+// comparing the binary number with the parsed digits exactly.
+struct reference_format {
+    int total_bits;
+    int exponent_bits;
+    int precision;
+    int min_exponent;
+    int max_exponent;
+    int exponent_bias;
+};
+
+constexpr reference_format decimal32_format = {32, 8, 7, -101, 90, 101};
+constexpr reference_format decimal64_format = {64, 10, 16, -398, 369, 398};
+constexpr reference_format decimal128_format = {128, 14, 34, -6176, 6111, 6176};
+
+struct reference_bits {
+    std::uint64_t high;
+    std::uint64_t low;
+
+    bool operator==(reference_bits const& other) const {
+        return high == other.high && low == other.low;
+    }
+};
+
+// Removes the last count digits (count <= digits.size()) and rounds. comparison is the sign of
+// x - (digits), which decides the direction when the digits removed are exactly one-half; if x is
+// exactly on the half, round-half-to-even applies.
+inline void round_off_digits(std::string& digits, std::size_t count, int comparison) {
+    auto const kept = digits.size() - count;
+    auto const dropped = digits.substr(kept);
+    digits.resize(kept);
+    if (dropped.empty()) {
+        return;
+    }
+
+    bool round_up = false;
+    if (dropped[0] > '5') {
+        round_up = true;
+    }
+    else if (dropped[0] == '5') {
+        bool const is_tie = dropped.find_first_not_of('0', 1) == std::string::npos;
+        bool const is_odd = !digits.empty() && (digits.back() - '0') % 2 != 0;
+        round_up = !is_tie || comparison > 0 || (comparison == 0 && is_odd);
+    }
+
+    if (round_up) {
+        auto i = digits.size();
+        while (i > 0 && digits[i - 1] == '9') {
+            digits[--i] = '0';
+        }
+        if (i == 0) {
+            digits.insert(digits.begin(), '1');
+        }
+        else {
+            ++digits[i - 1];
+        }
+    }
+}
+
+// The output of to_chars, parsed.
+struct parsed_decimal {
+    bool is_negative;
+    char special; // 'N' for NaN, 'I' for Infinity, 0 otherwise
+    std::string digits;
+    int exponent;
+};
+
+// to_chars doesn't print the sign of NaN's, so the sign is taken from x.
+template <class Float>
+parsed_decimal parse_to_chars_output(Float x) {
+    char buffer[64];
+    jkj::dragonbox::to_chars(x, buffer);
+    char const* str = buffer;
+
+    parsed_decimal result{std::signbit(x), 0, {}, 0};
+    if (str[0] == '-') {
+        ++str;
+    }
+    if (str[0] == 'N' || str[0] == 'I') {
+        result.special = str[0];
+        return result;
+    }
+
+    // [-]d[.ddd]E[-]ddd
+    for (; *str != 'E'; ++str) {
+        if (*str != '.') {
+            result.digits.push_back(*str);
+        }
+    }
+    result.exponent = std::atoi(str + 1) - int(result.digits.size()) + 1;
+    if (result.digits == "0") {
+        result.exponent = 0;
+    }
+    return result;
+}
+
+// The sign of |x| - digits * 10^exponent, computed exactly.
+template <class Float>
+int compare_exactly(Float x, parsed_decimal const& parsed) {
+    int binary_exponent;
+    auto const fraction = std::frexp(std::fabs(x), &binary_exponent);
+    jkj::big_uint lhs{std::uint64_t(std::ldexp(fraction, 64))};
+    jkj::big_uint rhs{std::uint64_t(std::stoull(parsed.digits))};
+    binary_exponent -= 64;
+
+    if (parsed.exponent >= 0) {
+        rhs = rhs * jkj::big_uint::pow(5, std::size_t(parsed.exponent));
+    }
+    else {
+        lhs = lhs * jkj::big_uint::pow(5, std::size_t(-parsed.exponent));
+    }
+    if (binary_exponent >= parsed.exponent) {
+        lhs = lhs * jkj::big_uint::power_of_2(std::size_t(binary_exponent - parsed.exponent));
+    }
+    else {
+        rhs = rhs * jkj::big_uint::power_of_2(std::size_t(parsed.exponent - binary_exponent));
+    }
+    return lhs < rhs ? -1 : lhs == rhs ? 0 : 1;
+}
+
+inline reference_bits reference_encode(reference_format const& format, parsed_decimal parsed,
+                                       int comparison) {
+    auto const sign = std::uint64_t(parsed.is_negative ? 1 : 0) << ((format.total_bits - 1) % 64);
+    auto special = [&](std::uint64_t top_byte) -> reference_bits {
+        if (format.total_bits == 128) {
+            return {sign | (top_byte << 56), 0};
+        }
+        return {0, sign | (top_byte << (format.total_bits - 8))};
+    };
+    if (parsed.special == 'N') {
+        return special(0x7c);
+    }
+    if (parsed.special == 'I') {
+        return special(0x78);
+    }
+
+    auto& digits = parsed.digits;
+    auto exponent = parsed.exponent;
+    if (digits != "0") {
+        // Digits are rounded off for the precision and for the minimum exponent at once.
+        auto count = int(digits.size()) > format.precision
+                         ? std::size_t(int(digits.size()) - format.precision)
+                         : std::size_t(0);
+        if (exponent + int(count) < format.min_exponent) {
+            count = std::size_t(format.min_exponent - exponent);
+        }
+        if (count > digits.size()) {
+            digits = "0";
+            exponent += int(count);
+        }
+        else if (count != 0) {
+            round_off_digits(digits, count, comparison);
+            exponent += int(count);
+            if (digits.empty()) {
+                digits = "0";
+            }
+            else if (int(digits.size()) > format.precision) {
+                digits.pop_back();
+                ++exponent;
+            }
+        }
+        if (exponent > format.max_exponent) {
+            auto const count_zeros = std::size_t(exponent - format.max_exponent);
+            if (digits.size() + count_zeros > std::size_t(format.precision)) {
+                return special(0x78);
+            }
+            digits.append(count_zeros, '0');
+            exponent = format.max_exponent;
+        }
+    }
+
+    std::uint64_t coefficient = 0;
+    for (auto c : digits) {
+        coefficient = coefficient * 10 + std::uint64_t(c - '0');
+    }
+    auto const biased_exponent = std::uint64_t(exponent + format.exponent_bias);
+
+    if (format.total_bits == 128) {
+        return {sign | (biased_exponent << (64 - 1 - format.exponent_bits)), coefficient};
+    }
+    auto const coefficient_bits = format.total_bits - 1 - format.exponent_bits;
+    if (coefficient < (std::uint64_t(1) << coefficient_bits)) {
+        return {0, sign | (biased_exponent << coefficient_bits) | coefficient};
+    }
+    return {0, sign | (std::uint64_t(3) << (format.total_bits - 3)) |
+                   (biased_exponent << (coefficient_bits - 2)) |
+                   (coefficient & ((std::uint64_t(1) << (coefficient_bits - 2)) - 1))};
+}
+
+// Compares a computed encoding with the reference, and reports the first 10 mismatches.
+inline bool check_bid_format(parsed_decimal const& parsed, int comparison, reference_bits computed,
+                             reference_format const& format, char const* name,
+                             std::size_t& number_of_errors) {
+    auto const expected = reference_encode(format, parsed, comparison);
+    if (computed == expected) {
+        return true;
+    }
+    if (++number_of_errors <= 10) {
+        std::cout << "Error detected! [Input = " << (parsed.is_negative ? "-" : "")
+                  << (parsed.special != 0 ? std::string(1, parsed.special) : parsed.digits)
+                  << "E" << parsed.exponent << ", " << name << ", expected = 0x" << std::hex
+                  << std::setfill('0') << std::setw(16) << expected.high << std::setw(16)
+                  << expected.low << ", computed = 0x" << std::setw(16) << computed.high
+                  << std::setw(16) << computed.low << std::dec << std::setfill(' ') << "]\n";
+    }
+    return false;
+}
+
+// Checks to_bid64(x), to_bid128(x) and the given decimal32 encoding bid32 of x against the
+// reference.
+template <class Float>
+bool check_all_bid_formats(Float x, std::uint32_t bid32, std::size_t& number_of_errors) {
+    auto const parsed = parse_to_chars_output(x);
+    // The digits rounded off can be exactly one-half only if the last digit is 5, since to_chars
+    // prints no trailing zeros.
+    auto const comparison =
+        parsed.special == 0 && parsed.digits.back() == '5' ? compare_exactly(x, parsed) : 0;
+    auto const bid128 = jkj::dragonbox::to_bid128(x);
+    bool success = check_bid_format(parsed, comparison, {0, bid32}, decimal32_format, "decimal32",
+                                    number_of_errors);
+    success &= check_bid_format(parsed, comparison, {0, jkj::dragonbox::to_bid64(x)},
+                                decimal64_format, "decimal64", number_of_errors);
+    success &= check_bid_format(parsed, comparison, {bid128.high, bid128.low}, decimal128_format,
+                                "decimal128", number_of_errors);
+    return success;
+}
+
+#endif
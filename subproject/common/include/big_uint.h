@@ -18,6 +18,7 @@
 #ifndef JKJ_HEADER_BIG_UINT
 #define JKJ_HEADER_BIG_UINT
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <initializer_list>
@@ -25,14 +26,156 @@
 #include <vector>
 
 namespace jkj {
+    namespace detail {
+        // A vector of a trivially copyable type holding up to InlineCapacity elements without
+        // a heap allocation. Only the operations big_uint needs are provided.
+        template <class T, std::size_t InlineCapacity>
+        class small_vector {
+        public:
+            using value_type = T;
+            using iterator = T*;
+            using const_iterator = T const*;
+
+            small_vector() noexcept = default;
+            explicit small_vector(std::size_t count) { resize(count); }
+            template <class Iter, class = typename std::iterator_traits<Iter>::iterator_category>
+            small_vector(Iter first, Iter last) {
+                insert(end(), first, last);
+            }
+            small_vector(small_vector const& other) { assign(other.begin(), other.size()); }
+            small_vector(small_vector&& other) noexcept { steal(other); }
+            small_vector& operator=(small_vector const& other) {
+                if (this != &other) {
+                    size_ = 0;
+                    assign(other.begin(), other.size());
+                }
+                return *this;
+            }
+            small_vector& operator=(small_vector&& other) noexcept {
+                if (this != &other) {
+                    release();
+                    steal(other);
+                }
+                return *this;
+            }
+            ~small_vector() { release(); }
+
+            std::size_t size() const noexcept { return size_; }
+            bool empty() const noexcept { return size_ == 0; }
+
+            T* data() noexcept { return data_; }
+            T const* data() const noexcept { return data_; }
+            T* begin() noexcept { return data_; }
+            T const* begin() const noexcept { return data_; }
+            T const* cbegin() const noexcept { return data_; }
+            T* end() noexcept { return data_ + size_; }
+            T const* end() const noexcept { return data_ + size_; }
+            T const* cend() const noexcept { return data_ + size_; }
+
+            T& operator[](std::size_t idx) noexcept { return data_[idx]; }
+            T const& operator[](std::size_t idx) const noexcept { return data_[idx]; }
+            T& back() noexcept { return data_[size_ - 1]; }
+            T const& back() const noexcept { return data_[size_ - 1]; }
+
+            void reserve(std::size_t new_capacity) {
+                if (new_capacity > capacity_) {
+                    auto const new_data = new T[new_capacity];
+                    std::copy(data_, data_ + size_, new_data);
+                    release();
+                    data_ = new_data;
+                    capacity_ = new_capacity;
+                }
+            }
+            void resize(std::size_t new_size, T const& value = T()) {
+                grow_for(new_size);
+                if (new_size > size_) {
+                    std::fill(data_ + size_, data_ + new_size, value);
+                }
+                size_ = new_size;
+            }
+            void clear() noexcept { size_ = 0; }
+            void push_back(T const& value) {
+                grow_for(size_ + 1);
+                data_[size_++] = value;
+            }
+            void pop_back() noexcept { --size_; }
+
+            template <class Iter>
+            T* insert(T const* pos, Iter first, Iter last) {
+                auto const offset = std::size_t(pos - data_);
+                auto const count = std::size_t(std::distance(first, last));
+                grow_for(size_ + count);
+                std::copy_backward(data_ + offset, data_ + size_, data_ + size_ + count);
+                std::copy(first, last, data_ + offset);
+                size_ += count;
+                return data_ + offset;
+            }
+            T* erase(T const* first, T const* last) noexcept {
+                auto const offset = std::size_t(first - data_);
+                auto const count = std::size_t(last - first);
+                std::copy(data_ + offset + count, data_ + size_, data_ + offset);
+                size_ -= count;
+                return data_ + offset;
+            }
+
+            bool operator==(small_vector const& other) const noexcept {
+                return size_ == other.size_ && std::equal(data_, data_ + size_, other.data_);
+            }
+            bool operator!=(small_vector const& other) const noexcept { return !(*this == other); }
+
+        private:
+            // Grows the capacity geometrically, as std::vector does.
+            void grow_for(std::size_t required) {
+                if (required > capacity_) {
+                    reserve(std::max(required, 2 * capacity_));
+                }
+            }
+            void assign(T const* first, std::size_t count) {
+                grow_for(count);
+                std::copy(first, first + count, data_);
+                size_ = count;
+            }
+            void steal(small_vector& other) noexcept {
+                if (other.data_ == other.inline_elements_) {
+                    std::copy(other.data_, other.data_ + other.size_, inline_elements_);
+                    data_ = inline_elements_;
+                    capacity_ = InlineCapacity;
+                }
+                else {
+                    data_ = other.data_;
+                    capacity_ = other.capacity_;
+                    other.data_ = other.inline_elements_;
+                    other.capacity_ = InlineCapacity;
+                }
+                size_ = other.size_;
+                other.size_ = 0;
+            }
+            void release() noexcept {
+                if (data_ != inline_elements_) {
+                    delete[] data_;
+                    data_ = inline_elements_;
+                    capacity_ = InlineCapacity;
+                }
+            }
+
+            T* data_ = inline_elements_;
+            std::size_t size_ = 0;
+            std::size_t capacity_ = InlineCapacity;
+            T inline_elements_[InlineCapacity];
+        };
+    }
+
     class big_uint {
     public:
         using element_type = std::uint64_t;
         static constexpr std::size_t element_number_of_bits = 64;
 
     private:
-        // Least significant element first.
-        std::vector<element_type> elements;
+        // Least significant element first. Numbers up to 256 bits, e.g. the cache entries, are
+        // stored inline.
+        detail::small_vector<element_type, 4> elements;
+
+        friend struct big_uint_arithmetic;
 
     public:
         // elements is empty if and only if it represents 0.
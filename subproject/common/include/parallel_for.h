@@ -0,0 +1,208 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_PARALLEL_FOR
+#define JKJ_HEADER_PARALLEL_FOR
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jkj {
+    // Command-line options of the verification programs:
+    //   --threads=<n>               Number of worker threads; all hardware threads by default.
+    //   --format=<name>             Verify only the given format, e.g. binary64.
+    //   --exponents=<first>:<last>  Verify only the binary exponents e in [first, last], e.g.
+    //                               those whose cache entries have been changed.
+    struct verification_options {
+        unsigned int number_of_threads = 0;
+        std::string format;
+        bool has_exponent_range = false;
+        int first_exponent = 0;
+        int last_exponent = 0;
+
+        bool includes_format(char const* name) const { return format.empty() || format == name; }
+
+        // Narrows [min_exponent, max_exponent] down to the requested range, and returns false if
+        // nothing is left.
+        bool restrict_exponents(int& min_exponent, int& max_exponent) const {
+            if (has_exponent_range) {
+                min_exponent = std::max(min_exponent, first_exponent);
+                max_exponent = std::min(max_exponent, last_exponent);
+            }
+            return min_exponent <= max_exponent;
+        }
+    };
+
+    // Returns false if there is an unknown or malformed argument.
+    inline bool parse_verification_options(int argc, char* argv[], verification_options& options) {
+        auto const starts_with = [](char const* arg, char const* prefix) {
+            return std::strncmp(arg, prefix, std::strlen(prefix)) == 0;
+        };
+        for (int idx = 1; idx < argc; ++idx) {
+            char const* const arg = argv[idx];
+            char* end = nullptr;
+            if (starts_with(arg, "--threads=")) {
+                auto const value = std::strtoul(arg + std::strlen("--threads="), &end, 10);
+                if (*end != '\0' || value == 0) {
+                    return false;
+                }
+                options.number_of_threads = static_cast<unsigned int>(value);
+            }
+            else if (starts_with(arg, "--format=")) {
+                options.format = arg + std::strlen("--format=");
+            }
+            else if (starts_with(arg, "--exponents=")) {
+                options.first_exponent =
+                    int(std::strtol(arg + std::strlen("--exponents="), &end, 10));
+                if (*end != ':') {
+                    return false;
+                }
+                options.last_exponent = int(std::strtol(end + 1, &end, 10));
+                if (*end != '\0' || options.first_exponent > options.last_exponent) {
+                    return false;
+                }
+                options.has_exponent_range = true;
+            }
+            else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Calls compute(i) for each i in [first, last] on worker threads, and then merge(i, result)
+    // on the calling thread in the increasing order of i, so that the merged result does not
+    // depend on the scheduling. Stops as soon as merge returns false. An exception thrown by
+    // compute or merge is rethrown after all workers have stopped. If progress_out is not null,
+    // the percentage of merged indices is written into it in steps of 10%.
+    template <class Compute, class Merge>
+    void ordered_parallel_for(int first, int last, unsigned int number_of_threads,
+                              Compute&& compute, Merge&& merge, std::ostream* progress_out) {
+        using result_type = std::decay_t<decltype(compute(first))>;
+        if (last < first) {
+            return;
+        }
+        auto const count = std::size_t(last - first) + 1;
+        if (number_of_threads == 0) {
+            number_of_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        number_of_threads = unsigned(std::min(std::size_t(number_of_threads), count));
+
+        // Guarded by mutex.
+        std::vector<std::optional<result_type>> results(count);
+        std::size_t next = 0;
+        bool stop = false;
+        std::exception_ptr exception;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+
+        auto const worker = [&] {
+            while (true) {
+                std::size_t idx;
+                {
+                    std::lock_guard<std::mutex> lock{mutex};
+                    if (stop || next == count) {
+                        return;
+                    }
+                    idx = next++;
+                }
+                try {
+                    auto result = compute(first + int(idx));
+                    std::lock_guard<std::mutex> lock{mutex};
+                    results[idx].emplace(std::move(result));
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock{mutex};
+                    if (!exception) {
+                        exception = std::current_exception();
+                    }
+                    stop = true;
+                }
+                cv.notify_all();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(number_of_threads);
+        for (unsigned int i = 0; i < number_of_threads; ++i) {
+            threads.emplace_back(worker);
+        }
+
+        if (progress_out) {
+            *progress_out << "Progress:" << std::flush;
+        }
+        std::size_t reported_percentage = 0;
+        try {
+            for (std::size_t idx = 0; idx < count; ++idx) {
+                std::optional<result_type> result;
+                {
+                    std::unique_lock<std::mutex> lock{mutex};
+                    cv.wait(lock, [&] { return results[idx].has_value() || stop; });
+                    if (!results[idx].has_value()) {
+                        break;
+                    }
+                    result = std::move(results[idx]);
+                    results[idx].reset();
+                }
+                if (!merge(first + int(idx), std::move(*result))) {
+                    break;
+                }
+
+                auto const percentage = (idx + 1) * 10 / count * 10;
+                if (progress_out && percentage > reported_percentage) {
+                    reported_percentage = percentage;
+                    *progress_out << " " << percentage << "%" << std::flush;
+                }
+            }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock{mutex};
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+        if (progress_out) {
+            *progress_out << "\n";
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stop = true;
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+#endif
@@ -73,6 +73,14 @@ inline std::mt19937_64 generate_correctly_seeded_mt19937_64() {
     return std::mt19937_64{seed_seq};
 }
 
+// Deterministic counterpart of the above; the same (seed, stream) pair always produces the same
+// sequence.
+inline std::mt19937_64 generate_seeded_mt19937_64(std::uint64_t seed, std::uint32_t stream = 0) {
+    repeating_seed_seq seed_seq{std::uint32_t(seed & UINT32_C(0xffffffff)),
+                                std::uint32_t(seed >> 32), stream};
+    return std::mt19937_64{seed_seq};
+}
+
 template <class Float, class RandGen>
 Float uniformly_randomly_generate_finite_float(RandGen& rg) {
     using default_float_bit_carrier_conversion_traits =
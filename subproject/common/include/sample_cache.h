@@ -0,0 +1,237 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_SAMPLE_CACHE
+#define JKJ_HEADER_SAMPLE_CACHE
+
+#include "random_float.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define JKJ_SAMPLE_CACHE_HAS_MMAP 1
+#else
+    #define JKJ_SAMPLE_CACHE_HAS_MMAP 0
+#endif
+
+// Persistent cache for randomly generated samples.
+// Generating samples (especially the ones with a given number of digits, which involve string
+// round trips) can take much longer than the actual measurement, so generated sample sets are
+// written to a binary file keyed by the seed and the parameters, and later runs just map the
+// file into memory. The file stores the raw bit patterns in the native byte order, so it can be
+// copied to other little-endian machines to reproduce the exact same sample set.
+
+struct sample_cache_header {
+    static constexpr char magic_string[8] = {'J', 'K', 'J', 'S', 'M', 'P', 'L', '1'};
+
+    char magic[8];
+    std::uint32_t float_bits;
+    // 0 for uniformly random bit patterns, otherwise the number of decimal digits.
+    std::uint32_t digits;
+    std::uint64_t seed;
+    std::uint64_t count;
+
+    bool matches(sample_cache_header const& other) const noexcept {
+        return std::memcmp(magic, other.magic, sizeof(magic)) == 0 &&
+               float_bits == other.float_bits && digits == other.digits && seed == other.seed &&
+               count == other.count;
+    }
+};
+static_assert(sizeof(sample_cache_header) == 32, "the sample data must be 8-byte aligned");
+
+// Read-only view of a sample set, either mapped from a cache file or owned.
+template <class Float>
+class sample_set {
+public:
+    sample_set() = default;
+    sample_set(sample_set const&) = delete;
+    sample_set& operator=(sample_set const&) = delete;
+    sample_set(sample_set&& other) noexcept { swap(other); }
+    sample_set& operator=(sample_set&& other) noexcept {
+        sample_set{std::move(other)}.swap(*this);
+        return *this;
+    }
+    ~sample_set() {
+#if JKJ_SAMPLE_CACHE_HAS_MMAP
+        if (mapping_ != nullptr) {
+            ::munmap(mapping_, mapping_size_);
+        }
+#endif
+    }
+
+    explicit sample_set(std::vector<Float> samples)
+        : owned_(std::move(samples)), data_(owned_.data()), size_(owned_.size()) {}
+
+    Float const* begin() const noexcept { return data_; }
+    Float const* end() const noexcept { return data_ + size_; }
+    Float const* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    Float operator[](std::size_t idx) const noexcept { return data_[idx]; }
+
+    bool is_mapped() const noexcept { return mapping_ != nullptr; }
+
+    void swap(sample_set& other) noexcept {
+        std::swap(mapping_, other.mapping_);
+        std::swap(mapping_size_, other.mapping_size_);
+        owned_.swap(other.owned_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+
+    // Returns an empty set if the file does not exist or does not match the header.
+    static sample_set open(std::filesystem::path const& path, sample_cache_header const& expected) {
+        sample_set result;
+        auto const expected_size = sizeof(sample_cache_header) + expected.count * sizeof(Float);
+
+#if JKJ_SAMPLE_CACHE_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return result;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || std::size_t(st.st_size) != expected_size) {
+            ::close(fd);
+            return result;
+        }
+        void* ptr = ::mmap(nullptr, expected_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (ptr == MAP_FAILED) {
+            return result;
+        }
+
+        result.mapping_ = ptr;
+        result.mapping_size_ = expected_size;
+        sample_cache_header header;
+        std::memcpy(&header, ptr, sizeof(header));
+        if (!header.matches(expected)) {
+            return sample_set{};
+        }
+        result.data_ = reinterpret_cast<Float const*>(static_cast<unsigned char const*>(ptr) +
+                                                      sizeof(sample_cache_header));
+        result.size_ = std::size_t(expected.count);
+#else
+        std::ifstream in{path, std::ios::binary};
+        if (!in) {
+            return result;
+        }
+        sample_cache_header header;
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!in || !header.matches(expected)) {
+            return result;
+        }
+        std::vector<Float> samples(std::size_t(expected.count));
+        in.read(reinterpret_cast<char*>(samples.data()),
+                std::streamsize(samples.size() * sizeof(Float)));
+        if (!in || in.peek() != std::ifstream::traits_type::eof()) {
+            return result;
+        }
+        result = sample_set{std::move(samples)};
+#endif
+        return result;
+    }
+
+private:
+    void* mapping_ = nullptr;
+    std::size_t mapping_size_ = 0;
+    std::vector<Float> owned_;
+    Float const* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+inline std::filesystem::path sample_cache_path(std::filesystem::path const& directory,
+                                               sample_cache_header const& header) {
+    char hex_seed[17];
+    for (int i = 0; i < 16; ++i) {
+        hex_seed[i] = "0123456789abcdef"[(header.seed >> (60 - 4 * i)) & 0xf];
+    }
+    hex_seed[16] = '\0';
+
+    std::string filename = "binary";
+    filename += std::to_string(header.float_bits);
+    filename += "_seed";
+    filename += hex_seed;
+    filename += header.digits == 0 ? std::string("_uniform")
+                                   : "_digits" + std::to_string(header.digits);
+    filename += "_n";
+    filename += std::to_string(header.count);
+    filename += ".bin";
+    return directory / filename;
+}
+
+// Load the sample set keyed by (seed, digits, count) from the given directory, or generate it
+// by calling generate(rg) count times and write it to the directory. The random generator is
+// seeded deterministically from the seed and the number of digits.
+template <class Float, class Generator>
+sample_set<Float> load_or_generate_samples(std::filesystem::path const& directory,
+                                           std::uint64_t seed, unsigned int digits,
+                                           std::size_t count, Generator&& generate) {
+    sample_cache_header header;
+    std::memcpy(header.magic, sample_cache_header::magic_string, sizeof(header.magic));
+    header.float_bits = std::uint32_t(sizeof(Float) * 8);
+    header.digits = std::uint32_t(digits);
+    header.seed = seed;
+    header.count = std::uint64_t(count);
+
+    auto const path = sample_cache_path(directory, header);
+    auto cached = sample_set<Float>::open(path, header);
+    if (cached.size() == count && count != 0) {
+        return cached;
+    }
+
+    auto rg = generate_seeded_mt19937_64(seed, std::uint32_t(digits));
+    std::vector<Float> samples(count);
+    for (auto& sample : samples) {
+        sample = generate(rg);
+    }
+
+    // Write into a temporary file first so that an interrupted run never leaves a broken cache.
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream out{temp_path, std::ios::binary | std::ios::trunc};
+        out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        out.write(reinterpret_cast<char const*>(samples.data()),
+                  std::streamsize(samples.size() * sizeof(Float)));
+        if (!out) {
+            out.close();
+            std::filesystem::remove(temp_path, ec);
+            return sample_set<Float>{std::move(samples)};
+        }
+    }
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+    }
+
+    return sample_set<Float>{std::move(samples)};
+}
+
+#undef JKJ_SAMPLE_CACHE_HAS_MMAP
+
+#endif
@@ -17,6 +17,7 @@
 
 #include "big_uint.h"
 #include "dragonbox/dragonbox.h"
+#include <algorithm>
 #include <cassert>
 #include <limits>
 
@@ -446,143 +447,465 @@ namespace jkj {
         return *this;
     }
 
-    big_uint operator*(big_uint const& x, big_uint const& y) {
-        if (x.is_zero() || y.is_zero()) {
-            return big_uint();
+    // Word-level kernels of the multiplication and the division, working on arrays of elements
+    // (least significant element first) so that the recursive algorithms can operate on parts of
+    // a number without copying them.
+    struct big_uint_arithmetic {
+        using element_type = big_uint::element_type;
+        static constexpr std::size_t element_number_of_bits = big_uint::element_number_of_bits;
+        using buffer_type = detail::small_vector<element_type, 8>;
+
+        // Below these numbers of elements, the schoolbook algorithms are faster.
+        static constexpr std::size_t karatsuba_threshold = 32;
+        static constexpr std::size_t burnikel_ziegler_threshold = 48;
+
+        static auto umul128(element_type x, element_type y) noexcept {
+            return jkj::dragonbox::detail::wuint::umul128(x, y);
+        }
+
+        // out[0, xn) = x + y, where yn <= xn. Returns the carry. out may be the same as x.
+        static element_type add(element_type const* x, std::size_t xn, element_type const* y,
+                                std::size_t yn, element_type* out) noexcept {
+            assert(yn <= xn);
+            element_type carry = 0;
+            std::size_t idx = 0;
+            for (; idx < yn; ++idx) {
+                auto const sum = x[idx] + carry;
+                carry = sum < carry ? 1 : 0;
+                out[idx] = sum + y[idx];
+                carry += out[idx] < sum ? 1 : 0;
+            }
+            for (; idx < xn; ++idx) {
+                out[idx] = x[idx] + carry;
+                carry = out[idx] < carry ? 1 : 0;
+            }
+            return carry;
+        }
+
+        // x[0, xn) -= y, where yn <= xn. Returns the borrow.
+        static element_type subtract(element_type* x, std::size_t xn, element_type const* y,
+                                     std::size_t yn) noexcept {
+            assert(yn <= xn);
+            element_type borrow = 0;
+            std::size_t idx = 0;
+            for (; idx < yn; ++idx) {
+                auto const subtrahend = y[idx] + borrow;
+                borrow = subtrahend < borrow ? 1 : 0;
+                borrow += x[idx] < subtrahend ? 1 : 0;
+                x[idx] -= subtrahend;
+            }
+            for (; idx < xn && borrow != 0; ++idx) {
+                borrow = x[idx] == 0 ? 1 : 0;
+                --x[idx];
+            }
+            return borrow;
         }
 
-        big_uint result;
-        result.elements.resize(x.elements.size() + y.elements.size(), 0);
-        decltype(x.elements) temp(x.elements.size());
-
-        for (std::size_t y_idx = 0; y_idx < y.elements.size(); ++y_idx) {
-            // Compute y.elements[y_idx] * x and accumulate it into the result
-            for (std::size_t x_idx = 0; x_idx < x.elements.size(); ++x_idx) {
-                auto mul = jkj::dragonbox::detail::wuint::umul128(x.elements[x_idx], y.elements[y_idx]);
-
-                // Add the first half
-                result.elements[x_idx + y_idx] += mul.low();
-                unsigned int carry = result.elements[x_idx + y_idx] < mul.low() ? 1 : 0;
-
-                // Add the second half
-                auto with_carry = mul.high() + carry;
-                carry = with_carry < mul.high() ? 1 : 0;
-                result.elements[x_idx + y_idx + 1] += with_carry;
-
-                // If there is carry,
-                if (result.elements[x_idx + y_idx + 1] < with_carry) {
-                    // Propagate.
-                    assert(x_idx + y_idx + 2 < result.elements.size());
-                    for (auto idx = x_idx + y_idx + 2; idx < result.elements.size(); ++idx) {
-                        ++result.elements[idx];
-                        if (result.elements[idx] != 0) {
-                            break;
-                        }
-                    }
-                }
+        // out[0, n) = x << shift, where shift < element_number_of_bits. Returns the bits shifted
+        // out. out may be the same as x.
+        static element_type shift_left_bits(element_type const* x, std::size_t n, std::size_t shift,
+                                            element_type* out) noexcept {
+            if (shift == 0) {
+                std::copy_n(x, n, out);
+                return 0;
             }
+            element_type carry = 0;
+            for (std::size_t idx = 0; idx < n; ++idx) {
+                auto const element = x[idx];
+                out[idx] = (element << shift) | carry;
+                carry = element >> (element_number_of_bits - shift);
+            }
+            return carry;
         }
 
-        // Remove the last element if it is zero.
-        if (result.elements.back() == 0) {
-            result.elements.pop_back();
+        // out[0, n) = x >> shift, where shift < element_number_of_bits. out may be the same as x.
+        static void shift_right_bits(element_type const* x, std::size_t n, std::size_t shift,
+                                     element_type* out) noexcept {
+            if (shift == 0) {
+                std::copy_n(x, n, out);
+                return;
+            }
+            for (std::size_t idx = 0; idx < n; ++idx) {
+                out[idx] = (x[idx] >> shift) |
+                           (idx + 1 < n ? x[idx + 1] << (element_number_of_bits - shift) : 0);
+            }
         }
 
-        return result;
-    }
-
-    big_uint big_uint::long_division(big_uint const& n) {
-        assert(!n.is_zero());
-
-        if (this == &n) {
-            elements.clear();
-            return big_uint(1);
+        // out[0, xn + yn) = x * y.
+        static void multiply_schoolbook(element_type const* x, std::size_t xn, element_type const* y,
+                                        std::size_t yn, element_type* out) noexcept {
+            std::fill_n(out, xn + yn, element_type(0));
+            for (std::size_t y_idx = 0; y_idx < yn; ++y_idx) {
+                // Accumulate y[y_idx] * x into out; x[x_idx] * y[y_idx] + out + carry never
+                // overflows 128 bits.
+                element_type carry = 0;
+                for (std::size_t x_idx = 0; x_idx < xn; ++x_idx) {
+                    auto const mul = umul128(x[x_idx], y[y_idx]);
+                    auto const low = mul.low() + carry;
+                    auto high = mul.high() + (low < carry ? 1 : 0);
+                    out[x_idx + y_idx] += low;
+                    high += out[x_idx + y_idx] < low ? 1 : 0;
+                    carry = high;
+                }
+                out[xn + y_idx] = carry;
+            }
         }
 
-        big_uint quotient;
-        big_uint n_shifted;
-
-        while (true) {
-            // Break if *this is smaller than n.
-            if (elements.size() < n.elements.size()) {
-                break;
+        // out[0, xn + yn) = x * y, by Karatsuba's algorithm for long operands.
+        static void multiply(element_type const* x, std::size_t xn, element_type const* y,
+                             std::size_t yn, element_type* out) {
+            if (xn < yn) {
+                std::swap(x, y);
+                std::swap(xn, yn);
+            }
+            if (yn < karatsuba_threshold) {
+                multiply_schoolbook(x, xn, y, yn, out);
+                return;
             }
 
-            // Shift n element-wise first.
-            n_shifted.elements.resize(elements.size());
-            std::fill_n(n_shifted.elements.begin(), (elements.size() - n.elements.size()), 0);
-            std::copy(n.elements.cbegin(), n.elements.cend(),
-                      n_shifted.elements.begin() + (elements.size() - n.elements.size()));
+            auto const half = (xn + 1) / 2;
+            if (yn <= half) {
+                // Unbalanced operands; multiply y with each yn-element slice of x.
+                std::fill_n(out, xn + yn, element_type(0));
+                std::vector<element_type> product(2 * yn);
+                for (std::size_t offset = 0; offset < xn; offset += yn) {
+                    auto const length = std::min(yn, xn - offset);
+                    multiply(x + offset, length, y, yn, product.data());
+                    add(out + offset, xn + yn - offset, product.data(), length + yn, out + offset);
+                }
+                return;
+            }
 
-            std::size_t total_shift_amount =
-                element_number_of_bits * (elements.size() - n.elements.size());
+            // With x = x1 * B^half + x0 and y = y1 * B^half + y0 where B = 2^64,
+            // x * y = x1 * y1 * B^(2 * half) + z1 * B^half + x0 * y0 where
+            // z1 = (x0 + x1) * (y0 + y1) - x0 * y0 - x1 * y1.
+            auto const x1n = xn - half;
+            auto const y1n = yn - half;
+            multiply(x, half, y, half, out);
+            multiply(x + half, x1n, y + half, y1n, out + 2 * half);
+
+            std::vector<element_type> sums(2 * (half + 1));
+            auto const x_sum = sums.data();
+            auto const y_sum = sums.data() + half + 1;
+            x_sum[half] = add(x, half, x + half, x1n, x_sum);
+            y_sum[half] = add(y, half, y + half, y1n, y_sum);
+
+            std::vector<element_type> middle(2 * (half + 1));
+            multiply(x_sum, half + 1, y_sum, half + 1, middle.data());
+            subtract(middle.data(), middle.size(), out, 2 * half);
+            subtract(middle.data(), middle.size(), out + 2 * half, x1n + y1n);
+
+            // The leading elements of middle not fitting into the result are zero.
+            auto const middle_length = std::min(middle.size(), xn + yn - half);
+            add(out + half, xn + yn - half, middle.data(), middle_length, out + half);
+        }
+
+        // Returns (high * B + low) / divisor and stores the remainder, where high < divisor.
+        static element_type divide_wide(element_type high, element_type low, element_type divisor,
+                                        element_type& remainder) noexcept {
+            assert(high < divisor);
+#if defined(__SIZEOF_INT128__)
+            auto const dividend = (static_cast<unsigned __int128>(high) << 64) | low;
+            remainder = element_type(dividend % divisor);
+            return element_type(dividend / divisor);
+#else
+            // Divide by 32-bit digits after normalizing the divisor (Hacker's Delight, divlu).
+            constexpr element_type digit = element_type(1) << 32;
+            auto const shift = element_number_of_bits - log2p1(divisor);
+            divisor <<= shift;
+            auto const divisor_high = divisor >> 32;
+            auto const divisor_low = divisor & (digit - 1);
+            auto const dividend_high =
+                shift == 0 ? high : (high << shift) | (low >> (element_number_of_bits - shift));
+            auto const dividend_low = low << shift;
+            auto const dividend_low_high = dividend_low >> 32;
+            auto const dividend_low_low = dividend_low & (digit - 1);
+
+            auto quotient_high = dividend_high / divisor_high;
+            auto remainder_estimate = dividend_high - quotient_high * divisor_high;
+            while (quotient_high >= digit ||
+                   quotient_high * divisor_low > digit * remainder_estimate + dividend_low_high) {
+                --quotient_high;
+                remainder_estimate += divisor_high;
+                if (remainder_estimate >= digit) {
+                    break;
+                }
+            }
 
-            // Shift n bit-wise to match the leading 1 position.
-            auto leading_1_pos = log2p1(elements.back());
-            auto n_leading_1_pos = log2p1(n_shifted.elements.back());
+            auto const middle = dividend_high * digit + dividend_low_high - quotient_high * divisor;
+            auto quotient_low = middle / divisor_high;
+            remainder_estimate = middle - quotient_low * divisor_high;
+            while (quotient_low >= digit ||
+                   quotient_low * divisor_low > digit * remainder_estimate + dividend_low_low) {
+                --quotient_low;
+                remainder_estimate += divisor_high;
+                if (remainder_estimate >= digit) {
+                    break;
+                }
+            }
 
-            if (leading_1_pos > n_leading_1_pos) {
-                // Shift left.
-                auto shift_amount = leading_1_pos - n_leading_1_pos;
-                total_shift_amount += shift_amount;
+            remainder = (middle * digit + dividend_low_low - quotient_low * divisor) >> shift;
+            return quotient_high * digit + quotient_low;
+#endif
+        }
 
-                element_type carry = 0;
-                for (std::size_t idx = elements.size() - n.elements.size(); idx < elements.size();
-                     ++idx) {
-                    auto new_element = (n_shifted.elements[idx] << shift_amount) | carry;
-                    carry = (n_shifted.elements[idx] >> (element_number_of_bits - shift_amount));
-                    n_shifted.elements[idx] = new_element;
+        // Divides u[0, un) by v[0, vn) into q[0, un - vn + 1) and r[0, vn), by Knuth's Algorithm
+        // D. Precondition: un >= vn >= 1 and v[vn - 1] != 0.
+        static void divide_knuth(element_type const* u, std::size_t un, element_type const* v,
+                                 std::size_t vn, element_type* q, element_type* r) {
+            assert(un >= vn && vn >= 1 && v[vn - 1] != 0);
+            if (vn == 1) {
+                element_type remainder = 0;
+                for (auto idx = un; idx-- > 0;) {
+                    q[idx] = divide_wide(remainder, u[idx], v[0], remainder);
                 }
-                assert(carry == 0);
+                r[0] = remainder;
+                return;
             }
-            else if (leading_1_pos < n_leading_1_pos) {
-                // Break if *this is smaller than n.
-                if (total_shift_amount == 0) {
-                    break;
+
+            // Normalize so that the leading bit of the divisor is set.
+            auto const shift = element_number_of_bits - log2p1(v[vn - 1]);
+            buffer_type normalized_v(vn);
+            buffer_type normalized_u(un + 1);
+            shift_left_bits(v, vn, shift, normalized_v.data());
+            normalized_u[un] = shift_left_bits(u, un, shift, normalized_u.data());
+            auto const vs = normalized_v.data();
+            auto const us = normalized_u.data();
+            auto const v_top = vs[vn - 1];
+            auto const v_next = vs[vn - 2];
+
+            for (auto j = un - vn + 1; j-- > 0;) {
+                // Estimate the quotient digit from the leading two elements, and then correct it
+                // with the third one; the estimate is then either exact or too large by one.
+                element_type qhat, rhat;
+                bool rhat_overflow = false;
+                if (us[j + vn] >= v_top) {
+                    qhat = ~element_type(0);
+                    rhat = us[j + vn - 1] + v_top;
+                    rhat_overflow = rhat < v_top;
+                }
+                else {
+                    qhat = divide_wide(us[j + vn], us[j + vn - 1], v_top, rhat);
+                }
+                while (!rhat_overflow) {
+                    auto const p = umul128(qhat, v_next);
+                    if (p.high() < rhat || (p.high() == rhat && p.low() <= us[j + vn - 2])) {
+                        break;
+                    }
+                    --qhat;
+                    rhat += v_top;
+                    rhat_overflow = rhat < v_top;
                 }
 
-                // Shift right.
-                auto shift_amount = n_leading_1_pos - leading_1_pos;
-                assert(total_shift_amount > shift_amount);
-                total_shift_amount -= shift_amount;
-                for (std::size_t idx = elements.size() - n.elements.size(); idx < elements.size();
-                     ++idx) {
-                    n_shifted.elements[idx - 1] |=
-                        (n_shifted.elements[idx] << (element_number_of_bits - shift_amount));
-                    n_shifted.elements[idx] >>= shift_amount;
+                // Subtract qhat * v.
+                element_type carry = 0;
+                element_type borrow = 0;
+                for (std::size_t idx = 0; idx < vn; ++idx) {
+                    auto const p = umul128(qhat, vs[idx]);
+                    auto const low = p.low() + carry;
+                    carry = p.high() + (low < carry ? 1 : 0);
+                    auto const element = us[idx + j];
+                    auto const difference = element - low;
+                    us[idx + j] = difference - borrow;
+                    borrow = (element < low ? 1 : 0) + (difference < borrow ? 1 : 0);
                 }
+                auto const top = us[j + vn];
+                us[j + vn] = top - carry - borrow;
+
+                // If the result is negative, qhat was too large by one; add v back.
+                if (top < carry || top - carry < borrow) {
+                    --qhat;
+                    us[j + vn] += add(us + j, vn, vs, vn, us + j);
+                }
+                q[j] = qhat;
             }
 
-            // Check if n_shifted is bigger than *this; if that's the case, shift one bit to right.
-            if (n_shifted > *this) {
-                // If we actually didn't shift anything,
-                if (total_shift_amount == 0) {
-                    // *this is smaller than n.
-                    break;
+            shift_right_bits(us, vn, shift, r);
+        }
+
+        static big_uint divide_knuth(big_uint const& a, big_uint const& b, big_uint& remainder) {
+            if (a < b) {
+                remainder = a;
+                return big_uint();
+            }
+            auto const an = a.elements.size();
+            auto const bn = b.elements.size();
+            buffer_type q(an - bn + 1);
+            buffer_type r(bn);
+            divide_knuth(a.elements.data(), an, b.elements.data(), bn, q.data(), r.data());
+            remainder = big_uint(r.begin(), r.end());
+            return big_uint(q.begin(), q.end());
+        }
+
+        // x mod B^n.
+        static big_uint low_elements(big_uint const& x, std::size_t n) {
+            auto const length = std::min(n, x.elements.size());
+            return big_uint(x.elements.begin(), x.elements.begin() + length);
+        }
+
+        // x / B^n.
+        static big_uint high_elements(big_uint const& x, std::size_t n) {
+            if (x.elements.size() <= n) {
+                return big_uint();
+            }
+            return big_uint(x.elements.begin() + n, x.elements.end());
+        }
+
+        // x * B^n.
+        static big_uint shift_left_elements(big_uint const& x, std::size_t n) {
+            big_uint result;
+            if (!x.is_zero()) {
+                result.elements.resize(x.elements.size() + n, 0);
+                std::copy(x.elements.begin(), x.elements.end(), result.elements.begin() + n);
+            }
+            return result;
+        }
+
+        // x * 2^shift.
+        static big_uint shift_left(big_uint const& x, std::size_t shift) {
+            auto result = shift_left_elements(x, shift / element_number_of_bits);
+            if (!result.is_zero()) {
+                auto const offset = shift / element_number_of_bits;
+                auto const carry = shift_left_bits(
+                    result.elements.data() + offset, result.elements.size() - offset,
+                    shift % element_number_of_bits, result.elements.data() + offset);
+                if (carry != 0) {
+                    result.elements.push_back(carry);
                 }
+            }
+            return result;
+        }
 
-                // Shift right.
-                --total_shift_amount;
-                n_shifted.elements[0] >>= 1;
-                for (std::size_t idx = 1; idx < elements.size(); ++idx) {
-                    n_shifted.elements[idx - 1] |=
-                        (n_shifted.elements[idx] << (element_number_of_bits - 1));
-                    n_shifted.elements[idx] >>= 1;
+        // x / 2^shift.
+        static big_uint shift_right(big_uint const& x, std::size_t shift) {
+            auto result = high_elements(x, shift / element_number_of_bits);
+            if (!result.is_zero()) {
+                shift_right_bits(result.elements.data(), result.elements.size(),
+                                 shift % element_number_of_bits, result.elements.data());
+                if (result.elements.back() == 0) {
+                    result.elements.pop_back();
                 }
             }
+            return result;
+        }
 
-            // Subtract n_shifted from *this.
-            *this -= n_shifted;
+        // Returns a / b and stores a % b, where b has n elements with the leading bit set and
+        // a < b * B^n (Burnikel-Ziegler, Algorithm 1).
+        static big_uint divide_2n_1n(big_uint const& a, big_uint const& b, std::size_t n,
+                                     big_uint& remainder) {
+            if (n % 2 != 0 || n < burnikel_ziegler_threshold) {
+                return divide_knuth(a, b, remainder);
+            }
+            auto const half = n / 2;
+            big_uint r;
+            auto const q1 = divide_3n_2n(high_elements(a, half), b, half, r);
+            auto const q2 =
+                divide_3n_2n(shift_left_elements(r, half) + low_elements(a, half), b, half, remainder);
+            return shift_left_elements(q1, half) + q2;
+        }
+
+        // Returns a / b and stores a % b, where b has 2n elements with the leading bit set and
+        // a < b * B^n (Burnikel-Ziegler, Algorithm 2).
+        static big_uint divide_3n_2n(big_uint const& a, big_uint const& b, std::size_t n,
+                                     big_uint& remainder) {
+            auto const b1 = high_elements(b, n);
+            auto const a12 = high_elements(a, n);
+            big_uint q, r1;
+            if (high_elements(a, 2 * n) < b1) {
+                q = divide_2n_1n(a12, b1, n, r1);
+            }
+            else {
+                // The quotient digit is B^n - 1, leaving a12 - (B^n - 1) * b1.
+                q = shift_left_elements(1, n);
+                --q;
+                r1 = a12 + b1;
+                r1 -= shift_left_elements(b1, n);
+            }
+            auto const d = q * low_elements(b, n);
+            remainder = shift_left_elements(r1, n) + low_elements(a, n);
 
-            // Update the quotient.
-            auto quotient_element_idx = total_shift_amount / element_number_of_bits;
-            auto quotient_bit_idx = total_shift_amount % element_number_of_bits;
-            if (quotient.elements.size() <= quotient_element_idx) {
-                quotient.elements.resize(quotient_element_idx + 1);
+            // The estimated quotient is too large by at most 2.
+            while (remainder < d) {
+                --q;
+                remainder += b;
+            }
+            remainder -= d;
+            return q;
+        }
+
+        // Divides by splitting the dividend into blocks of the size of the (normalized) divisor,
+        // and dividing by the divisor block by block with divide_2n_1n.
+        static big_uint divide_burnikel_ziegler(big_uint const& a, big_uint const& b,
+                                                big_uint& remainder) {
+            // Pad the divisor to n = block_size * 2^depth elements with the leading bit set, so
+            // that the recursion halves n down to block_size <= burnikel_ziegler_threshold.
+            auto const bn = b.elements.size();
+            std::size_t depth = 0;
+            while ((burnikel_ziegler_threshold << depth) < bn) {
+                ++depth;
             }
-            quotient.elements[quotient_element_idx] |= (element_type(1) << quotient_bit_idx);
+            auto const block_size = (bn + (std::size_t(1) << depth) - 1) >> depth;
+            auto const n = block_size << depth;
+            auto const shift = (n - bn) * element_number_of_bits +
+                               (element_number_of_bits - log2p1(b.elements.back()));
+            auto const normalized_b = shift_left(b, shift);
+            auto const normalized_a = shift_left(a, shift);
+
+            // The leading block of the dividend is then smaller than the divisor.
+            auto const number_of_blocks = normalized_a.elements.size() / n + 1;
+            auto z = high_elements(normalized_a, (number_of_blocks - 2) * n);
+            big_uint quotient, r;
+            for (auto idx = number_of_blocks - 1; idx-- > 0;) {
+                auto const q = divide_2n_1n(z, normalized_b, n, r);
+                quotient = shift_left_elements(quotient, n) + q;
+                if (idx > 0) {
+                    z = shift_left_elements(r, n) +
+                        low_elements(high_elements(normalized_a, (idx - 1) * n), n);
+                }
+            }
+            remainder = shift_right(r, shift);
+            return quotient;
+        }
+    };
+
+    big_uint operator*(big_uint const& x, big_uint const& y) {
+        if (x.is_zero() || y.is_zero()) {
+            return big_uint();
+        }
+
+        big_uint result;
+        result.elements.resize(x.elements.size() + y.elements.size());
+        big_uint_arithmetic::multiply(x.elements.data(), x.elements.size(), y.elements.data(),
+                                      y.elements.size(), result.elements.data());
+
+        // Remove the last element if it is zero.
+        if (result.elements.back() == 0) {
+            result.elements.pop_back();
+        }
+
+        return result;
+    }
+
+    big_uint big_uint::long_division(big_uint const& n) {
+        assert(!n.is_zero());
+
+        if (this == &n) {
+            elements.clear();
+            return big_uint(1);
+        }
+        if (*this < n) {
+            return big_uint();
         }
 
+        // Burnikel-Ziegler pays off only if both the divisor and the quotient are long.
+        big_uint remainder;
+        auto quotient =
+            n.elements.size() >= big_uint_arithmetic::burnikel_ziegler_threshold &&
+                    elements.size() - n.elements.size() >=
+                        big_uint_arithmetic::burnikel_ziegler_threshold
+                ? big_uint_arithmetic::divide_burnikel_ziegler(*this, n, remainder)
+                : big_uint_arithmetic::divide_knuth(*this, n, remainder);
+        *this = static_cast<big_uint&&>(remainder);
         return quotient;
     }
 
@@ -0,0 +1,324 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_CHUNK_WRITER
+#define JKJ_HEADER_CHUNK_WRITER
+
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+    #if __has_include(<linux/io_uring.h>) && __has_include(<sys/syscall.h>)
+        #include <linux/io_uring.h>
+        #include <sys/mman.h>
+        #include <sys/syscall.h>
+        #if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+            #define JKJ_CHUNK_WRITER_HAS_IO_URING 1
+        #endif
+    #endif
+#endif
+
+// Writers of chunks of the output file at given offsets, submitted and completed asynchronously.
+// A chunk is identified by a token (the index of its buffer), and submit() may return before the
+// chunk is written; reap() reports the tokens of the chunks written since the last call, after
+// which their buffers can be reused. Only one thread may use a writer.
+
+class chunk_writer {
+public:
+    virtual ~chunk_writer() = default;
+
+    virtual char const* name() const noexcept = 0;
+
+    // The chunk must stay valid until its token is reported by reap().
+    virtual void submit(int token, char const* data, std::size_t size, off_t offset) = 0;
+
+    // Appends the tokens of completed chunks to completed. If wait is true and there are
+    // submitted chunks, blocks until at least one of them completes.
+    virtual void reap(bool wait, std::vector<int>& completed) = 0;
+};
+
+[[noreturn]] inline void throw_system_error(char const* what) {
+    throw std::runtime_error(std::string(what) + ": " + std::strerror(errno));
+}
+
+// Gathers chunks at consecutive offsets and writes them with a single pwritev in reap().
+class pwritev_writer final : public chunk_writer {
+public:
+    explicit pwritev_writer(int fd) noexcept : fd_{fd} {}
+
+    char const* name() const noexcept override { return "pwritev"; }
+
+    void submit(int token, char const* data, std::size_t size, off_t offset) override {
+        if (!pending_.empty() && offset != pending_offset_ + off_t(pending_size_)) {
+            flush();
+        }
+        if (pending_.empty()) {
+            pending_offset_ = offset;
+        }
+        pending_.push_back({const_cast<char*>(data), size});
+        pending_size_ += size;
+        pending_tokens_.push_back(token);
+    }
+
+    void reap(bool, std::vector<int>& completed) override {
+        flush();
+        completed.insert(completed.end(), done_tokens_.begin(), done_tokens_.end());
+        done_tokens_.clear();
+    }
+
+private:
+    void flush() {
+        auto iov = pending_.data();
+        auto remaining = pending_.size();
+        auto offset = pending_offset_;
+        auto bytes_left = pending_size_;
+        while (remaining != 0) {
+            auto const count = remaining < std::size_t(IOV_MAX) ? int(remaining) : IOV_MAX;
+            auto const written = ::pwritev(fd_, iov, count, offset);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw_system_error("pwritev");
+            }
+            // Retrying a write that made no progress would loop forever.
+            if (written == 0 && bytes_left != 0) {
+                throw std::runtime_error("pwritev: no bytes written");
+            }
+            bytes_left -= std::size_t(written);
+            offset += off_t(written);
+            // Skip the fully written buffers, and advance into a partially written one.
+            auto left = std::size_t(written);
+            while (remaining != 0 && left >= iov->iov_len) {
+                left -= iov->iov_len;
+                ++iov;
+                --remaining;
+            }
+            if (remaining != 0) {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+                iov->iov_len -= left;
+            }
+        }
+        done_tokens_.insert(done_tokens_.end(), pending_tokens_.begin(), pending_tokens_.end());
+        pending_.clear();
+        pending_tokens_.clear();
+        pending_size_ = 0;
+    }
+
+    int fd_;
+    std::vector<iovec> pending_;
+    std::vector<int> pending_tokens_;
+    std::vector<int> done_tokens_;
+    off_t pending_offset_ = 0;
+    std::size_t pending_size_ = 0;
+};
+
+#if defined(JKJ_CHUNK_WRITER_HAS_IO_URING)
+// Submits each chunk as an IORING_OP_WRITEV through the raw system calls, so that liburing is not
+// needed. At most max_tokens chunks may be in flight. Short writes are resubmitted.
+class io_uring_writer final : public chunk_writer {
+public:
+    // Returns nullptr if io_uring is not available, e.g. on old kernels or in sandboxes.
+    static std::unique_ptr<io_uring_writer> create(int fd, int max_tokens) {
+        std::unique_ptr<io_uring_writer> writer{new io_uring_writer(fd, max_tokens)};
+        if (!writer->setup(unsigned(max_tokens))) {
+            return nullptr;
+        }
+        return writer;
+    }
+
+    ~io_uring_writer() override {
+        if (sqes_ != nullptr) {
+            ::munmap(sqes_, sqes_size_);
+        }
+        if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+            ::munmap(cq_ring_, cq_ring_size_);
+        }
+        if (sq_ring_ != nullptr) {
+            ::munmap(sq_ring_, sq_ring_size_);
+        }
+        if (ring_fd_ >= 0) {
+            ::close(ring_fd_);
+        }
+    }
+
+    char const* name() const noexcept override { return "io_uring"; }
+
+    void submit(int token, char const* data, std::size_t size, off_t offset) override {
+        requests_[std::size_t(token)] = {{const_cast<char*>(data), size}, offset};
+        push(token);
+    }
+
+    void reap(bool wait, std::vector<int>& completed) override {
+        for (;;) {
+            auto const min_complete = wait && in_flight_ != 0 ? 1u : 0u;
+            if (to_submit_ != 0 || min_complete != 0) {
+                auto const result = ::syscall(__NR_io_uring_enter, ring_fd_, to_submit_,
+                                              min_complete,
+                                              min_complete != 0 ? IORING_ENTER_GETEVENTS : 0u,
+                                              nullptr, 0);
+                if (result < 0) {
+                    if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                        continue;
+                    }
+                    throw_system_error("io_uring_enter");
+                }
+                to_submit_ -= unsigned(result);
+            }
+
+            bool resubmitted = false;
+            auto head = *cq_head_;
+            auto const tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+            for (; head != tail; ++head) {
+                auto const& cqe = cqes_[head & cq_mask_];
+                auto const token = int(cqe.user_data);
+                auto& request = requests_[std::size_t(token)];
+                if (cqe.res < 0) {
+                    errno = -cqe.res;
+                    throw_system_error("io_uring write");
+                }
+                // Resubmitting a write that made no progress would loop forever.
+                if (cqe.res == 0 && request.iov.iov_len != 0) {
+                    throw std::runtime_error("io_uring write: no bytes written");
+                }
+                --in_flight_;
+                if (std::size_t(cqe.res) < request.iov.iov_len) {
+                    request.iov.iov_base = static_cast<char*>(request.iov.iov_base) + cqe.res;
+                    request.iov.iov_len -= std::size_t(cqe.res);
+                    request.offset += cqe.res;
+                    push(token);
+                    resubmitted = true;
+                }
+                else {
+                    completed.push_back(token);
+                }
+            }
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+            if (!resubmitted && (to_submit_ == 0 || !wait)) {
+                return;
+            }
+            // Short writes are submitted again right away.
+            wait = wait && completed.empty();
+        }
+    }
+
+private:
+    struct request {
+        iovec iov;
+        off_t offset;
+    };
+
+    io_uring_writer(int fd, int max_tokens) : fd_{fd}, requests_(std::size_t(max_tokens)) {}
+
+    bool setup(unsigned entries) {
+        io_uring_params params{};
+        ring_fd_ = int(::syscall(__NR_io_uring_setup, entries, &params));
+        if (ring_fd_ < 0) {
+            return false;
+        }
+
+        sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool const single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap && cq_ring_size_ > sq_ring_size_) {
+            sq_ring_size_ = cq_ring_size_;
+        }
+        sq_ring_ = map(sq_ring_size_, IORING_OFF_SQ_RING);
+        if (sq_ring_ == nullptr) {
+            return false;
+        }
+        cq_ring_ = single_mmap ? sq_ring_ : map(cq_ring_size_, IORING_OFF_CQ_RING);
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqes_size_, IORING_OFF_SQES));
+        if (cq_ring_ == nullptr || sqes_ == nullptr) {
+            return false;
+        }
+
+        auto const sq = static_cast<char*>(sq_ring_);
+        auto const cq = static_cast<char*>(cq_ring_);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    void* map(std::size_t size, std::uint64_t offset) const noexcept {
+        auto const ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                ring_fd_, off_t(offset));
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+    // There is always room in the submission queue, as it has at least as many entries as there
+    // are tokens.
+    void push(int token) noexcept {
+        auto const& request = requests_[std::size_t(token)];
+        auto const tail = *sq_tail_;
+        auto const index = tail & sq_mask_;
+        auto& sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_WRITEV;
+        sqe.fd = fd_;
+        sqe.addr = std::uint64_t(reinterpret_cast<std::uintptr_t>(&request.iov));
+        sqe.len = 1;
+        sqe.off = std::uint64_t(request.offset);
+        sqe.user_data = std::uint64_t(token);
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        ++to_submit_;
+        ++in_flight_;
+    }
+
+    int fd_;
+    int ring_fd_ = -1;
+    std::vector<request> requests_;
+    unsigned to_submit_ = 0;
+    unsigned in_flight_ = 0;
+
+    void* sq_ring_ = nullptr;
+    void* cq_ring_ = nullptr;
+    io_uring_sqe* sqes_ = nullptr;
+    std::size_t sq_ring_size_ = 0;
+    std::size_t cq_ring_size_ = 0;
+    std::size_t sqes_size_ = 0;
+
+    unsigned* sq_tail_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned* sq_array_ = nullptr;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+};
+#endif
+
+#endif
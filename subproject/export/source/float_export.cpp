@@ -0,0 +1,384 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Converts a raw dump of float32 or float64 values in the native byte order into text, one
+// number per line in the format of jkj::dragonbox::to_chars_n, e.g.
+//
+//   float_export --binary64 input.bin output.txt
+//
+// The input is mapped into memory and split into chunks, which worker threads format in parallel
+// into a bounded pool of buffers. The main thread writes the formatted chunks in order with
+// io_uring (or pwritev if io_uring is not available, or with --pwritev), so formatting and disk
+// writes overlap. When all buffers are formatted or in flight, the workers wait for writes to
+// complete, which bounds the memory usage. The throughput and the time spent in each stage are
+// reported at the end.
+
+#include "chunk_writer.h"
+#include "dragonbox/dragonbox_to_chars.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    double seconds_since(clock_type::time_point start) {
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+
+    struct export_options {
+        char const* input_path = nullptr;
+        char const* output_path = nullptr;
+        int float_bits = 0;
+        unsigned int number_of_threads = 0;
+        int number_of_buffers = 0;
+        std::size_t values_per_chunk = std::size_t(1) << 18;
+        bool use_pwritev = false;
+    };
+
+    // Time spent in each stage, in seconds.
+    struct stage_timings {
+        double map = 0;
+        double format = 0;      // Summed over the worker threads.
+        double buffer_wait = 0; // Workers waiting for a free buffer, summed.
+        double write = 0;       // Submitting and reaping writes.
+        double write_wait = 0;  // The writer waiting for the next chunk to be formatted.
+        double sync = 0;
+        double total = 0;
+    };
+
+    // A read-only mapping of the input file.
+    class mapped_file {
+    public:
+        explicit mapped_file(char const* path) {
+            auto const fd = ::open(path, O_RDONLY);
+            if (fd < 0) {
+                throw_system_error(path);
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw_system_error(path);
+            }
+            size_ = std::size_t(st.st_size);
+            if (size_ != 0) {
+                data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data_ == MAP_FAILED) {
+                    data_ = nullptr;
+                    ::close(fd);
+                    throw_system_error("mmap");
+                }
+                ::madvise(data_, size_, MADV_SEQUENTIAL);
+            }
+            ::close(fd);
+        }
+        mapped_file(mapped_file const&) = delete;
+        mapped_file& operator=(mapped_file const&) = delete;
+        ~mapped_file() {
+            if (data_ != nullptr) {
+                ::munmap(data_, size_);
+            }
+        }
+
+        void const* data() const noexcept { return data_; }
+        std::size_t size() const noexcept { return size_; }
+
+    private:
+        void* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+    template <class Float>
+    std::uint64_t export_text(mapped_file const& input, int output_fd,
+                              export_options const& options, stage_timings& timings) {
+        using format = typename jkj::dragonbox::default_float_bit_carrier_conversion_traits<
+            Float>::format;
+        // The longest output together with '\n'.
+        constexpr std::size_t max_length = jkj::dragonbox::max_output_string_length<format> + 1;
+
+        auto const values = static_cast<Float const*>(input.data());
+        auto const count = input.size() / sizeof(Float);
+        auto const number_of_chunks = (count + options.values_per_chunk - 1) / options.values_per_chunk;
+        auto const buffer_size = options.values_per_chunk * max_length;
+
+        std::unique_ptr<chunk_writer> writer;
+#if defined(JKJ_CHUNK_WRITER_HAS_IO_URING)
+        if (!options.use_pwritev) {
+            writer = io_uring_writer::create(output_fd, options.number_of_buffers);
+        }
+#endif
+        if (!writer) {
+            writer.reset(new pwritev_writer(output_fd));
+        }
+        std::cout << "Writing with " << writer->name() << ", " << options.number_of_threads
+                  << " formatting threads and " << options.number_of_buffers << " buffers of "
+                  << buffer_size << " bytes.\n";
+
+        std::vector<std::unique_ptr<char[]>> buffers;
+        std::vector<int> free_buffers;
+        for (int i = 0; i < options.number_of_buffers; ++i) {
+            buffers.emplace_back(new char[buffer_size]);
+            free_buffers.push_back(i);
+        }
+
+        // The state shared between the workers and the writer, guarded by mutex.
+        struct formatted_chunk {
+            int buffer = -1;
+            std::size_t size = 0;
+        };
+        std::mutex mutex;
+        std::condition_variable buffer_freed;
+        std::condition_variable chunk_formatted;
+        std::vector<formatted_chunk> chunks(number_of_chunks);
+        std::size_t next_chunk = 0;
+        bool failed = false;
+
+        std::atomic<std::int64_t> format_ns{0};
+        std::atomic<std::int64_t> buffer_wait_ns{0};
+        auto const to_ns = [](clock_type::duration d) {
+            return std::int64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+        };
+
+        // Chunks are taken in order together with a buffer, so the next chunk to be written
+        // always either holds a buffer or can get one; the pool can never be exhausted by later
+        // chunks waiting for it.
+        auto const worker = [&] {
+            for (;;) {
+                int buffer;
+                std::size_t chunk;
+                {
+                    auto const wait_start = clock_type::now();
+                    std::unique_lock<std::mutex> lock{mutex};
+                    buffer_freed.wait(lock, [&] {
+                        return failed || next_chunk == number_of_chunks || !free_buffers.empty();
+                    });
+                    buffer_wait_ns += to_ns(clock_type::now() - wait_start);
+                    if (failed || next_chunk == number_of_chunks) {
+                        return;
+                    }
+                    buffer = free_buffers.back();
+                    free_buffers.pop_back();
+                    chunk = next_chunk++;
+                }
+
+                auto const format_start = clock_type::now();
+                auto const first = values + chunk * options.values_per_chunk;
+                auto const last = std::min(first + options.values_per_chunk, values + count);
+                auto const buffer_first = buffers[std::size_t(buffer)].get();
+                auto ptr = buffer_first;
+                for (auto it = first; it != last; ++it) {
+                    ptr = jkj::dragonbox::to_chars_n(*it, ptr);
+                    *ptr = '\n';
+                    ++ptr;
+                }
+                format_ns += to_ns(clock_type::now() - format_start);
+
+                {
+                    std::lock_guard<std::mutex> lock{mutex};
+                    chunks[chunk] = {buffer, std::size_t(ptr - buffer_first)};
+                }
+                chunk_formatted.notify_one();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned int i = 0; i < options.number_of_threads; ++i) {
+            workers.emplace_back(worker);
+        }
+
+        std::uint64_t bytes_written = 0;
+        try {
+            std::size_t next_to_submit = 0;
+            std::size_t number_of_completed = 0;
+            std::size_t in_flight = 0;
+            std::vector<formatted_chunk> ready;
+            std::vector<int> completed;
+            while (number_of_completed < number_of_chunks) {
+                ready.clear();
+                {
+                    auto const wait_start = clock_type::now();
+                    std::unique_lock<std::mutex> lock{mutex};
+                    if (in_flight == 0) {
+                        chunk_formatted.wait(lock, [&] { return chunks[next_to_submit].buffer >= 0; });
+                        timings.write_wait += seconds_since(wait_start);
+                    }
+                    for (; next_to_submit < number_of_chunks && chunks[next_to_submit].buffer >= 0;
+                         ++next_to_submit) {
+                        ready.push_back(chunks[next_to_submit]);
+                    }
+                }
+
+                auto const write_start = clock_type::now();
+                for (auto const& chunk : ready) {
+                    writer->submit(chunk.buffer, buffers[std::size_t(chunk.buffer)].get(),
+                                   chunk.size, off_t(bytes_written));
+                    bytes_written += chunk.size;
+                }
+                in_flight += ready.size();
+
+                // Block only if there is nothing else to do.
+                completed.clear();
+                writer->reap(ready.empty(), completed);
+                timings.write += seconds_since(write_start);
+
+                if (!completed.empty()) {
+                    {
+                        std::lock_guard<std::mutex> lock{mutex};
+                        free_buffers.insert(free_buffers.end(), completed.begin(), completed.end());
+                    }
+                    buffer_freed.notify_all();
+                    in_flight -= completed.size();
+                    number_of_completed += completed.size();
+                }
+            }
+        }
+        catch (...) {
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                failed = true;
+            }
+            buffer_freed.notify_all();
+            for (auto& thread : workers) {
+                thread.join();
+            }
+            throw;
+        }
+
+        for (auto& thread : workers) {
+            thread.join();
+        }
+        timings.format = double(format_ns) / 1e9;
+        timings.buffer_wait = double(buffer_wait_ns) / 1e9;
+        return bytes_written;
+    }
+
+    bool parse_options(int argc, char* argv[], export_options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg = argv[i];
+            if (arg == "--binary32") {
+                options.float_bits = 32;
+            }
+            else if (arg == "--binary64") {
+                options.float_bits = 64;
+            }
+            else if (arg == "--pwritev") {
+                options.use_pwritev = true;
+            }
+            else if ((arg == "--threads" || arg == "--buffers" || arg == "--chunk") &&
+                     i + 1 < argc) {
+                auto const value = std::strtoull(argv[++i], nullptr, 0);
+                if (value == 0 || value > (std::size_t(1) << 30)) {
+                    return false;
+                }
+                if (arg == "--threads") {
+                    options.number_of_threads = unsigned(value);
+                }
+                else if (arg == "--buffers") {
+                    options.number_of_buffers = int(value);
+                }
+                else {
+                    options.values_per_chunk = std::size_t(value);
+                }
+            }
+            else if (options.input_path == nullptr && !arg.empty() && arg[0] != '-') {
+                options.input_path = argv[i];
+            }
+            else if (options.output_path == nullptr && !arg.empty() && arg[0] != '-') {
+                options.output_path = argv[i];
+            }
+            else {
+                return false;
+            }
+        }
+        return options.float_bits != 0 && options.input_path != nullptr &&
+               options.output_path != nullptr;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    export_options options;
+    if (!parse_options(argc, argv, options)) {
+        std::cerr << "Usage: float_export (--binary32 | --binary64) [--threads N] [--buffers N]\n"
+                     "                    [--chunk VALUES] [--pwritev] input output\n";
+        return 2;
+    }
+    if (options.number_of_threads == 0) {
+        options.number_of_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (options.number_of_buffers == 0) {
+        // Enough for every thread to format a chunk while as many are being written.
+        options.number_of_buffers = int(2 * options.number_of_threads + 2);
+    }
+
+    try {
+        stage_timings timings;
+        auto const start = clock_type::now();
+        mapped_file const input{options.input_path};
+        timings.map = seconds_since(start);
+
+        auto const output_fd = ::open(options.output_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (output_fd < 0) {
+            throw_system_error(options.output_path);
+        }
+        std::uint64_t bytes_written;
+        try {
+            bytes_written = options.float_bits == 32
+                                ? export_text<float>(input, output_fd, options, timings)
+                                : export_text<double>(input, output_fd, options, timings);
+            auto const sync_start = clock_type::now();
+            if (::fdatasync(output_fd) != 0) {
+                throw_system_error("fdatasync");
+            }
+            timings.sync = seconds_since(sync_start);
+        }
+        catch (...) {
+            ::close(output_fd);
+            throw;
+        }
+        ::close(output_fd);
+        timings.total = seconds_since(start);
+
+        auto const count = input.size() / (options.float_bits / 8);
+        auto const megabytes = double(bytes_written) / 1e6;
+        std::printf("%llu values, %.1f MB of text in %.3f s: %.1f MB/s\n",
+                    static_cast<unsigned long long>(count), megabytes, timings.total,
+                    megabytes / timings.total);
+        std::printf("  map:         %8.3f s\n", timings.map);
+        std::printf("  format:      %8.3f s (summed over threads; %.1f MB/s per thread)\n",
+                    timings.format, timings.format > 0 ? megabytes / timings.format : 0.0);
+        std::printf("  buffer wait: %8.3f s (summed over threads)\n", timings.buffer_wait);
+        std::printf("  write:       %8.3f s\n", timings.write);
+        std::printf("  write wait:  %8.3f s (waiting for formatting)\n", timings.write_wait);
+        std::printf("  sync:        %8.3f s\n", timings.sync);
+    }
+    catch (std::exception const& ex) {
+        std::cerr << ex.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,37 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_HEADER_DIFFERENTIAL_CHECK
+#define JKJ_HEADER_DIFFERENTIAL_CHECK
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Differential check of to_decimal and to_chars against Ryu, Schubfach and Grisu-Exact.
+// Each function returns an empty string if every implementation agrees, and a human-readable
+// description of all mismatches otherwise.
+std::string differential_check(float x);
+std::string differential_check(double x);
+
+// Interpret a fuzzer input as a sequence of bit patterns.
+// An input shorter than 8 bytes is checked as a single binary32 (if it has at least 4 bytes), and
+// otherwise every complete 8-byte chunk is checked both as a binary64 and as two binary32's.
+// Bytes are read in little-endian order.
+std::string differential_check_input(std::uint8_t const* data, std::size_t size);
+
+#endif
@@ -0,0 +1,835 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "differential_check.h"
+#include "dragonbox/dragonbox_to_chars.h"
+#include "dragonbox/dragonbox_runtime_rounding.h"
+#include "big_uint.h"
+#include "grisu_exact.h"
+#include "ryu/ryu.h"
+#include "schubfach_32.h"
+#include "schubfach_64.h"
+
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <tuple>
+
+// Policies are varied along three groups, and every combination within each group is checked:
+//   - decimal-to-binary rounding x binary-to-decimal rounding x cache, for to_decimal,
+//   - sign x trailing zero x cache x preferred integer types, for to_decimal,
+//   - decimal-to-binary rounding x binary-to-decimal rounding, for to_decimal_x2/x4 against
+//     to_decimal,
+//   - the two-pass bulk to_chars and formatted_size against to_chars,
+//   - decimal-to-binary rounding x binary-to-decimal rounding x digit generation (and
+//     cache x digit generation), for to_chars,
+//   - decimal-to-binary rounding x binary-to-decimal rounding, for to_chars with runtime
+//     rounding modes against to_chars.
+// Policies in different groups do not interact with each other, and taking the full product of
+// all of them would instantiate thousands of copies of the algorithm.
+//
+// Ryu, Schubfach and Grisu-Exact (with its default modes) serve as the oracle for the default
+// policies, and Grisu-Exact with the matching rounding modes serves as the oracle for the others.
+// When the oracle is not unique (binary_to_decimal_rounding::do_not_care), the result is checked
+// to have the shortest length and to lie inside the rounding interval using exact arithmetic.
+
+namespace {
+    namespace policy = jkj::dragonbox::policy;
+    namespace grisu_modes = jkj::grisu_exact_rounding_modes;
+    namespace grisu_correct_rounding = jkj::grisu_exact_correct_rounding;
+
+    // Decimal floating-point number with trailing zeros removed.
+    struct normalized_decimal {
+        std::uint64_t significand = 0;
+        int exponent = 0;
+        bool is_negative = false;
+
+        bool operator==(normalized_decimal const& other) const noexcept {
+            return significand == other.significand && exponent == other.exponent &&
+                   is_negative == other.is_negative;
+        }
+        bool operator!=(normalized_decimal const& other) const noexcept { return !(*this == other); }
+    };
+
+    std::ostream& operator<<(std::ostream& out, normalized_decimal const& d) {
+        return out << (d.is_negative ? "-" : "") << d.significand << "E" << d.exponent;
+    }
+
+    // Returns the number of removed trailing zeros.
+    int remove_trailing_zeros(normalized_decimal& d) noexcept {
+        int count = 0;
+        if (d.significand != 0) {
+            while (d.significand % 10 == 0) {
+                d.significand /= 10;
+                ++d.exponent;
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    template <class UInt, class Int>
+    normalized_decimal normalize(UInt significand, Int exponent, bool is_negative) noexcept {
+        normalized_decimal d{std::uint64_t(significand), int(exponent), is_negative};
+        remove_trailing_zeros(d);
+        return d;
+    }
+
+    int number_of_digits(std::uint64_t n) noexcept {
+        int digits = 1;
+        while (n >= 10) {
+            n /= 10;
+            ++digits;
+        }
+        return digits;
+    }
+
+    // Parses strings of the form [-]digits[.digits][(e|E)[+|-]digits].
+    bool parse_decimal(char const* str, normalized_decimal& out) noexcept {
+        normalized_decimal d;
+        if (*str == '-') {
+            d.is_negative = true;
+            ++str;
+        }
+
+        bool has_digits = false;
+        bool after_point = false;
+        for (;; ++str) {
+            if (*str == '.' && !after_point) {
+                after_point = true;
+                continue;
+            }
+            if (*str < '0' || *str > '9') {
+                break;
+            }
+            has_digits = true;
+            auto const digit = unsigned(*str - '0');
+            if (d.significand > (std::numeric_limits<std::uint64_t>::max() - 9) / 10) {
+                // Only trailing zeros can be dropped.
+                if (digit != 0) {
+                    return false;
+                }
+                if (!after_point) {
+                    ++d.exponent;
+                }
+                continue;
+            }
+            d.significand = d.significand * 10 + digit;
+            if (after_point) {
+                --d.exponent;
+            }
+        }
+        if (!has_digits) {
+            return false;
+        }
+
+        if (*str == 'e' || *str == 'E') {
+            ++str;
+            bool negative_exponent = false;
+            if (*str == '+' || *str == '-') {
+                negative_exponent = *str == '-';
+                ++str;
+            }
+            if (*str < '0' || *str > '9') {
+                return false;
+            }
+            int exponent = 0;
+            for (; *str >= '0' && *str <= '9'; ++str) {
+                exponent = exponent * 10 + (*str - '0');
+                if (exponent > 10000) {
+                    return false;
+                }
+            }
+            d.exponent += negative_exponent ? -exponent : exponent;
+        }
+        if (*str != '\0') {
+            return false;
+        }
+
+        remove_trailing_zeros(d);
+        out = d;
+        return true;
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////
+    // Exact rounding interval check.
+    ////////////////////////////////////////////////////////////////////////////////////////
+
+    enum class interval_kind { nearest, left_closed_directed, right_closed_directed };
+
+    struct interval_spec {
+        interval_kind kind;
+        bool include_left;
+        bool include_right;
+    };
+
+    // Compares significand * 10^exponent with boundary * 2^binary_exponent.
+    int compare_exactly(std::uint64_t significand, int exponent, std::uint64_t boundary,
+                        int binary_exponent) {
+        jkj::big_uint lhs{significand};
+        jkj::big_uint rhs{boundary};
+        if (exponent >= 0) {
+            lhs *= jkj::big_uint::pow(5, std::size_t(exponent));
+        }
+        else {
+            rhs *= jkj::big_uint::pow(5, std::size_t(-exponent));
+        }
+        auto const two_exponent = exponent - binary_exponent;
+        if (two_exponent >= 0) {
+            lhs *= jkj::big_uint::power_of_2(std::size_t(two_exponent));
+        }
+        else {
+            rhs *= jkj::big_uint::power_of_2(std::size_t(-two_exponent));
+        }
+        return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+    }
+
+    // Compares the magnitudes of two decimal numbers.
+    int compare_exactly(normalized_decimal const& a, normalized_decimal const& b) {
+        jkj::big_uint lhs{a.significand};
+        jkj::big_uint rhs{b.significand};
+        if (a.exponent >= b.exponent) {
+            lhs *= jkj::big_uint::pow(10, std::size_t(a.exponent - b.exponent));
+        }
+        else {
+            rhs *= jkj::big_uint::pow(10, std::size_t(b.exponent - a.exponent));
+        }
+        return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+    }
+
+    template <class Float>
+    struct binary_fp {
+        using conversion_traits = jkj::dragonbox::default_float_bit_carrier_conversion_traits<Float>;
+        using format = typename conversion_traits::format;
+        using carrier_uint = typename conversion_traits::carrier_uint;
+
+        // x = (-1)^is_negative * significand * 2^exponent
+        std::uint64_t significand;
+        int exponent;
+        bool is_negative;
+        // Whether the distance to the predecessor is half of the distance to the successor.
+        bool is_shorter_interval;
+
+        explicit binary_fp(Float x) noexcept {
+            auto const bits = conversion_traits::float_to_carrier(x);
+            auto const significand_bits =
+                std::uint64_t(bits & ((carrier_uint(1) << format::significand_bits) - 1));
+            auto const exponent_bits =
+                int((bits >> format::significand_bits) & ((1u << format::exponent_bits) - 1));
+
+            is_negative = (bits >> (format::total_bits - 1)) != 0;
+            if (exponent_bits != 0) {
+                significand = significand_bits | (std::uint64_t(1) << format::significand_bits);
+                exponent = exponent_bits + format::exponent_bias - format::significand_bits;
+            }
+            else {
+                significand = significand_bits;
+                exponent = format::min_exponent - format::significand_bits;
+            }
+            is_shorter_interval = significand_bits == 0 && exponent_bits > 1;
+        }
+    };
+
+    template <class Float>
+    bool is_in_rounding_interval(Float x, normalized_decimal const& d, interval_spec spec) {
+        binary_fp<Float> const b{x};
+        if (d.is_negative != b.is_negative) {
+            return false;
+        }
+
+        std::uint64_t left, right;
+        int left_exponent, right_exponent;
+        switch (spec.kind) {
+        case interval_kind::nearest:
+            if (b.is_shorter_interval) {
+                left = 4 * b.significand - 1;
+                left_exponent = b.exponent - 2;
+            }
+            else {
+                left = 2 * b.significand - 1;
+                left_exponent = b.exponent - 1;
+            }
+            right = 2 * b.significand + 1;
+            right_exponent = b.exponent - 1;
+            break;
+
+        case interval_kind::left_closed_directed:
+            left = b.significand;
+            left_exponent = b.exponent;
+            right = b.significand + 1;
+            right_exponent = b.exponent;
+            break;
+
+        default:
+            if (b.is_shorter_interval) {
+                left = 2 * b.significand - 1;
+                left_exponent = b.exponent - 1;
+            }
+            else {
+                left = b.significand - 1;
+                left_exponent = b.exponent;
+            }
+            right = b.significand;
+            right_exponent = b.exponent;
+            break;
+        }
+
+        auto const cmp_left = compare_exactly(d.significand, d.exponent, left, left_exponent);
+        auto const cmp_right = compare_exactly(d.significand, d.exponent, right, right_exponent);
+        return (cmp_left > 0 || (cmp_left == 0 && spec.include_left)) &&
+               (cmp_right < 0 || (cmp_right == 0 && spec.include_right));
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////
+    // Policy tables.
+    ////////////////////////////////////////////////////////////////////////////////////////
+
+    template <class Policy>
+    struct named_policy {
+        char const* name;
+    };
+
+    template <class DragonboxPolicy, class GrisuPolicy>
+    struct decimal_to_binary_rounding_mode {
+        char const* name;
+        jkj::dragonbox::decimal_to_binary_rounding_mode runtime_mode;
+        interval_spec (*get_interval_spec)(bool is_negative, bool is_even);
+    };
+
+    template <class DragonboxPolicy, class GrisuPolicy>
+    struct binary_to_decimal_rounding_mode {
+        char const* name;
+        jkj::dragonbox::binary_to_decimal_rounding_mode runtime_mode;
+    };
+
+    using runtime_dbr = jkj::dragonbox::decimal_to_binary_rounding_mode;
+    using runtime_bdr = jkj::dragonbox::binary_to_decimal_rounding_mode;
+
+    template <class Dragonbox, class Grisu>
+    decimal_to_binary_rounding_mode<Dragonbox, Grisu>
+    make_decimal_to_binary_rounding_mode(char const* name,
+                                         jkj::dragonbox::decimal_to_binary_rounding_mode runtime_mode,
+                                         interval_spec (*get_interval_spec)(bool, bool)) {
+        return {name, runtime_mode, get_interval_spec};
+    }
+
+    auto const decimal_to_binary_rounding_modes = std::make_tuple(
+        make_decimal_to_binary_rounding_mode<policy::decimal_to_binary_rounding::nearest_to_even_t,
+                                             grisu_modes::nearest_to_even>(
+            "nearest_to_even", runtime_dbr::nearest_to_even,
+            [](bool, bool is_even) { return interval_spec{interval_kind::nearest, is_even, is_even}; }),
+        make_decimal_to_binary_rounding_mode<policy::decimal_to_binary_rounding::nearest_to_odd_t,
+                                             grisu_modes::nearest_to_odd>(
+            "nearest_to_odd", runtime_dbr::nearest_to_odd,
+            [](bool, bool is_even) {
+                return interval_spec{interval_kind::nearest, !is_even, !is_even};
+            }),
+        make_decimal_to_binary_rounding_mode<
+            policy::decimal_to_binary_rounding::nearest_toward_plus_infinity_t,
+            grisu_modes::nearest_toward_plus_infinity>(
+            "nearest_toward_plus_infinity", runtime_dbr::nearest_toward_plus_infinity,
+            [](bool is_negative, bool) {
+                return interval_spec{interval_kind::nearest, !is_negative, is_negative};
+            }),
+        make_decimal_to_binary_rounding_mode<
+            policy::decimal_to_binary_rounding::nearest_toward_minus_infinity_t,
+            grisu_modes::nearest_toward_minus_infinity>(
+            "nearest_toward_minus_infinity", runtime_dbr::nearest_toward_minus_infinity,
+            [](bool is_negative, bool) {
+                return interval_spec{interval_kind::nearest, is_negative, !is_negative};
+            }),
+        make_decimal_to_binary_rounding_mode<policy::decimal_to_binary_rounding::nearest_toward_zero_t,
+                                             grisu_modes::nearest_toward_zero>(
+            "nearest_toward_zero", runtime_dbr::nearest_toward_zero,
+            [](bool, bool) { return interval_spec{interval_kind::nearest, false, true}; }),
+        make_decimal_to_binary_rounding_mode<
+            policy::decimal_to_binary_rounding::nearest_away_from_zero_t,
+            grisu_modes::nearest_away_from_zero>(
+            "nearest_away_from_zero", runtime_dbr::nearest_away_from_zero,
+            [](bool, bool) { return interval_spec{interval_kind::nearest, true, false}; }),
+        make_decimal_to_binary_rounding_mode<
+            policy::decimal_to_binary_rounding::nearest_to_even_static_boundary_t,
+            grisu_modes::nearest_to_even_static_boundary>(
+            "nearest_to_even_static_boundary", runtime_dbr::nearest_to_even,
+            [](bool, bool is_even) { return interval_spec{interval_kind::nearest, is_even, is_even}; }),
+        make_decimal_to_binary_rounding_mode<
+            policy::decimal_to_binary_rounding::nearest_to_odd_static_boundary_t,
+            grisu_modes::nearest_to_odd_static_boundary>(
+            "nearest_to_odd_static_boundary", runtime_dbr::nearest_to_odd,
+            [](bool, bool is_even) {
+                return interval_spec{interval_kind::nearest, !is_even, !is_even};
+            }),
+        make_decimal_to_binary_rounding_mode<
+            policy::decimal_to_binary_rounding::nearest_toward_plus_infinity_static_boundary_t,
+            grisu_modes::nearest_toward_plus_infinity_static_boundary>(
+            "nearest_toward_plus_infinity_static_boundary", runtime_dbr::nearest_toward_plus_infinity,
+            [](bool is_negative, bool) {
+                return interval_spec{interval_kind::nearest, !is_negative, is_negative};
+            }),
+        make_decimal_to_binary_rounding_mode<
+            policy::decimal_to_binary_rounding::nearest_toward_minus_infinity_static_boundary_t,
+            grisu_modes::nearest_toward_minus_infinity_static_boundary>(
+            "nearest_toward_minus_infinity_static_boundary", runtime_dbr::nearest_toward_minus_infinity,
+            [](bool is_negative, bool) {
+                return interval_spec{interval_kind::nearest, is_negative, !is_negative};
+            }),
+        make_decimal_to_binary_rounding_mode<policy::decimal_to_binary_rounding::toward_plus_infinity_t,
+                                             grisu_modes::toward_plus_infinity>(
+            "toward_plus_infinity", runtime_dbr::toward_plus_infinity,
+            [](bool is_negative, bool) {
+                return is_negative ? interval_spec{interval_kind::left_closed_directed, true, false}
+                                   : interval_spec{interval_kind::right_closed_directed, false, true};
+            }),
+        make_decimal_to_binary_rounding_mode<
+            policy::decimal_to_binary_rounding::toward_minus_infinity_t,
+            grisu_modes::toward_minus_infinity>(
+            "toward_minus_infinity", runtime_dbr::toward_minus_infinity,
+            [](bool is_negative, bool) {
+                return is_negative ? interval_spec{interval_kind::right_closed_directed, false, true}
+                                   : interval_spec{interval_kind::left_closed_directed, true, false};
+            }),
+        make_decimal_to_binary_rounding_mode<policy::decimal_to_binary_rounding::toward_zero_t,
+                                             grisu_modes::toward_zero>(
+            "toward_zero", runtime_dbr::toward_zero,
+            [](bool, bool) {
+                return interval_spec{interval_kind::left_closed_directed, true, false};
+            }),
+        make_decimal_to_binary_rounding_mode<policy::decimal_to_binary_rounding::away_from_zero_t,
+                                             grisu_modes::away_from_zero>(
+            "away_from_zero", runtime_dbr::away_from_zero,
+            [](bool, bool) {
+                return interval_spec{interval_kind::right_closed_directed, false, true};
+            }));
+
+    auto const binary_to_decimal_rounding_modes = std::make_tuple(
+        binary_to_decimal_rounding_mode<policy::binary_to_decimal_rounding::do_not_care_t,
+                                        grisu_correct_rounding::do_not_care>{
+            "do_not_care", runtime_bdr::do_not_care},
+        binary_to_decimal_rounding_mode<policy::binary_to_decimal_rounding::to_even_t,
+                                        grisu_correct_rounding::tie_to_even>{
+            "to_even", runtime_bdr::to_even},
+        binary_to_decimal_rounding_mode<policy::binary_to_decimal_rounding::to_odd_t,
+                                        grisu_correct_rounding::tie_to_odd>{
+            "to_odd", runtime_bdr::to_odd},
+        binary_to_decimal_rounding_mode<policy::binary_to_decimal_rounding::away_from_zero_t,
+                                        grisu_correct_rounding::tie_to_up>{
+            "away_from_zero", runtime_bdr::away_from_zero},
+        binary_to_decimal_rounding_mode<policy::binary_to_decimal_rounding::toward_zero_t,
+                                        grisu_correct_rounding::tie_to_down>{
+            "toward_zero", runtime_bdr::toward_zero});
+
+    auto const sign_policies =
+        std::make_tuple(named_policy<policy::sign::ignore_t>{"sign::ignore"},
+                        named_policy<policy::sign::return_sign_t>{"sign::return_sign"});
+
+    auto const trailing_zero_policies = std::make_tuple(
+        named_policy<policy::trailing_zero::ignore_t>{"trailing_zero::ignore"},
+        named_policy<policy::trailing_zero::remove_t>{"trailing_zero::remove"},
+        named_policy<policy::trailing_zero::remove_compact_t>{"trailing_zero::remove_compact"},
+        named_policy<policy::trailing_zero::report_t>{"trailing_zero::report"});
+
+    auto const cache_policies =
+        std::make_tuple(named_policy<policy::cache::full_t>{"cache::full"},
+                        named_policy<policy::cache::compact_t>{"cache::compact"},
+                        named_policy<policy::cache::restricted_t<-20, 20>>{
+                            "cache::restricted<-20, 20>"});
+
+    auto const preferred_integer_types_policies = std::make_tuple(
+        named_policy<policy::preferred_integer_types::match_t>{"preferred_integer_types::match"},
+        named_policy<policy::preferred_integer_types::prefer_32_t>{
+            "preferred_integer_types::prefer_32"},
+        named_policy<policy::preferred_integer_types::minimal_t>{
+            "preferred_integer_types::minimal"});
+
+    auto const digit_generation_policies = std::make_tuple(
+        named_policy<policy::digit_generation::fast_t>{"digit_generation::fast"},
+        named_policy<policy::digit_generation::compact_t>{"digit_generation::compact"});
+
+    template <class Tuple, class Func>
+    void for_each(Tuple const& tuple, Func&& func) {
+        std::apply([&func](auto const&... elements) { (func(elements), ...); }, tuple);
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////
+    // Reference implementations.
+    ////////////////////////////////////////////////////////////////////////////////////////
+
+    void ryu_to_chars(float x, char* buffer) { f2s_buffered(x, buffer); }
+    void ryu_to_chars(double x, char* buffer) { d2s_buffered(x, buffer); }
+
+    void schubfach_to_chars(float x, char* buffer) { *schubfach::Ftoa(buffer, x) = '\0'; }
+    void schubfach_to_chars(double x, char* buffer) { *schubfach::Dtoa(buffer, x) = '\0'; }
+
+    template <class Float, class GrisuRoundingMode, class GrisuCorrectRounding>
+    normalized_decimal grisu_exact_to_decimal(Float x) {
+        auto const result = jkj::grisu_exact<true>(x, GrisuRoundingMode{}, GrisuCorrectRounding{});
+        return normalize(result.significand, result.exponent, result.is_negative);
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////
+    // The checker.
+    ////////////////////////////////////////////////////////////////////////////////////////
+
+    template <class Float>
+    class checker {
+    public:
+        explicit checker(Float x) : x_(x), binary_(x) {}
+
+        std::string run() {
+            if (std::isfinite(x_) && x_ != 0) {
+                if (check_references()) {
+                    check_rounding_policies();
+                    check_representation_policies();
+                    check_batch_policies();
+                    check_to_chars_policies();
+                }
+            }
+            else {
+                check_default_to_chars();
+            }
+            check_bulk_to_chars();
+            return report_.str();
+        }
+
+    private:
+        Float x_;
+        binary_fp<Float> binary_;
+        normalized_decimal reference_;
+        std::ostringstream report_;
+
+        std::ostream& report() {
+            if (report_.tellp() == 0) {
+                using carrier_uint = typename binary_fp<Float>::carrier_uint;
+                report_ << "Mismatch for " << (sizeof(Float) == 4 ? "binary32 " : "binary64 ")
+                        << std::hexfloat << x_ << std::defaultfloat << " (0x" << std::hex
+                        << std::setfill('0') << std::setw(sizeof(Float) * 2)
+                        << carrier_uint(binary_fp<Float>::conversion_traits::float_to_carrier(x_))
+                        << std::dec << "):\n";
+            }
+            return report_ << "    ";
+        }
+
+        // Ryu, Schubfach and Grisu-Exact should agree with each other.
+        bool check_references() {
+            char buffer[64];
+            normalized_decimal ryu, schubfach;
+
+            ryu_to_chars(x_, buffer);
+            if (!parse_decimal(buffer, ryu)) {
+                report() << "cannot parse the output of Ryu: " << buffer << "\n";
+                return false;
+            }
+            schubfach_to_chars(x_, buffer);
+            if (!parse_decimal(buffer, schubfach)) {
+                report() << "cannot parse the output of Schubfach: " << buffer << "\n";
+                return false;
+            }
+            auto const grisu_exact = grisu_exact_to_decimal<Float, grisu_modes::nearest_to_even,
+                                                            grisu_correct_rounding::tie_to_even>(x_);
+
+            if (ryu != schubfach || ryu != grisu_exact) {
+                report() << "reference implementations disagree [Ryu = " << ryu
+                         << ", Schubfach = " << schubfach << ", Grisu-Exact = " << grisu_exact
+                         << "]\n";
+                return false;
+            }
+            reference_ = ryu;
+            return true;
+        }
+
+        template <class DecimalToBinaryRounding, class BinaryToDecimalRounding, class Cache>
+        normalized_decimal dragonbox_to_decimal() {
+            auto const result =
+                jkj::dragonbox::to_decimal(x_, policy::sign::return_sign, policy::trailing_zero::ignore,
+                                           DecimalToBinaryRounding{}, BinaryToDecimalRounding{}, Cache{});
+            return normalize(result.significand, result.exponent, result.is_negative);
+        }
+
+        void check_rounding_policies() {
+            for_each(decimal_to_binary_rounding_modes, [&](auto const& dbr) {
+                for_each(binary_to_decimal_rounding_modes, [&](auto const& bdr) {
+                    for_each(cache_policies, [&](auto const& cache) {
+                        check_rounding_policies(dbr, bdr, cache);
+                    });
+                });
+            });
+        }
+
+        template <class DragonboxDBR, class GrisuDBR, class DragonboxBDR, class GrisuBDR, class Cache>
+        void check_rounding_policies(decimal_to_binary_rounding_mode<DragonboxDBR, GrisuDBR> const& dbr,
+                                     binary_to_decimal_rounding_mode<DragonboxBDR, GrisuBDR> const& bdr,
+                                     named_policy<Cache> const& cache) {
+            auto const result = dragonbox_to_decimal<DragonboxDBR, DragonboxBDR, Cache>();
+            auto const expected = grisu_exact_to_decimal<Float, GrisuDBR, GrisuBDR>(x_);
+            if (result == expected) {
+                return;
+            }
+
+            auto const spec = dbr.get_interval_spec(binary_.is_negative, binary_.significand % 2 == 0);
+            bool const is_shortest =
+                number_of_digits(result.significand) <= number_of_digits(expected.significand) &&
+                is_in_rounding_interval(x_, result, spec);
+
+            // The shortest representation is not unique if correct rounding is not requested.
+            if (std::is_same<DragonboxBDR, policy::binary_to_decimal_rounding::do_not_care_t>::value &&
+                is_shortest) {
+                return;
+            }
+
+            // Grisu-Exact does not search for the closest one for directed rounding modes, while
+            // Dragonbox does. Since the whole interval lies on one side of x, the closest one is the
+            // smallest one in magnitude for left-closed intervals and the largest one for
+            // right-closed intervals.
+            if (spec.kind != interval_kind::nearest && is_shortest &&
+                compare_exactly(result, expected) ==
+                    (spec.kind == interval_kind::left_closed_directed ? -1 : 1)) {
+                return;
+            }
+
+            report() << "to_decimal with " << dbr.name << ", " << bdr.name << ", " << cache.name
+                     << " [Grisu-Exact = " << expected << ", Dragonbox = " << result << "]"
+                     << (is_in_rounding_interval(x_, result, spec) ? "" : " (outside the interval)")
+                     << "\n";
+        }
+
+        void check_representation_policies() {
+            for_each(sign_policies, [&](auto const& sign) {
+                for_each(trailing_zero_policies, [&](auto const& trailing_zero) {
+                    for_each(cache_policies, [&](auto const& cache) {
+                        for_each(preferred_integer_types_policies, [&](auto const& integer_types) {
+                            check_representation_policies(sign, trailing_zero, cache, integer_types);
+                        });
+                    });
+                });
+            });
+        }
+
+        template <class Sign, class TrailingZero, class Cache, class PreferredIntegerTypes>
+        void check_representation_policies(named_policy<Sign> const& sign,
+                                           named_policy<TrailingZero> const& trailing_zero,
+                                           named_policy<Cache> const& cache,
+                                           named_policy<PreferredIntegerTypes> const& integer_types) {
+            auto const result = jkj::dragonbox::to_decimal(x_, Sign{}, TrailingZero{}, Cache{},
+                                                           PreferredIntegerTypes{});
+
+            normalized_decimal d{std::uint64_t(result.significand), int(result.exponent),
+                                 binary_.is_negative};
+            bool is_negative_correct = true;
+            if constexpr (std::is_same<Sign, policy::sign::return_sign_t>::value) {
+                is_negative_correct = result.is_negative == binary_.is_negative;
+            }
+            auto const number_of_trailing_zeros = remove_trailing_zeros(d);
+
+            bool trailing_zeros_correct = true;
+            if constexpr (std::is_same<TrailingZero, policy::trailing_zero::remove_t>::value ||
+                             std::is_same<TrailingZero, policy::trailing_zero::remove_compact_t>::value) {
+                trailing_zeros_correct = number_of_trailing_zeros == 0;
+            }
+            if constexpr (std::is_same<TrailingZero, policy::trailing_zero::report_t>::value) {
+                trailing_zeros_correct = result.may_have_trailing_zeros || number_of_trailing_zeros == 0;
+            }
+
+            if (d != reference_ || !is_negative_correct || !trailing_zeros_correct) {
+                report() << "to_decimal with " << sign.name << ", " << trailing_zero.name << ", "
+                         << cache.name << ", " << integer_types.name << " [Reference = " << reference_
+                         << ", Dragonbox = " << d << "]"
+                         << (is_negative_correct ? "" : " (wrong sign)")
+                         << (trailing_zeros_correct ? "" : " (wrong trailing zeros)") << "\n";
+            }
+        }
+
+        void check_batch_policies() {
+            for_each(decimal_to_binary_rounding_modes, [&](auto const& dbr) {
+                for_each(binary_to_decimal_rounding_modes, [&](auto const& bdr) {
+                    check_batch_policies(dbr, bdr);
+                });
+            });
+        }
+
+        // to_decimal_x2/x4 should produce exactly what to_decimal produces for each lane. The other
+        // lanes are filled with the negation of x and with 1, which goes to the shorter interval case.
+        template <class DragonboxDBR, class GrisuDBR, class DragonboxBDR, class GrisuBDR>
+        void check_batch_policies(decimal_to_binary_rounding_mode<DragonboxDBR, GrisuDBR> const& dbr,
+                                  binary_to_decimal_rounding_mode<DragonboxBDR, GrisuBDR> const& bdr) {
+            Float const inputs[4] = {x_, -x_, Float(1), x_};
+            using result_type =
+                decltype(jkj::dragonbox::to_decimal(x_, DragonboxDBR{}, DragonboxBDR{}));
+
+            result_type results_x2[2];
+            result_type results_x4[4];
+            jkj::dragonbox::to_decimal_x2(inputs, results_x2, DragonboxDBR{}, DragonboxBDR{});
+            jkj::dragonbox::to_decimal_x4(inputs, results_x4, DragonboxDBR{}, DragonboxBDR{});
+
+            auto const same = [](result_type const& a, result_type const& b) {
+                return a.significand == b.significand && a.exponent == b.exponent &&
+                       a.is_negative == b.is_negative;
+            };
+            for (std::size_t i = 0; i < 4; ++i) {
+                auto const expected =
+                    jkj::dragonbox::to_decimal(inputs[i], DragonboxDBR{}, DragonboxBDR{});
+                bool const x2_correct = i >= 2 || same(results_x2[i], expected);
+                bool const x4_correct = same(results_x4[i], expected);
+                if (!x2_correct || !x4_correct) {
+                    report() << "to_decimal_x" << (x2_correct ? "4" : "2") << " with " << dbr.name
+                             << ", " << bdr.name << " (lane " << i << ") [to_decimal = "
+                             << normalize(expected.significand, expected.exponent, expected.is_negative)
+                             << "]\n";
+                }
+            }
+        }
+
+        void check_to_chars_policies() {
+            for_each(decimal_to_binary_rounding_modes, [&](auto const& dbr) {
+                for_each(binary_to_decimal_rounding_modes, [&](auto const& bdr) {
+                    for_each(digit_generation_policies, [&](auto const& digit_generation) {
+                        check_to_chars_policies(dbr, bdr, std::get<0>(cache_policies), digit_generation);
+                    });
+                });
+            });
+            for_each(digit_generation_policies, [&](auto const& digit_generation) {
+                check_to_chars_policies(std::get<0>(decimal_to_binary_rounding_modes),
+                                        std::get<1>(binary_to_decimal_rounding_modes),
+                                        std::get<1>(cache_policies), digit_generation);
+            });
+            for_each(decimal_to_binary_rounding_modes, [&](auto const& dbr) {
+                for_each(binary_to_decimal_rounding_modes,
+                         [&](auto const& bdr) { check_runtime_rounding_to_chars(dbr, bdr); });
+            });
+
+            check_default_to_chars();
+        }
+
+        template <class DragonboxDBR, class GrisuDBR, class DragonboxBDR, class GrisuBDR, class Cache,
+                  class DigitGeneration>
+        void check_to_chars_policies(decimal_to_binary_rounding_mode<DragonboxDBR, GrisuDBR> const& dbr,
+                                     binary_to_decimal_rounding_mode<DragonboxBDR, GrisuBDR> const& bdr,
+                                     named_policy<Cache> const& cache,
+                                     named_policy<DigitGeneration> const& digit_generation) {
+            char buffer[64];
+            jkj::dragonbox::to_chars(x_, buffer, DragonboxDBR{}, DragonboxBDR{}, Cache{},
+                                     DigitGeneration{});
+
+            normalized_decimal printed;
+            auto const expected = dragonbox_to_decimal<DragonboxDBR, DragonboxBDR, Cache>();
+            if (!parse_decimal(buffer, printed) || printed != expected) {
+                report() << "to_chars with " << dbr.name << ", " << bdr.name << ", " << cache.name
+                         << ", " << digit_generation.name << " [to_decimal = " << expected
+                         << ", to_chars = " << buffer << "]\n";
+            }
+        }
+
+        // to_chars with runtime rounding modes should be identical to to_chars with the
+        // corresponding policies.
+        template <class DragonboxDBR, class GrisuDBR, class DragonboxBDR, class GrisuBDR>
+        void check_runtime_rounding_to_chars(
+            decimal_to_binary_rounding_mode<DragonboxDBR, GrisuDBR> const& dbr,
+            binary_to_decimal_rounding_mode<DragonboxBDR, GrisuBDR> const& bdr) {
+            char expected[64];
+            char buffer[64];
+            jkj::dragonbox::to_chars(x_, expected, DragonboxDBR{}, DragonboxBDR{});
+            jkj::dragonbox::to_chars(x_, buffer, dbr.runtime_mode, bdr.runtime_mode);
+            if (std::strcmp(buffer, expected) != 0) {
+                report() << "to_chars with runtime rounding modes " << dbr.name << ", " << bdr.name
+                         << " [expected = " << expected << ", to_chars = " << buffer << "]\n";
+            }
+        }
+
+        // The two-pass bulk output should be identical to concatenating to_chars outputs. The 9
+        // inputs cover both a full block of the prefix sum and the remainder.
+        void check_bulk_to_chars() {
+            Float const inputs[9] = {x_, -x_, Float(1), x_, Float(0), x_, Float(-0.5), x_, x_};
+            std::size_t offsets[10];
+            char buffer[9 * 64];
+            char expected[9 * 64];
+
+            auto const total =
+                jkj::dragonbox::to_chars_bulk_offsets(inputs, 9, offsets, policy::cache::compact);
+            jkj::dragonbox::to_chars_bulk_write(inputs, 0, 9, offsets, ' ', buffer,
+                                                policy::cache::compact);
+
+            auto ptr = expected;
+            for (auto input : inputs) {
+                ptr = jkj::dragonbox::to_chars_n(input, ptr, policy::cache::compact);
+                *ptr++ = ' ';
+            }
+            if (total != std::size_t(ptr - expected) ||
+                std::memcmp(buffer, expected, total) != 0) {
+                report() << "to_chars_bulk [to_chars = " << std::string(expected, ptr)
+                         << ", to_chars_bulk = " << std::string(buffer, buffer + total) << "]\n";
+            }
+        }
+
+        // The output with the default policies should be identical to Ryu's.
+        void check_default_to_chars() {
+            char buffer1[64];
+            char buffer2[64];
+            jkj::dragonbox::to_chars(x_, buffer1);
+            ryu_to_chars(x_, buffer2);
+            if (std::strcmp(buffer1, buffer2) != 0) {
+                report() << "to_chars with default policies [Ryu = " << buffer2
+                         << ", Dragonbox = " << buffer1 << "]\n";
+            }
+
+            auto const size = jkj::dragonbox::formatted_size(x_);
+            if (size != std::strlen(buffer1)) {
+                report() << "formatted_size [to_chars = " << buffer1 << ", formatted_size = " << size
+                         << "]\n";
+            }
+        }
+    };
+
+    template <class UInt>
+    UInt load_little_endian(std::uint8_t const* data) noexcept {
+        UInt value = 0;
+        for (std::size_t i = 0; i < sizeof(UInt); ++i) {
+            value |= UInt(data[i]) << (8 * i);
+        }
+        return value;
+    }
+}
+
+std::string differential_check(float x) { return checker<float>{x}.run(); }
+std::string differential_check(double x) { return checker<double>{x}.run(); }
+
+std::string differential_check_input(std::uint8_t const* data, std::size_t size) {
+    using float_traits = jkj::dragonbox::default_float_bit_carrier_conversion_traits<float>;
+    using double_traits = jkj::dragonbox::default_float_bit_carrier_conversion_traits<double>;
+
+    std::string report;
+    if (size < 8) {
+        if (size >= 4) {
+            report += differential_check(
+                float_traits::carrier_to_float(load_little_endian<std::uint32_t>(data)));
+        }
+        return report;
+    }
+    for (; size >= 8; data += 8, size -= 8) {
+        report += differential_check(
+            double_traits::carrier_to_float(load_little_endian<std::uint64_t>(data)));
+        report += differential_check(
+            float_traits::carrier_to_float(load_little_endian<std::uint32_t>(data)));
+        report += differential_check(
+            float_traits::carrier_to_float(load_little_endian<std::uint32_t>(data + 4)));
+    }
+    return report;
+}
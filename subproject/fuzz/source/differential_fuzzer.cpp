@@ -0,0 +1,34 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// libFuzzer entry point. Build with clang and -fsanitize=fuzzer, or with AFL++ using
+// afl-clang-fast++ -fsanitize=fuzzer. Mismatching inputs abort the process, so the fuzzer saves
+// them as crash artifacts; pass -artifact_prefix=<corpus directory>/ to collect them.
+
+#include "differential_check.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+extern "C" int LLVMFuzzerTestOneInput(std::uint8_t const* data, std::size_t size) {
+    auto const report = differential_check_input(data, size);
+    if (!report.empty()) {
+        std::fputs(report.c_str(), stderr);
+        std::abort();
+    }
+    return 0;
+}
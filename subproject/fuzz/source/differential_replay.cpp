@@ -0,0 +1,166 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Standalone driver for the differential check, for compilers without libFuzzer.
+//
+// Usage: differential_replay [--random N] [--seed S] [--corpus DIR] [PATH...]
+//   PATH          Input file, or a directory whose files are all replayed (e.g. a fuzzer corpus).
+//                 If neither PATH nor --random is given, a single input is read from stdin, so
+//                 that this driver can also be used as an AFL target.
+//   --random N    Check N uniformly random bit patterns for each of binary32 and binary64.
+//   --seed S      Seed for --random. A random seed is used if not given.
+//   --corpus DIR  Directory into which mismatching inputs are written (default: mismatch_corpus).
+//
+// Returns 0 if no mismatch is found.
+
+#include "differential_check.h"
+#include "random_float.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    struct replay_context {
+        fs::path corpus_directory = "mismatch_corpus";
+        std::size_t number_of_inputs = 0;
+        std::size_t number_of_mismatches = 0;
+
+        void check(std::vector<std::uint8_t> const& input, std::string const& name) {
+            ++number_of_inputs;
+            auto const report = differential_check_input(input.data(), input.size());
+            if (report.empty()) {
+                return;
+            }
+
+            ++number_of_mismatches;
+            std::cout << report;
+
+            std::error_code ec;
+            fs::create_directories(corpus_directory, ec);
+            std::ofstream out{corpus_directory / name, std::ios::binary};
+            out.write(reinterpret_cast<char const*>(input.data()), std::streamsize(input.size()));
+            if (out) {
+                std::cout << "    Saved to " << (corpus_directory / name).string() << "\n";
+            }
+        }
+    };
+
+    std::vector<std::uint8_t> read_all(std::istream& in) {
+        return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    }
+
+    void replay_file(replay_context& context, fs::path const& path) {
+        std::ifstream in{path, std::ios::binary};
+        if (!in) {
+            std::cout << "Cannot open " << path.string() << "\n";
+            return;
+        }
+        context.check(read_all(in), path.filename().string());
+    }
+
+    template <class Float, class RandGen>
+    void check_random(replay_context& context, std::size_t count, RandGen& rg) {
+        using conversion_traits = jkj::dragonbox::default_float_bit_carrier_conversion_traits<Float>;
+        using carrier_uint = typename conversion_traits::carrier_uint;
+
+        static constexpr char hex_digits[] = "0123456789abcdef";
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const bits = conversion_traits::float_to_carrier(
+                uniformly_randomly_generate_general_float<Float>(rg));
+
+            std::vector<std::uint8_t> input(sizeof(carrier_uint));
+            std::string name = sizeof(Float) == 4 ? "binary32-" : "binary64-";
+            for (std::size_t byte_idx = 0; byte_idx < sizeof(carrier_uint); ++byte_idx) {
+                input[byte_idx] = std::uint8_t(bits >> (8 * byte_idx));
+            }
+            for (int digit_idx = int(sizeof(carrier_uint)) * 2 - 1; digit_idx >= 0; --digit_idx) {
+                name += hex_digits[(bits >> (4 * digit_idx)) & 0xf];
+            }
+            context.check(input, name);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    replay_context context;
+    std::vector<fs::path> paths;
+    std::size_t number_of_random_inputs = 0;
+    bool has_seed = false;
+    std::uint64_t seed = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if ((arg == "--random" || arg == "--seed" || arg == "--corpus") && i + 1 < argc) {
+            std::string_view value = argv[++i];
+            if (arg == "--random") {
+                number_of_random_inputs = std::size_t(std::strtoull(value.data(), nullptr, 0));
+            }
+            else if (arg == "--seed") {
+                has_seed = true;
+                seed = std::uint64_t(std::strtoull(value.data(), nullptr, 0));
+            }
+            else {
+                context.corpus_directory = value;
+            }
+        }
+        else if (arg.size() >= 2 && arg.substr(0, 2) == "--") {
+            std::cout << "Unknown option: " << arg << "\n";
+            return -1;
+        }
+        else {
+            paths.emplace_back(arg);
+        }
+    }
+
+    if (paths.empty() && number_of_random_inputs == 0) {
+        context.check(read_all(std::cin), "stdin");
+    }
+
+    for (auto const& path : paths) {
+        if (fs::is_directory(path)) {
+            std::cout << "[Replaying inputs in " << path.string() << "...]\n";
+            for (auto const& entry : fs::directory_iterator{path}) {
+                if (entry.is_regular_file()) {
+                    replay_file(context, entry.path());
+                }
+            }
+        }
+        else {
+            replay_file(context, path);
+        }
+    }
+
+    if (number_of_random_inputs != 0) {
+        auto rg = has_seed ? generate_seeded_mt19937_64(seed) : generate_correctly_seeded_mt19937_64();
+        std::cout << "[Checking " << number_of_random_inputs << " random binary32 inputs...]\n";
+        check_random<float>(context, number_of_random_inputs, rg);
+        std::cout << "[Checking " << number_of_random_inputs << " random binary64 inputs...]\n";
+        check_random<double>(context, number_of_random_inputs, rg);
+    }
+
+    std::cout << context.number_of_inputs << " inputs checked, " << context.number_of_mismatches
+              << " mismatches found.\n";
+    return context.number_of_mismatches == 0 ? 0 : -1;
+}
@@ -17,23 +17,27 @@
 
 #include "dragonbox/dragonbox_to_chars.h"
 #include "random_float.h"
+#include "sample_cache.h"
 #include <chrono>
 #include <iostream>
 
+// Samples are cached on disk, keyed by this seed and the parameters.
+static constexpr std::uint64_t sample_seed = UINT64_C(0xbb67ae8584caa73b);
+static constexpr char const* sample_cache_directory = "sample_cache";
+
 template <class Float>
 static void uniform_random_perf_test(std::size_t number_of_tests)
 {
-	std::cout << "Generating random samples...\n";
-	auto rg = generate_correctly_seeded_mt19937_64();
-	std::vector<Float> samples(number_of_tests);
-	for (auto& sample : samples) {
-		sample = uniformly_randomly_generate_general_float<Float>(rg);
-	}
+	std::cout << "Preparing random samples...\n";
+	auto const samples = load_or_generate_samples<Float>(sample_cache_directory, sample_seed, 0,
+		number_of_tests, [](std::mt19937_64& rg) {
+			return uniformly_randomly_generate_general_float<Float>(rg);
+		});
 
 	std::cout << "Performing test...\n";
 	char buffer[41];
 	auto from = std::chrono::steady_clock::now();
-	for (auto& sample : samples) {
+	for (auto sample : samples) {
 		jkj::dragonbox::to_chars(sample, buffer);
 	}
 	auto dur = std::chrono::steady_clock::now() - from;
@@ -44,17 +48,16 @@ static void uniform_random_perf_test(std::size_t number_of_tests)
 template <class Float>
 static void digit_perf_test(unsigned int digits, std::size_t number_of_tests)
 {
-	std::cout << "Generating random samples...\n";
-	auto rg = generate_correctly_seeded_mt19937_64();
-	std::vector<Float> samples(number_of_tests);
-	for (auto& sample : samples) {
-		sample = randomly_generate_float_with_given_digits<Float>(digits, rg);
-	}
+	std::cout << "Preparing random samples...\n";
+	auto const samples = load_or_generate_samples<Float>(sample_cache_directory, sample_seed, digits,
+		number_of_tests, [digits](std::mt19937_64& rg) {
+			return randomly_generate_float_with_given_digits<Float>(digits, rg);
+		});
 
 	std::cout << "Performing test...\n";
 	char buffer[41];
 	auto from = std::chrono::steady_clock::now();
-	for (auto& sample : samples) {
+	for (auto sample : samples) {
 		jkj::dragonbox::to_chars(sample, buffer);
 	}
 	auto dur = std::chrono::steady_clock::now() - from;
@@ -0,0 +1,69 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_to_chars.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+// Compares formatted_size against the actual length of the output of to_chars_n for every
+// binary32 input, including zeros, infinities and NaN's.
+template <class... Args>
+static bool test_all_binary32_formatted_size_impl(Args&&... args) {
+    char buffer[64];
+
+    std::size_t number_of_errors = 0;
+    for (std::uint64_t bits = 0; bits <= UINT32_C(0xffffffff); ++bits) {
+        auto const br = std::uint32_t(bits);
+        float x;
+        std::memcpy(&x, &br, sizeof(br));
+
+        auto const expected = std::size_t(jkj::dragonbox::to_chars_n(x, buffer, args...) - buffer);
+        auto const computed = jkj::dragonbox::formatted_size(x, args...);
+        if (computed != expected) {
+            if (++number_of_errors <= 10) {
+                std::cout << "Error detected! [Input = 0x" << std::hex << std::setfill('0')
+                          << std::setw(8) << br << std::dec << ", to_chars_n = "
+                          << std::string(buffer, expected) << ", formatted_size = " << computed
+                          << "]\n";
+            }
+        }
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "All cases are verified.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected.\n";
+    }
+    return number_of_errors == 0;
+}
+
+int main() {
+    bool success = true;
+
+    std::cout << "[Testing formatted_size for all binary32 inputs...]\n";
+    success &= test_all_binary32_formatted_size_impl();
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
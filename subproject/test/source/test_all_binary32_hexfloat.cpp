@@ -0,0 +1,84 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_hexfloat.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Checks that from_chars_hex reads back the output of to_chars_hex_n for every binary32 input.
+// For every 64th input, the output is also compared with printf("%a") and read back by strtof.
+static bool test_all_binary32_hexfloat_impl() {
+    char buffer[64];
+    char reference[64];
+
+    std::size_t number_of_errors = 0;
+    for (std::uint64_t bits = 0; bits <= UINT32_C(0xffffffff); ++bits) {
+        auto const br = std::uint32_t(bits);
+        float x;
+        std::memcpy(&x, &br, sizeof(br));
+
+        auto const end = jkj::dragonbox::to_chars_hex_n(x, buffer);
+        *end = '\0';
+        float parsed = 0;
+        bool success = jkj::dragonbox::from_chars_hex(buffer, end, parsed) == end &&
+                       (std::isnan(x) ? std::isnan(parsed)
+                                      : std::memcmp(&parsed, &x, sizeof(x)) == 0);
+
+        if (success && bits % 64 == 0) {
+            auto const from_strtof = std::strtof(buffer, nullptr);
+            success = std::isnan(x) ? std::isnan(from_strtof)
+                                    : std::memcmp(&from_strtof, &x, sizeof(x)) == 0;
+            // printf promotes to double, so subnormals and NaN's are printed differently.
+            if (success && std::isnormal(x)) {
+                std::snprintf(reference, sizeof(reference), "%a", double(x));
+                success = std::strcmp(buffer, reference) == 0;
+            }
+        }
+
+        if (!success && ++number_of_errors <= 10) {
+            std::cout << "Error detected! [Input = 0x" << std::hex << std::setfill('0')
+                      << std::setw(8) << br << std::dec << ", to_chars_hex = " << buffer << "]\n";
+        }
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "All cases are verified.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected.\n";
+    }
+    return number_of_errors == 0;
+}
+
+int main() {
+    bool success = true;
+
+    std::cout << "[Testing hexfloat formatting and parsing for all binary32 inputs...]\n";
+    success &= test_all_binary32_hexfloat_impl();
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
@@ -0,0 +1,62 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_bid.h"
+#include "bid_reference.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// Compares to_bid32_n, to_bid64 and to_bid128 against the reference in bid_reference.h for every
+// binary32 input. test_bid covers binary64 inputs and the clamping of exponents.
+int main() {
+    bool success = true;
+
+    std::cout << "[Testing BID conversions for all binary32 inputs...]\n";
+    {
+        constexpr std::size_t block_size = 1 << 16;
+        std::vector<float> inputs(block_size);
+        std::vector<std::uint32_t> results(block_size);
+
+        std::size_t number_of_errors = 0;
+        for (std::uint64_t block_start = 0; block_start <= UINT32_C(0xffffffff);
+             block_start += block_size) {
+            for (std::size_t i = 0; i < block_size; ++i) {
+                auto const br = std::uint32_t(block_start + i);
+                std::memcpy(&inputs[i], &br, sizeof(br));
+            }
+            jkj::dragonbox::to_bid32_n(inputs.data(), results.data(), block_size);
+            for (std::size_t i = 0; i < block_size; ++i) {
+                success &= check_all_bid_formats(inputs[i], results[i], number_of_errors);
+            }
+        }
+        if (number_of_errors != 0) {
+            std::cout << number_of_errors << " errors detected.\n";
+        }
+    }
+
+    if (success) {
+        std::cout << "All cases are verified.\n";
+    }
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
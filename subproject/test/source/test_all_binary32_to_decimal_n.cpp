@@ -0,0 +1,87 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_simd.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// Compares to_decimal_n against the scalar to_decimal for every finite nonzero binary32 input.
+// Inputs are fed in blocks whose length is not a multiple of the vector width, so both the vector
+// kernel and the scalar tail are exercised.
+int main() {
+    std::cout << "[Testing to_decimal_n for all binary32 inputs...]\n";
+    std::cout << (jkj::dragonbox::to_decimal_n_uses_avx512()
+                      ? "AVX-512 kernel is in use.\n"
+                      : "AVX-512 is not available; only the scalar path is tested.\n");
+
+    constexpr std::size_t block_size = (1 << 16) + 3;
+    std::vector<float> inputs(block_size);
+    std::vector<jkj::dragonbox::binary32_decimal_fp> results(block_size);
+
+    bool success = true;
+    std::size_t number_of_errors = 0;
+    std::size_t count = 0;
+    std::uint64_t bits = 0;
+    while (bits <= UINT32_C(0xffffffff)) {
+        for (count = 0; count < block_size && bits <= UINT32_C(0xffffffff); ++bits) {
+            auto const br = std::uint32_t(bits);
+            // Skip zeros, infinities and NaN's.
+            if ((br & UINT32_C(0x7fffffff)) == 0 ||
+                (br & UINT32_C(0x7f800000)) == UINT32_C(0x7f800000)) {
+                continue;
+            }
+            std::memcpy(&inputs[count++], &br, sizeof(br));
+        }
+
+        jkj::dragonbox::to_decimal_n(inputs.data(), results.data(), count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const expected = jkj::dragonbox::to_decimal(inputs[i]);
+            if (results[i].significand != expected.significand ||
+                results[i].exponent != expected.exponent ||
+                results[i].is_negative != expected.is_negative) {
+                success = false;
+                if (++number_of_errors <= 10) {
+                    std::uint32_t br;
+                    std::memcpy(&br, &inputs[i], sizeof(br));
+                    std::cout << "Error detected! [Input = 0x" << std::hex << std::setfill('0')
+                              << std::setw(8) << br << std::dec << ", to_decimal = "
+                              << (expected.is_negative ? "-" : "") << expected.significand << "E"
+                              << expected.exponent << ", to_decimal_n = "
+                              << (results[i].is_negative ? "-" : "") << results[i].significand
+                              << "E" << results[i].exponent << "]\n";
+                }
+            }
+        }
+    }
+
+    if (success) {
+        std::cout << "All cases are verified.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected.\n";
+    }
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
@@ -0,0 +1,123 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_bid.h"
+#include "bid_reference.h"
+#include "random_float.h"
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+// Compares to_bid32, to_bid64 and to_bid128 of binary64 inputs against the reference in
+// bid_reference.h. Conversions from binary64 into decimal32 exercise the clamping of too large and
+// too small exponents. test_all_binary32_to_bid checks every binary32 input.
+int main() {
+    bool success = true;
+
+    std::cout << "[Testing BID conversions for ties of the shortest representation...]\n";
+    {
+        // The shortest representation 13812042376882125 * 10^-16 is a tie for decimal64, but x is
+        // slightly above it.
+        auto const computed = jkj::dragonbox::to_bid64(1.3812042376882125);
+        auto const expected = (std::uint64_t(398 - 15) << 53) | UINT64_C(1381204237688213);
+        if (computed != expected) {
+            std::cout << "Error detected! [Input = 1.3812042376882125, expected = 0x" << std::hex
+                      << expected << ", computed = 0x" << computed << std::dec << "]\n";
+            success = false;
+        }
+    }
+
+    std::cout << "[Testing BID conversions with clamped exponents...]\n";
+    {
+        struct example {
+            double x;
+            std::uint32_t bid32;
+        };
+        // The exponent range of decimal32 is [-101, 90] with 7 digits.
+        example const examples[] = {
+            {1e96, UINT32_C(0x5f8f4240)},  // 1000000 * 10^90, zeros appended
+            {1e97, UINT32_C(0x78000000)},  // +Infinity
+            {-1e97, UINT32_C(0xf8000000)}, // -Infinity
+            {1e-101, UINT32_C(0x00000001)},
+            {1e-110, UINT32_C(0x00000000)},
+            {-1e-110, UINT32_C(0x80000000)},
+        };
+        for (auto const& e : examples) {
+            auto const computed = jkj::dragonbox::to_bid32(e.x);
+            if (computed != e.bid32) {
+                std::cout << "Error detected! [Input = " << e.x << ", expected = 0x" << std::hex
+                          << e.bid32 << ", computed = 0x" << computed << std::dec << "]\n";
+                success = false;
+            }
+        }
+
+        // Inputs around the boundaries, checked against the reference.
+        double const inputs[] = {9.999999e96,
+                                 9.9999994e96,
+                                 9.9999995e96,
+                                 9.9999996e96,
+                                 1.5e91,
+                                 1e-95,
+                                 9.999999e-95,
+                                 9.9999995e-95,
+                                 1.5e-101,
+                                 2.5e-101,
+                                 9.5e-101,
+                                 5e-102,
+                                 4.9999999e-102,
+                                 5.0000001e-102,
+                                 std::numeric_limits<double>::max(),
+                                 std::numeric_limits<double>::min(),
+                                 std::numeric_limits<double>::denorm_min(),
+                                 0.0,
+                                 std::numeric_limits<double>::infinity(),
+                                 std::numeric_limits<double>::quiet_NaN()};
+        std::size_t number_of_errors = 0;
+        for (auto const x : inputs) {
+            success &= check_all_bid_formats(x, jkj::dragonbox::to_bid32(x), number_of_errors);
+            success &= check_all_bid_formats(-x, jkj::dragonbox::to_bid32(-x), number_of_errors);
+        }
+    }
+
+    std::cout << "[Testing BID conversions for random binary64 inputs...]\n";
+    {
+        constexpr std::size_t number_of_samples = 10000000;
+        auto rg = generate_correctly_seeded_mt19937_64();
+
+        std::size_t number_of_errors = 0;
+        for (std::size_t i = 0; i < number_of_samples; ++i) {
+            auto const x = i % 2 == 0
+                               ? uniformly_randomly_generate_general_float<double>(rg)
+                               : randomly_generate_float_with_given_digits<double>(
+                                     unsigned(i / 2 % 17 + 1), rg);
+            success &= check_all_bid_formats(x, jkj::dragonbox::to_bid32(x), number_of_errors);
+        }
+        if (number_of_errors != 0) {
+            std::cout << number_of_errors << " errors detected.\n";
+        }
+    }
+
+    if (success) {
+        std::cout << "All cases are verified.\n";
+    }
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
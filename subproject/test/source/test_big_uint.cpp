@@ -0,0 +1,122 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "big_uint.h"
+#include "random_float.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Random numbers with the given number of elements, often containing runs of 0 and 2^64 - 1 to
+// exercise the carries and the quotient corrections.
+template <class RandGen>
+static jkj::big_uint random_big_uint(std::size_t number_of_elements, RandGen& rg) {
+    std::uniform_int_distribution<int> kind_distribution{0, 3};
+    std::vector<std::uint64_t> elements(number_of_elements);
+    auto const kind = kind_distribution(rg);
+    for (auto& element : elements) {
+        auto const element_kind = kind == 0 ? 0 : kind_distribution(rg);
+        element = element_kind == 1   ? 0
+                  : element_kind == 2 ? std::numeric_limits<std::uint64_t>::max()
+                                      : std::uint64_t(rg());
+    }
+    if (number_of_elements != 0 && elements.back() == 0) {
+        elements.back() = 1;
+    }
+    return jkj::big_uint(elements.begin(), elements.end());
+}
+
+// x * y computed by Horner's method with single-element multiplications only.
+static jkj::big_uint reference_product(jkj::big_uint const& x, jkj::big_uint const& y) {
+    jkj::big_uint result;
+    auto const number_of_elements = (log2p1(y) + 63) / 64;
+    for (auto idx = number_of_elements; idx-- > 0;) {
+        result *= std::uint64_t(1) << 32;
+        result *= std::uint64_t(1) << 32;
+        auto term = x;
+        term *= y[idx];
+        result += term;
+    }
+    return result;
+}
+
+static bool test_multiplication(std::size_t number_of_tests) {
+    auto rg = generate_correctly_seeded_mt19937_64();
+    std::uniform_int_distribution<std::size_t> size_distribution{1, 200};
+
+    std::size_t number_of_errors = 0;
+    for (std::size_t i = 0; i < number_of_tests; ++i) {
+        auto const x = random_big_uint(size_distribution(rg), rg);
+        auto const y = random_big_uint(i % 4 == 0 ? size_distribution(rg) / 8 + 1
+                                                  : size_distribution(rg),
+                                       rg);
+        if (x * y != reference_product(x, y) || y * x != reference_product(x, y)) {
+            std::cout << "Error detected! [Multiplication of " << log2p1(x) << "-bit and "
+                      << log2p1(y) << "-bit numbers]\n";
+            if (++number_of_errors >= 10) {
+                break;
+            }
+        }
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "Multiplication test with " << number_of_tests << " examples succeeded.\n";
+    }
+    return number_of_errors == 0;
+}
+
+static bool test_division(std::size_t number_of_tests) {
+    auto rg = generate_correctly_seeded_mt19937_64();
+    std::uniform_int_distribution<std::size_t> size_distribution{1, 300};
+
+    std::size_t number_of_errors = 0;
+    for (std::size_t i = 0; i < number_of_tests; ++i) {
+        auto const b = random_big_uint(size_distribution(rg), rg);
+        auto const a = i % 8 == 0 ? b * random_big_uint(size_distribution(rg), rg)
+                                  : random_big_uint(size_distribution(rg), rg);
+        auto const result = jkj::div(a, b);
+        if (result.quot * b + result.rem != a || result.rem >= b) {
+            std::cout << "Error detected! [Division of a " << log2p1(a) << "-bit number by a "
+                      << log2p1(b) << "-bit number]\n";
+            if (++number_of_errors >= 10) {
+                break;
+            }
+        }
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "Division test with " << number_of_tests << " examples succeeded.\n";
+    }
+    return number_of_errors == 0;
+}
+
+int main() {
+    bool success = true;
+
+    std::cout << "[Testing big_uint...]\n";
+    success &= test_multiplication(3000);
+    success &= test_division(3000);
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
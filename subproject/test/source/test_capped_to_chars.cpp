@@ -0,0 +1,213 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_to_chars.h"
+#include "big_uint.h"
+#include "random_float.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+struct decimal_number {
+    std::uint64_t significand;
+    int exponent;
+
+    bool operator==(decimal_number const& other) const {
+        return significand == other.significand && exponent == other.exponent;
+    }
+};
+
+static decimal_number remove_trailing_zeros(decimal_number n) {
+    while (n.significand != 0 && n.significand % 10 == 0) {
+        n.significand /= 10;
+        ++n.exponent;
+    }
+    return n;
+}
+
+// Parses the output of to_chars, e.g. "-1.234568E8".
+static decimal_number parse(char const* str) {
+    decimal_number n{0, 0};
+    if (*str == '-') {
+        ++str;
+    }
+    bool after_dot = false;
+    for (; *str != 'E'; ++str) {
+        if (*str == '.') {
+            after_dot = true;
+            continue;
+        }
+        n.significand = n.significand * 10 + std::uint64_t(*str - '0');
+        if (after_dot) {
+            --n.exponent;
+        }
+    }
+    n.exponent += std::atoi(str + 1);
+    return n;
+}
+
+// |x| * 10^k as a fraction.
+template <class Float>
+static void to_fraction(Float x, int k, jkj::big_uint& numerator, jkj::big_uint& denominator) {
+    int binary_exponent;
+    numerator = std::uint64_t(std::ldexp(std::frexp(std::abs(x), &binary_exponent),
+                                         std::numeric_limits<Float>::digits));
+    binary_exponent -= std::numeric_limits<Float>::digits;
+    denominator = 1;
+    if (binary_exponent >= 0) {
+        numerator *= jkj::big_uint::power_of_2(std::size_t(binary_exponent));
+    }
+    else {
+        denominator = jkj::big_uint::power_of_2(std::size_t(-binary_exponent));
+    }
+    if (k >= 0) {
+        numerator *= jkj::big_uint::pow(10, std::size_t(k));
+    }
+    else {
+        denominator *= jkj::big_uint::pow(10, std::size_t(-k));
+    }
+}
+
+// Reference implementation: the shortest representation if it is short enough, and otherwise
+// x rounded to max_significant_digits digits with ties to even, computed with big integers.
+template <class Float>
+static decimal_number reference_implementation(Float x, int max_significant_digits) {
+    auto const shortest = jkj::dragonbox::to_decimal(x);
+    if (jkj::dragonbox::detail::decimal_length(std::uint64_t(shortest.significand)) <=
+        max_significant_digits) {
+        return {std::uint64_t(shortest.significand), shortest.exponent};
+    }
+
+    // Find the decimal exponent d such that 10^d <= |x| < 10^(d+1).
+    jkj::big_uint numerator, denominator;
+    int d = int(std::floor(std::log10(std::abs(double(x)))));
+    while (true) {
+        to_fraction(x, -d, numerator, denominator);
+        if (numerator < denominator) {
+            --d;
+        }
+        else if (numerator >= denominator * 10) {
+            ++d;
+        }
+        else {
+            break;
+        }
+    }
+
+    auto const k = max_significant_digits - 1 - d;
+    to_fraction(x, k, numerator, denominator);
+    auto quotient = numerator.long_division(denominator);
+    auto const twice_remainder = numerator + numerator;
+    if (twice_remainder > denominator || (twice_remainder == denominator && quotient[0] % 2 != 0)) {
+        ++quotient;
+    }
+    return remove_trailing_zeros({quotient[0], -k});
+}
+
+template <class Float>
+static bool check(Float x, int max_significant_digits, std::size_t& number_of_errors) {
+    char buffer[64];
+    jkj::dragonbox::to_chars_capped(x, buffer, max_significant_digits);
+    auto const computed = parse(buffer);
+    auto const expected = reference_implementation(x, max_significant_digits);
+    if (computed == expected && std::signbit(x) == (buffer[0] == '-')) {
+        return true;
+    }
+    if (++number_of_errors <= 10) {
+        std::cout.precision(std::numeric_limits<Float>::max_digits10);
+        std::cout << "Error detected! [Input = " << x << ", digits = " << max_significant_digits
+                  << ", expected = " << expected.significand << "E" << expected.exponent
+                  << ", computed = " << buffer << "]\n";
+    }
+    return false;
+}
+
+template <class Float>
+static bool test_capped_to_chars(char const* name, std::size_t number_of_tests) {
+    auto rg = generate_correctly_seeded_mt19937_64();
+    std::uniform_int_distribution<int> digits_distribution{
+        1, std::numeric_limits<Float>::max_digits10};
+
+    std::size_t number_of_errors = 0;
+    for (std::size_t i = 0; i < number_of_tests; ++i) {
+        Float x;
+        if (i % 2 == 0) {
+            // Short decimals like 1.015, which are likely to give near-ties.
+            auto const digits = unsigned(i / 2 % std::numeric_limits<Float>::max_digits10 + 1);
+            x = randomly_generate_float_with_given_digits<Float>(digits, rg);
+        }
+        else {
+            x = uniformly_randomly_generate_general_float<Float>(rg);
+        }
+        if (!std::isfinite(x) || x == 0) {
+            continue;
+        }
+        if (i % 4 < 2) {
+            x = -x;
+        }
+        check(x, digits_distribution(rg), number_of_errors);
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "Capped to_chars test for " << name << " with " << number_of_tests
+                  << " examples succeeded.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected for " << name << ".\n";
+    }
+    return number_of_errors == 0;
+}
+
+int main() {
+    constexpr std::size_t number_of_tests = 300000;
+    bool success = true;
+
+    std::cout << "[Testing to_chars_capped...]\n";
+    struct {
+        double x;
+        int digits;
+        char const* expected;
+    } const examples[] = {{0.125, 2, "1.2E-1"},
+                          {0.375, 2, "3.8E-1"},
+                          {9.9999, 3, "1E1"},
+                          {1.015, 3, "1.01E0"},
+                          {-123456789.0, 7, "-1.234568E8"},
+                          {0.0, 1, "0E0"},
+                          {-std::numeric_limits<double>::infinity(), 3, "-Infinity"}};
+    for (auto const& example : examples) {
+        char buffer[64];
+        jkj::dragonbox::to_chars_capped(example.x, buffer, example.digits);
+        if (std::string(buffer) != example.expected) {
+            std::cout << "Error detected! [Input = " << example.x
+                      << ", digits = " << example.digits << ", expected = " << example.expected
+                      << ", computed = " << buffer << "]\n";
+            success = false;
+        }
+    }
+    success &= test_capped_to_chars<float>("float", number_of_tests);
+    success &= test_capped_to_chars<double>("double", number_of_tests);
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
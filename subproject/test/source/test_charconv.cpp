@@ -0,0 +1,186 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_charconv.h"
+#include "random_float.h"
+
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+namespace charconv = jkj::dragonbox::charconv;
+
+static std::chars_format to_std(charconv::chars_format fmt) {
+    switch (fmt) {
+    case charconv::chars_format::scientific:
+        return std::chars_format::scientific;
+    case charconv::chars_format::fixed:
+        return std::chars_format::fixed;
+    case charconv::chars_format::hex:
+        return std::chars_format::hex;
+    default:
+        return std::chars_format::general;
+    }
+}
+
+static char const* name(charconv::chars_format fmt) {
+    switch (fmt) {
+    case charconv::chars_format::scientific:
+        return "scientific";
+    case charconv::chars_format::fixed:
+        return "fixed";
+    case charconv::chars_format::hex:
+        return "hex";
+    case charconv::chars_format::general:
+        return "general";
+    default:
+        return "{}";
+    }
+}
+
+// Checks the output for [first, first + n) against std::to_chars, with n being the length of the
+// output and one less than that.
+template <class Float, class Format, class Reference>
+static bool check(Float x, charconv::chars_format fmt, Format const& format,
+                  Reference const& reference) {
+    static char expected[4096];
+    static char buffer[4096];
+    std::size_t expected_length;
+    if (fmt == charconv::chars_format{}) {
+        expected_length = std::size_t(jkj::dragonbox::to_chars_n(x, expected) - expected);
+    }
+    else {
+        auto const result = reference(expected, expected + sizeof(expected), x, to_std(fmt));
+        expected_length = std::size_t(result.ptr - expected);
+    }
+
+    auto const result = format(buffer, buffer + expected_length, x, fmt);
+    bool success = result.ec == std::errc{} && result.ptr == buffer + expected_length &&
+                   std::memcmp(buffer, expected, expected_length) == 0;
+    if (expected_length != 0) {
+        auto const short_result = format(buffer, buffer + expected_length - 1, x, fmt);
+        success = success && short_result.ec == std::errc::value_too_large &&
+                  short_result.ptr == buffer + expected_length - 1;
+    }
+    if (!success) {
+        auto const full_result = format(buffer, buffer + sizeof(buffer), x, fmt);
+        std::cout << "Error detected! [format = " << name(fmt) << ", expected = "
+                  << std::string(expected, expected_length)
+                  << ", actual = " << std::string(buffer, full_result.ptr) << "]\n";
+    }
+    return success;
+}
+
+template <class Float>
+static bool check_all_formats(Float x, int precision) {
+    bool success = true;
+    for (auto fmt : {charconv::chars_format{}, charconv::chars_format::scientific,
+                     charconv::chars_format::fixed, charconv::chars_format::general,
+                     charconv::chars_format::hex}) {
+        success &= check(
+            x, fmt,
+            [](char* first, char* last, Float y, charconv::chars_format f) {
+                return charconv::to_chars(first, last, y, f);
+            },
+            [](char* first, char* last, Float y, std::chars_format f) {
+                return std::to_chars(first, last, y, f);
+            });
+        if (fmt == charconv::chars_format{}) {
+            continue;
+        }
+        success &= check(
+            x, fmt,
+            [precision](char* first, char* last, Float y, charconv::chars_format f) {
+                return charconv::to_chars(first, last, y, f, precision);
+            },
+            [precision](char* first, char* last, Float y, std::chars_format f) {
+                return std::to_chars(first, last, y, f, precision);
+            });
+    }
+    return success;
+}
+
+template <class Float>
+static bool test_charconv(char const* type_name, std::size_t number_of_tests) {
+    auto rg = generate_correctly_seeded_mt19937_64();
+    // Mostly small precisions, sometimes large enough to print all digits of subnormals.
+    std::uniform_int_distribution<int> small_precision{-1, 20};
+    std::uniform_int_distribution<int> large_precision{21, 1200};
+
+    std::size_t number_of_errors = 0;
+    auto check_one = [&](Float x, int precision) {
+        if (!check_all_formats(x, precision)) {
+            ++number_of_errors;
+        }
+    };
+
+    for (Float x : {Float(0), -Float(0), std::numeric_limits<Float>::infinity(),
+                    -std::numeric_limits<Float>::infinity(), std::numeric_limits<Float>::quiet_NaN(),
+                    std::numeric_limits<Float>::max(), std::numeric_limits<Float>::min(),
+                    std::numeric_limits<Float>::denorm_min(), Float(0.5), Float(1.5), Float(2.5),
+                    Float(1e23), Float(9.5), Float(0.125), Float(100000), Float(1234567)}) {
+        for (int precision = -1; precision <= 30; ++precision) {
+            check_one(x, precision);
+        }
+    }
+
+    for (std::size_t i = 0; i < number_of_tests && number_of_errors < 10; ++i) {
+        Float x;
+        if (i % 2 == 0) {
+            x = uniformly_randomly_generate_general_float<Float>(rg);
+        }
+        else {
+            // Short decimals, often exactly at ties when rounded off.
+            auto const digits =
+                unsigned(i / 2 % std::numeric_limits<Float>::max_digits10 + 1);
+            x = randomly_generate_float_with_given_digits<Float>(digits, rg);
+        }
+        check_one(x, i % 16 == 0 ? large_precision(rg) : small_precision(rg));
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "std::to_chars comparison for " << type_name << " with " << number_of_tests
+                  << " examples succeeded.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected for " << type_name << ".\n";
+    }
+    return number_of_errors == 0;
+}
+
+int main() {
+    constexpr std::size_t number_of_tests = 200000;
+    bool success = true;
+
+    std::cout << "[Comparing charconv::to_chars with std::to_chars...]\n";
+    success &= test_charconv<float>("float", number_of_tests);
+    success &= test_charconv<double>("double", number_of_tests);
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
+#else
+int main() {
+    std::cout << "std::to_chars for floating-point numbers is not available; skipped.\n";
+}
+#endif
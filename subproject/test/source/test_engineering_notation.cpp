@@ -0,0 +1,180 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_to_chars.h"
+#include "random_float.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace notation = jkj::dragonbox::policy::notation;
+
+// Checks the output of the engineering notation:
+//   - it reads back to x and is not longer than max_output_string_length,
+//   - the exponent is a multiple of 3 and there are 1 to 3 digits before the decimal point,
+//   - the significant digits are exactly those of to_decimal, and
+//   - the SI prefix notation gives the same digits with the corresponding prefix.
+template <class Float>
+static bool check(Float x) {
+    char engineering[64];
+    char si_prefix[64];
+    auto const engineering_end = jkj::dragonbox::to_chars_n(x, engineering, notation::engineering);
+    *engineering_end = '\0';
+    *jkj::dragonbox::to_chars_n(x, si_prefix, notation::si_prefix_ascii) = '\0';
+
+    Float parsed;
+    char* parsed_end;
+    if (sizeof(Float) == 4) {
+        parsed = Float(std::strtof(engineering, &parsed_end));
+    }
+    else {
+        parsed = Float(std::strtod(engineering, &parsed_end));
+    }
+    if (parsed_end != engineering_end || parsed != x) {
+        return false;
+    }
+    auto const max_length =
+        sizeof(Float) == 4
+            ? jkj::dragonbox::max_output_string_length<jkj::dragonbox::ieee754_binary32>
+            : jkj::dragonbox::max_output_string_length<jkj::dragonbox::ieee754_binary64>;
+    if (std::size_t(engineering_end - engineering) > max_length) {
+        return false;
+    }
+
+    std::string const str = engineering + (engineering[0] == '-' ? 1 : 0);
+    auto const exponent_pos = str.find('E');
+    auto const point_pos = str.find('.');
+    auto const integer_length = (point_pos == std::string::npos ? exponent_pos : point_pos);
+    auto const exponent = std::atoi(str.c_str() + exponent_pos + 1);
+    if (exponent % 3 != 0 || integer_length < 1 || integer_length > 3 || str[0] == '0') {
+        return false;
+    }
+
+    std::string digits;
+    for (std::size_t i = 0; i < exponent_pos; ++i) {
+        if (str[i] != '.') {
+            digits += str[i];
+        }
+    }
+    if (point_pos != std::string::npos && str[exponent_pos - 1] == '0') {
+        // Trailing zeros after the decimal point.
+        return false;
+    }
+    while (digits.back() == '0') {
+        digits.pop_back();
+    }
+    auto const decimal = jkj::dragonbox::to_decimal(x, jkj::dragonbox::policy::sign::ignore,
+                                                    jkj::dragonbox::policy::trailing_zero::remove);
+    if (digits != std::to_string(decimal.significand)) {
+        return false;
+    }
+
+    std::string expected = std::string(engineering, engineering + (engineering_end - engineering));
+    if (exponent >= -30 && exponent <= 30) {
+        expected.erase(expected.find('E'));
+        expected += std::string("qryzafpnum kMGTPEZYRQ").substr(std::size_t(exponent / 3 + 10), 1);
+        if (exponent == 0) {
+            expected.pop_back();
+        }
+    }
+    return expected == si_prefix;
+}
+
+template <class Float>
+static bool test_engineering_notation(char const* name, std::size_t number_of_tests) {
+    auto rg = generate_correctly_seeded_mt19937_64();
+    std::uniform_int_distribution<int> exponent_distribution{-40, 40};
+
+    std::size_t number_of_errors = 0;
+    for (std::size_t i = 0; i < number_of_tests; ++i) {
+        Float x;
+        if (i % 2 == 0) {
+            // Short decimals around the range of SI prefixes.
+            auto const digits = unsigned(i / 2 % std::numeric_limits<Float>::max_digits10 + 1);
+            x = randomly_generate_float_with_given_digits<Float>(digits, rg);
+            x = Float(x * std::pow(Float(10), Float(exponent_distribution(rg))));
+        }
+        else {
+            x = uniformly_randomly_generate_general_float<Float>(rg);
+        }
+        if (!std::isfinite(x) || x == 0) {
+            continue;
+        }
+        if (i % 4 < 2) {
+            x = -x;
+        }
+        if (!check(x) && ++number_of_errors <= 10) {
+            char buffer[64];
+            jkj::dragonbox::to_chars(x, buffer, notation::engineering);
+            std::cout << "Error detected! [Engineering notation = " << buffer << "]\n";
+        }
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "Engineering notation test for " << name << " with " << number_of_tests
+                  << " examples succeeded.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected for " << name << ".\n";
+    }
+    return number_of_errors == 0;
+}
+
+int main() {
+    constexpr std::size_t number_of_tests = 1000000;
+    bool success = true;
+
+    std::cout << "[Testing engineering notation...]\n";
+    struct {
+        double x;
+        char const* engineering;
+        char const* si_prefix;
+    } const examples[] = {{12500, "12.5E3", "12.5k"},
+                          {0.00034, "340E-6", "340\xc2\xb5"},
+                          {1e5, "100E3", "100k"},
+                          {1.5, "1.5E0", "1.5"},
+                          {-2.5e-7, "-250E-9", "-250n"},
+                          {1e-40, "100E-42", "100E-42"},
+                          {0.0, "0E0", "0"},
+                          {-std::numeric_limits<double>::infinity(), "-Infinity", "-Infinity"}};
+    for (auto const& example : examples) {
+        char engineering[64];
+        char si_prefix[64];
+        jkj::dragonbox::to_chars(example.x, engineering, notation::engineering);
+        jkj::dragonbox::to_chars(example.x, si_prefix, notation::si_prefix);
+        if (std::strcmp(engineering, example.engineering) != 0 ||
+            std::strcmp(si_prefix, example.si_prefix) != 0) {
+            std::cout << "Error detected! [Expected = " << example.engineering << ", "
+                      << example.si_prefix << ", computed = " << engineering << ", " << si_prefix
+                      << "]\n";
+            success = false;
+        }
+    }
+    success &= test_engineering_notation<float>("float", number_of_tests);
+    success &= test_engineering_notation<double>("double", number_of_tests);
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
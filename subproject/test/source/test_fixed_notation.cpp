@@ -0,0 +1,201 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_charconv.h"
+#include "random_float.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace dragonbox = jkj::dragonbox;
+namespace notation = jkj::dragonbox::policy::notation;
+
+// Inserts the separators into the integer part of the ungrouped output, the slow way.
+static std::string group(std::string const& ungrouped, char decimal_separator,
+                         char grouping_separator, int grouping_size) {
+    auto const sign_length = std::size_t(ungrouped[0] == '-' ? 1 : 0);
+    auto const point_pos = ungrouped.find('.');
+    auto const integer_end = point_pos == std::string::npos ? ungrouped.size() : point_pos;
+    auto result = ungrouped.substr(0, sign_length);
+    for (auto i = sign_length; i < integer_end; ++i) {
+        if (i != sign_length && (integer_end - i) % std::size_t(grouping_size) == 0) {
+            result += grouping_separator;
+        }
+        result += ungrouped[i];
+    }
+    if (point_pos != std::string::npos) {
+        result += decimal_separator;
+        result += ungrouped.substr(point_pos + 1);
+    }
+    return result;
+}
+
+template <char DecimalSeparator, char GroupingSeparator, int GroupingSize, class Float>
+static bool check_grouping(Float x, std::string const& ungrouped) {
+    using policy = notation::fixed_t<DecimalSeparator, GroupingSeparator, GroupingSize>;
+    using format = typename dragonbox::default_float_bit_carrier_conversion_traits<Float>::format;
+    char buffer[dragonbox::max_notation_output_string_length<format, policy>];
+    auto const last = dragonbox::to_chars_n(x, buffer, policy{});
+    return std::string(buffer, last) ==
+           group(ungrouped, DecimalSeparator, GroupingSeparator, GroupingSize);
+}
+
+// Checks the output of the fixed notation:
+//   - it reads back to x and is not longer than max_notation_output_string_length,
+//   - it is the output of std::to_chars with std::chars_format::fixed if the integer part is
+//     exactly representable, and otherwise the shortest digits of to_decimal followed by zeros,
+//   - the grouped outputs are the ungrouped one with separators inserted, and
+//   - charconv::to_chars gives the same output.
+template <class Float>
+static bool check(Float x) {
+    using format = typename dragonbox::default_float_bit_carrier_conversion_traits<Float>::format;
+    char buffer[dragonbox::max_notation_output_string_length<format, notation::fixed_t<>>];
+    auto const last = dragonbox::to_chars_n(x, buffer, notation::fixed);
+    std::string const output(buffer, last);
+    if (output.size() > dragonbox::max_notation_output_string_length<format, notation::fixed_t<>>) {
+        return false;
+    }
+
+    Float parsed;
+    auto const parse_result = std::from_chars(buffer, last, parsed);
+    if (parse_result.ptr != last || parsed != x) {
+        return false;
+    }
+
+    if (std::fabs(x) < Float(std::uint64_t(1) << std::numeric_limits<Float>::digits)) {
+        char expected[512];
+        auto const expected_last =
+            std::to_chars(expected, expected + sizeof(expected), x, std::chars_format::fixed).ptr;
+        if (output != std::string(expected, expected_last)) {
+            return false;
+        }
+    }
+    else {
+        auto const decimal = dragonbox::to_decimal(x, dragonbox::policy::sign::ignore,
+                                                   dragonbox::policy::trailing_zero::remove);
+        auto const digits = std::to_string(decimal.significand);
+        if (output.substr(x < 0 ? 1 : 0) !=
+            digits + std::string(std::size_t(decimal.exponent), '0')) {
+            return false;
+        }
+    }
+
+    char charconv_buffer[512];
+    auto const charconv_result = dragonbox::charconv::to_chars(
+        charconv_buffer, charconv_buffer + output.size(), x, {}, notation::fixed);
+    if (charconv_result.ec != std::errc{} ||
+        output != std::string(charconv_buffer, charconv_result.ptr)) {
+        return false;
+    }
+
+    return check_grouping<',', '.', 3>(x, output) && check_grouping<'.', '\'', 3>(x, output) &&
+           check_grouping<'.', ',', 4>(x, output) && check_grouping<'.', ' ', 1>(x, output);
+}
+
+template <class Float>
+static bool test_fixed_notation(char const* name, std::size_t number_of_tests) {
+    auto rg = generate_correctly_seeded_mt19937_64();
+    std::uniform_int_distribution<int> exponent_distribution{-20, 20};
+
+    std::size_t number_of_errors = 0;
+    for (std::size_t i = 0; i < number_of_tests; ++i) {
+        Float x;
+        if (i % 2 == 0) {
+            // Short decimals around 1.
+            auto const digits = unsigned(i / 2 % std::numeric_limits<Float>::max_digits10 + 1);
+            x = randomly_generate_float_with_given_digits<Float>(digits, rg);
+            x = Float(x * std::pow(Float(10), Float(exponent_distribution(rg))));
+        }
+        else {
+            x = uniformly_randomly_generate_general_float<Float>(rg);
+        }
+        if (!std::isfinite(x) || x == 0) {
+            continue;
+        }
+        if (i % 4 < 2) {
+            x = -x;
+        }
+        if (!check(x) && ++number_of_errors <= 10) {
+            char buffer[64];
+            dragonbox::to_chars(x, buffer);
+            std::cout << "Error detected! [Input = " << buffer << "]\n";
+        }
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "Fixed notation test for " << name << " with " << number_of_tests
+                  << " examples succeeded.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected for " << name << ".\n";
+    }
+    return number_of_errors == 0;
+}
+
+int main() {
+    constexpr std::size_t number_of_tests = 1000000;
+    bool success = true;
+
+    std::cout << "[Testing fixed notation...]\n";
+    using european = notation::fixed_t<',', '.', 3>;
+    struct {
+        double x;
+        char const* fixed;
+        char const* grouped;
+    } const examples[] = {{1234567.89, "1234567.89", "1.234.567,89"},
+                          {-1234.5, "-1234.5", "-1.234,5"},
+                          {123.0, "123", "123"},
+                          {0.00034, "0.00034", "0,00034"},
+                          {1e5, "100000", "100.000"},
+                          {1e23, "100000000000000000000000", "100.000.000.000.000.000.000.000"},
+                          {0.0, "0", "0"},
+                          {-0.0, "-0", "-0"},
+                          {-std::numeric_limits<double>::infinity(), "-Infinity", "-Infinity"}};
+    for (auto const& example : examples) {
+        char fixed[512];
+        char grouped[512];
+        *dragonbox::to_chars_n(example.x, fixed, notation::fixed) = '\0';
+        *dragonbox::to_chars_n(example.x, grouped, european{}) = '\0';
+        if (std::strcmp(fixed, example.fixed) != 0 || std::strcmp(grouped, example.grouped) != 0) {
+            std::cout << "Error detected! [Expected = " << example.fixed << ", " << example.grouped
+                      << ", computed = " << fixed << ", " << grouped << "]\n";
+            success = false;
+        }
+    }
+    // The longest outputs.
+    for (double const x : {-std::numeric_limits<double>::max(),
+                           -std::numeric_limits<double>::denorm_min(), -2.2250738585072014e-308}) {
+        success &= check(x);
+    }
+    for (float const x : {-std::numeric_limits<float>::max(),
+                          -std::numeric_limits<float>::denorm_min(), -1.17549435e-38f}) {
+        success &= check(x);
+    }
+    success &= test_fixed_notation<float>("float", number_of_tests);
+    success &= test_fixed_notation<double>("double", number_of_tests);
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
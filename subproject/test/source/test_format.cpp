@@ -0,0 +1,246 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#if defined(DRAGONBOX_TEST_FMT)
+    #include <fmt/format.h>
+#endif
+#include "dragonbox/dragonbox_format.h"
+#include "random_float.h"
+
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace dragonbox = jkj::dragonbox;
+
+#if defined(DRAGONBOX_TEST_REQUIRE_STD_FORMAT) &&                                                   \
+    !(defined(__cpp_lib_format) && __cpp_lib_format >= 201907L)
+    #error "std::format is required but not provided by the standard library"
+#endif
+
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+struct std_format {
+    static constexpr char const* name = "std::format";
+
+    template <class T>
+    static std::string format(std::string const& format_string, T const& x) {
+        return std::vformat(format_string, std::make_format_args(x));
+    }
+
+    template <class T>
+    static bool throws(std::string const& format_string, T const& x) {
+        try {
+            format(format_string, x);
+        }
+        catch (std::format_error const&) {
+            return true;
+        }
+        return false;
+    }
+};
+#endif
+
+#if defined(FMT_VERSION)
+struct fmt_format {
+    static constexpr char const* name = "{fmt}";
+
+    template <class T>
+    static std::string format(std::string const& format_string, T const& x) {
+        return fmt::format(fmt::runtime(format_string), x);
+    }
+
+    template <class T>
+    static bool throws(std::string const& format_string, T const& x) {
+        try {
+            format(format_string, x);
+        }
+        catch (fmt::format_error const&) {
+            return true;
+        }
+        return false;
+    }
+};
+#endif
+
+// The output of to_chars_n with the sign and the padding given by the pieces of the spec.
+template <class Float>
+static std::string expected_output(Float x, std::string const& fill, char align, char sign,
+                                   int width) {
+    char buffer[64];
+    std::string output(buffer, dragonbox::to_chars_n(x, buffer));
+    if (sign != '-' && !std::signbit(x)) {
+        output.insert(output.begin(), sign);
+    }
+    auto const padding = width > int(output.size()) ? width - int(output.size()) : 0;
+    auto const left_padding = align == '<' ? 0 : align == '^' ? padding / 2 : padding;
+    std::string result;
+    for (int i = 0; i < left_padding; ++i) {
+        result += fill;
+    }
+    result += output;
+    for (int i = left_padding; i < padding; ++i) {
+        result += fill;
+    }
+    return result;
+}
+
+template <class Formatter, class Float>
+static bool test_random_specs(char const* type_name, std::size_t number_of_tests) {
+    auto rg = generate_correctly_seeded_mt19937_64();
+    char const* const fills[] = {"", " ", "*", "0", "<", "\xc2\xb5", "\xe2\x80\x94",
+                                 "\xf0\x9f\x98\x80"};
+    char const aligns[] = {'\0', '<', '>', '^'};
+    char const signs[] = {'\0', '+', '-', ' '};
+    std::uniform_int_distribution<int> fill_distribution{0, int(std::size(fills)) - 1};
+    std::uniform_int_distribution<int> align_distribution{0, 3};
+    std::uniform_int_distribution<int> sign_distribution{0, 3};
+    std::uniform_int_distribution<int> width_distribution{0, 40};
+
+    std::size_t number_of_errors = 0;
+    for (std::size_t i = 0; i < number_of_tests; ++i) {
+        Float x;
+        if (i % 16 == 0) {
+            Float const special[] = {Float(0), std::numeric_limits<Float>::infinity(),
+                                     std::numeric_limits<Float>::quiet_NaN()};
+            x = special[i / 16 % 3];
+        }
+        else {
+            x = uniformly_randomly_generate_general_float<Float>(rg);
+        }
+        if (i % 2 == 0) {
+            x = -x;
+        }
+
+        // An empty fill means no fill, and no align means no fill either.
+        std::string fill = fills[fill_distribution(rg)];
+        auto const align = aligns[align_distribution(rg)];
+        if (align == '\0') {
+            fill.clear();
+        }
+        auto const sign = signs[sign_distribution(rg)];
+        auto const width = width_distribution(rg);
+
+        std::string spec = fill;
+        if (align != '\0') {
+            spec += align;
+        }
+        if (sign != '\0') {
+            spec += sign;
+        }
+        if (width != 0) {
+            spec += std::to_string(width);
+        }
+        auto const format_string = spec.empty() ? std::string("{}") : "{:" + spec + "}";
+        auto const computed = Formatter::format(format_string, dragonbox::shortest(x));
+        auto const expected =
+            expected_output(x, fill.empty() ? std::string(" ") : fill, align == '\0' ? '>' : align,
+                            sign == '\0' ? '-' : sign, width);
+        if (computed != expected && ++number_of_errors <= 10) {
+            std::cout << "Error detected! [Format string = " << format_string
+                      << ", expected = " << expected << ", computed = " << computed << "]\n";
+        }
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << Formatter::name << " test for " << type_name << " with " << number_of_tests
+                  << " examples succeeded.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected for " << type_name << ".\n";
+    }
+    return number_of_errors == 0;
+}
+
+template <class Formatter>
+static bool test_formatter() {
+    constexpr std::size_t number_of_tests = 100000;
+    bool success = true;
+
+    struct {
+        char const* format_string;
+        double x;
+        char const* expected;
+    } const examples[] = {{"{}", 1.5, "1.5E0"},
+                          {"[{:*^11}]", 1.5, "[***1.5E0***]"},
+                          {"[{:+8}]", 1.5, "[  +1.5E0]"},
+                          {"[{:<8}]", -1.5, "[-1.5E0  ]"},
+                          {"[{: }]", 0.0, "[ 0E0]"},
+                          {"[{:+}]", -0.0, "[-0E0]"},
+                          {"[{:\xc2\xb5>7}]", 25.0, "[\xc2\xb5\xc2\xb5" "2.5E1]"},
+                          {"[{:3}]", 1e300, "[1E300]"},
+                          {"[{:+^12}]", -std::numeric_limits<double>::infinity(),
+                           "[+-Infinity++]"}};
+    for (auto const& example : examples) {
+        auto const computed =
+            Formatter::format(example.format_string, dragonbox::shortest(example.x));
+        if (computed != example.expected) {
+            std::cout << "Error detected! [Format string = " << example.format_string
+                      << ", expected = " << example.expected << ", computed = " << computed
+                      << "]\n";
+            success = false;
+        }
+    }
+    auto const engineering = dragonbox::policy::notation::engineering;
+    if (Formatter::format("[{:<9}]", dragonbox::shortest(12500.0, engineering)) != "[12.5E3   ]") {
+        std::cout << "Error detected! [Policies are not applied]\n";
+        success = false;
+    }
+
+    // Everything other than [[fill]align][sign][width] is rejected.
+    char const* const invalid_format_strings[] = {"{:05}", "{:.3}", "{:e}", "{:#}", "{:{<5}",
+                                                  "{:<<<}", "{:+-}", "{:L}", "{:999999999999}"};
+    for (auto const format_string : invalid_format_strings) {
+        if (!Formatter::throws(format_string, dragonbox::shortest(1.5))) {
+            std::cout << "Error detected! [Format string = " << format_string
+                      << " is not rejected]\n";
+            success = false;
+        }
+    }
+
+    success &= test_random_specs<Formatter, float>("float", number_of_tests);
+    success &= test_random_specs<Formatter, double>("double", number_of_tests);
+    return success;
+}
+
+int main() {
+    bool success = true;
+
+    std::cout << "[Testing formatters...]\n";
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+    success &= test_formatter<std_format>();
+#else
+    std::cout << "std::format is not available; skipped.\n";
+#endif
+#if defined(FMT_VERSION)
+    // The spec is also parsed at compile time.
+    if (fmt::format(FMT_STRING("{:*^+12}"), dragonbox::shortest(1.5)) != "***+1.5E0***") {
+        std::cout << "Error detected! [Compile-time format string]\n";
+        success = false;
+    }
+    success &= test_formatter<fmt_format>();
+#else
+    std::cout << "{fmt} is not available; skipped.\n";
+#endif
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
@@ -0,0 +1,121 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_stream.h"
+#include "random_float.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(JKJ_HAS_DRAGONBOX_FORMAT_STREAM)
+namespace dragonbox = jkj::dragonbox;
+
+// Checks that the chunks concatenate into the outputs of to_chars_n each followed by '\n', that
+// each chunk holds whole lines within chunk_size characters, and that the previous chunk is left
+// intact while the next one is formatted.
+template <class Float, class... Policies>
+static bool check(std::vector<Float> const& values, std::size_t chunk_size, Policies... policies) {
+    std::string expected;
+    for (auto const x : values) {
+        char buffer[512];
+        expected.append(buffer, dragonbox::to_chars_n(x, buffer, policies...));
+        expected += '\n';
+    }
+
+    std::string computed;
+    std::span<char const> previous;
+    std::string previous_copy;
+    for (auto const chunk : dragonbox::format_stream(std::span<Float const>(values), chunk_size,
+                                                     policies...)) {
+        // A chunk may be longer than chunk_size only if it is a single line.
+        auto const number_of_lines = std::count(chunk.begin(), chunk.end(), '\n');
+        if (chunk.empty() || chunk.back() != '\n' ||
+            (chunk.size() > chunk_size && number_of_lines != 1) ||
+            std::string(previous.begin(), previous.end()) != previous_copy) {
+            return false;
+        }
+        computed.append(chunk.begin(), chunk.end());
+        previous = chunk;
+        previous_copy.assign(chunk.begin(), chunk.end());
+    }
+    return computed == expected;
+}
+
+template <class Float>
+static bool test_format_stream(char const* name, std::size_t number_of_tests) {
+    auto rg = generate_correctly_seeded_mt19937_64();
+    std::uniform_int_distribution<std::size_t> count_distribution{0, 2000};
+    std::uniform_int_distribution<std::size_t> chunk_size_distribution{1, 4096};
+
+    std::size_t number_of_errors = 0;
+    for (std::size_t i = 0; i < number_of_tests; ++i) {
+        std::vector<Float> values(count_distribution(rg));
+        for (auto& x : values) {
+            x = uniformly_randomly_generate_general_float<Float>(rg);
+        }
+        auto const chunk_size = chunk_size_distribution(rg);
+
+        bool const success =
+            check(values, chunk_size) &&
+            check(values, chunk_size, dragonbox::policy::notation::fixed_t<',', '.', 3>{});
+        if (!success && ++number_of_errors <= 10) {
+            std::cout << "Error detected! [Count = " << values.size()
+                      << ", chunk size = " << chunk_size << "]\n";
+        }
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "format_stream test for " << name << " with " << number_of_tests
+                  << " arrays succeeded.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected for " << name << ".\n";
+    }
+    return number_of_errors == 0;
+}
+#endif
+
+int main() {
+    bool success = true;
+
+    std::cout << "[Testing format_stream...]\n";
+#if defined(JKJ_HAS_DRAGONBOX_FORMAT_STREAM)
+    constexpr std::size_t number_of_tests = 1000;
+    success &= test_format_stream<float>("float", number_of_tests);
+    success &= test_format_stream<double>("double", number_of_tests);
+
+    // An empty array gives no chunk.
+    std::vector<double> const empty;
+    for (auto const chunk : dragonbox::format_stream(std::span<double const>(empty), 64)) {
+        std::cout << "Error detected! [A chunk of size " << chunk.size()
+                  << " for an empty array]\n";
+        success = false;
+    }
+#else
+    std::cout << "Coroutines are not available; skipped.\n";
+#endif
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
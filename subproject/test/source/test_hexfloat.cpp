@@ -0,0 +1,299 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_hexfloat.h"
+#include "big_uint.h"
+#include "random_float.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+// A stand-in for a half-precision type.
+struct binary16 {
+    std::uint16_t bits;
+};
+
+struct binary16_conversion_traits {
+    using format = jkj::dragonbox::ieee754_binary16;
+    using carrier_uint = std::uint16_t;
+
+    static carrier_uint float_to_carrier(binary16 x) noexcept { return x.bits; }
+    static binary16 carrier_to_float(carrier_uint x) noexcept { return {x}; }
+};
+
+static double binary16_to_double(std::uint16_t bits) {
+    auto const exponent_bits = (bits >> 10) & 0x1f;
+    auto const significand_bits = bits & 0x3ff;
+    double value;
+    if (exponent_bits == 0x1f) {
+        value = significand_bits == 0 ? std::numeric_limits<double>::infinity()
+                                      : std::numeric_limits<double>::quiet_NaN();
+    }
+    else if (exponent_bits == 0) {
+        value = std::ldexp(double(significand_bits), -24);
+    }
+    else {
+        value = std::ldexp(double(significand_bits | 0x400), exponent_bits - 25);
+    }
+    return (bits & 0x8000) != 0 ? -value : value;
+}
+
+// Every binary16 input is formatted, compared with the exact value via strtod, and read back.
+static bool test_all_binary16() {
+    char buffer[64];
+    std::size_t number_of_errors = 0;
+    for (std::uint32_t bits = 0; bits <= 0xffff; ++bits) {
+        auto const x = binary16{std::uint16_t(bits)};
+        auto const end = jkj::dragonbox::to_chars_hex_n<binary16, binary16_conversion_traits>(
+            x, buffer);
+        *end = '\0';
+        auto const expected = binary16_to_double(x.bits);
+        auto const from_strtod = std::strtod(buffer, nullptr);
+        binary16 parsed{0};
+        auto const parsed_end =
+            jkj::dragonbox::from_chars_hex<binary16, binary16_conversion_traits>(buffer, end,
+                                                                                  parsed);
+
+        bool success = std::size_t(end - buffer) <=
+                           jkj::dragonbox::max_hex_output_string_length<
+                               jkj::dragonbox::ieee754_binary16>() &&
+                       parsed_end == end;
+        if (std::isnan(expected)) {
+            success = success && std::isnan(from_strtod) && std::isnan(binary16_to_double(parsed.bits));
+        }
+        else {
+            success = success && std::memcmp(&from_strtod, &expected, sizeof(double)) == 0 &&
+                      parsed.bits == x.bits;
+        }
+        if (!success && ++number_of_errors <= 10) {
+            std::cout << "Error detected! [Input = " << bits << ", to_chars_hex = " << buffer
+                      << "]\n";
+        }
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "All binary16 inputs are verified.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected for binary16.\n";
+    }
+    return number_of_errors == 0;
+}
+
+// Reference implementation of the parser for the strings generated below: the digits are read
+// into a big integer, which is then rounded to the nearest with ties to even. (strtod is not used,
+// because some versions of glibc misround hexadecimal inputs in the subnormal range.)
+template <class Float>
+static Float reference_parse(std::string const& str) {
+    using limits = std::numeric_limits<Float>;
+    std::size_t pos = 0;
+    bool const is_negative = str[pos] == '-';
+    pos += is_negative ? 3 : 2;
+
+    jkj::big_uint significand = 0;
+    int exponent = 0;
+    bool after_point = false;
+    bool is_zero = true;
+    for (; str[pos] != 'p' && str[pos] != 'P'; ++pos) {
+        if (str[pos] == '.') {
+            after_point = true;
+            continue;
+        }
+        auto const digit = std::stoi(str.substr(pos, 1), nullptr, 16);
+        significand *= 16;
+        significand += std::uint64_t(digit);
+        exponent -= after_point ? 4 : 0;
+        is_zero &= digit == 0;
+    }
+    exponent += std::stoi(str.substr(pos + 1));
+
+    Float result = 0;
+    if (!is_zero) {
+        // x = significand * 2^exponent is in [2^value_exponent, 2^(value_exponent + 1)).
+        auto const value_exponent = int(log2p1(significand)) - 1 + exponent;
+        if (value_exponent >= limits::max_exponent) {
+            result = limits::infinity();
+        }
+        else {
+            auto const lsb_exponent =
+                std::max(value_exponent, limits::min_exponent - 1) - (limits::digits - 1);
+            auto const shift = lsb_exponent - exponent;
+            if (shift <= 0) {
+                significand *= jkj::big_uint::power_of_2(std::size_t(-shift));
+            }
+            else {
+                auto const divisor = jkj::big_uint::power_of_2(std::size_t(shift));
+                auto quotient = significand.long_division(divisor);
+                auto const twice_remainder = significand + significand;
+                if (twice_remainder > divisor ||
+                    (twice_remainder == divisor && !quotient.is_even())) {
+                    ++quotient;
+                }
+                significand = quotient;
+            }
+            // Exact, or overflows to infinity.
+            result = std::ldexp(Float(significand.is_zero() ? 0 : significand[0]), lsb_exponent);
+        }
+    }
+    return is_negative ? -result : result;
+}
+
+template <class Float>
+static bool same(Float x, Float y) {
+    return (std::isnan(x) && std::isnan(y)) || std::memcmp(&x, &y, sizeof(Float)) == 0;
+}
+
+// Random inputs are compared with printf("%a") (for double), and random long hex strings are
+// parsed and compared with the reference implementation.
+template <class Float>
+static bool test_random(char const* name, std::size_t number_of_tests) {
+    auto rg = generate_correctly_seeded_mt19937_64();
+    std::uniform_int_distribution<int> length_distribution{1, 40};
+    std::uniform_int_distribution<int> digit_distribution{0, 15};
+    std::uniform_int_distribution<int> exponent_distribution{-1200, 1100};
+
+    char buffer[64];
+    char reference[64];
+    std::string str;
+    std::size_t number_of_errors = 0;
+    for (std::size_t i = 0; i < number_of_tests; ++i) {
+        auto const x = uniformly_randomly_generate_general_float<Float>(rg);
+        auto const end = jkj::dragonbox::to_chars_hex_n(x, buffer);
+        *end = '\0';
+        Float parsed = 0;
+        bool success = std::size_t(end - buffer) <=
+                           jkj::dragonbox::max_hex_output_string_length<
+                               typename jkj::dragonbox::default_float_bit_carrier_conversion_traits<
+                                   Float>::format>() &&
+                       jkj::dragonbox::from_chars_hex(buffer, end, parsed) == end &&
+                       same(parsed, x);
+        if (success && sizeof(Float) == 8 && std::isfinite(x)) {
+            std::snprintf(reference, sizeof(reference), "%a", double(x));
+            success = std::strcmp(buffer, reference) == 0;
+        }
+        if (!success && ++number_of_errors <= 10) {
+            std::cout << "Error detected! [to_chars_hex = " << buffer << "]\n";
+        }
+
+        // Long inputs with many digits, which need rounding, mostly near ties.
+        str = i % 2 == 0 ? "0x" : "-0X";
+        auto const length = length_distribution(rg);
+        auto const point_position = length_distribution(rg);
+        for (int j = 0; j < length; ++j) {
+            if (j == point_position) {
+                str += '.';
+            }
+            auto digit = digit_distribution(rg);
+            if (j > 0 && j % 7 != 0 && i % 3 == 0) {
+                digit = i % 2 == 0 ? 0 : 15;
+            }
+            str += "0123456789abcdefABCDEF"[digit + (digit >= 10 && j % 2 == 0 ? 6 : 0)];
+        }
+        str += i % 5 == 0 ? "P" : "p";
+        str += std::to_string(exponent_distribution(rg) / (sizeof(Float) == 4 ? 8 : 1));
+
+        auto const expected = reference_parse<Float>(str);
+        auto const str_end = str.data() + str.size();
+        success = jkj::dragonbox::from_chars_hex(str.data(), str_end, parsed) == str_end &&
+                  same(parsed, expected);
+        if (!success && ++number_of_errors <= 10) {
+            std::cout << "Error detected! [from_chars_hex input = " << str << "]\n";
+        }
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "Hexfloat test for " << name << " with " << number_of_tests
+                  << " examples succeeded.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected for " << name << ".\n";
+    }
+    return number_of_errors == 0;
+}
+
+int main() {
+    constexpr std::size_t number_of_tests = 1000000;
+    bool success = true;
+
+    std::cout << "[Testing hexfloat formatting and parsing...]\n";
+    constexpr auto infinity = std::numeric_limits<double>::infinity();
+    struct {
+        char const* input;
+        double expected;
+        std::size_t length;
+    } const examples[] = {{"0x1.8p+0", 1.5, 8},
+                          {"1.8", 1.5, 3},
+                          {"-0x.8p1x", -1.0, 7},
+                          {"0x1p", 1.0, 3},
+                          {"0x", 0.0, 1},
+                          {"Infinity", infinity, 8},
+                          {"0x1p-1075", 0.0, 9},
+                          {"0x1.8p-1075", std::ldexp(1.0, -1074), 11},
+                          {"0x1p+1024", infinity, 9},
+                          {"0x1.fffffffffffff8p+1023", infinity, 24}};
+    for (auto const& example : examples) {
+        double parsed = -1;
+        auto const end = jkj::dragonbox::from_chars_hex(
+            example.input, example.input + std::strlen(example.input), parsed);
+        if (std::size_t(end - example.input) != example.length || parsed != example.expected) {
+            std::cout << "Error detected! [from_chars_hex input = " << example.input << "]\n";
+            success = false;
+        }
+    }
+    double untouched = 1;
+    char const empty[] = "p+1";
+    if (jkj::dragonbox::from_chars_hex(empty, empty + 3, untouched) != empty || untouched != 1) {
+        std::cout << "Error detected! [from_chars_hex input = p+1]\n";
+        success = false;
+    }
+
+    // Long runs of digits compensating a large exponent.
+    struct {
+        std::string input;
+        double expected;
+    } const long_examples[] = {
+        {"0x0." + std::string(300000, '0') + "1p+1200000", std::ldexp(1.0, -4)},
+        {"0x1" + std::string(1000000, '0') + "p-4000000", 1.0}};
+    for (auto const& example : long_examples) {
+        double parsed = -1;
+        auto const input_end = example.input.data() + example.input.size();
+        if (jkj::dragonbox::from_chars_hex(example.input.data(), input_end, parsed) != input_end ||
+            parsed != example.expected) {
+            std::cout << "Error detected! [from_chars_hex input = "
+                      << example.input.substr(0, 16) << "... of length " << example.input.size()
+                      << "]\n";
+            success = false;
+        }
+    }
+
+    success &= test_all_binary16();
+    success &= test_random<float>("float", number_of_tests);
+    success &= test_random<double>("double", number_of_tests);
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
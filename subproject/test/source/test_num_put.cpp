@@ -0,0 +1,201 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_num_put.h"
+#include "random_float.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+
+struct comma_numpunct : std::numpunct<char> {
+    char do_decimal_point() const override { return ','; }
+};
+
+struct grouping_numpunct : std::numpunct<char> {
+    char do_thousands_sep() const override { return '\''; }
+    std::string do_grouping() const override { return "\3"; }
+};
+
+// Formats x with the same stream state into a stream with the standard facet and into one with
+// jkj::dragonbox::num_put, and compares the outputs.
+class checker {
+public:
+    explicit checker(std::locale const& base)
+        : reference_locale_(base),
+          dragonbox_locale_(base, new jkj::dragonbox::num_put<>) {}
+
+    template <class Float, class Manipulator>
+    bool check(Float x, Manipulator const& manipulator) {
+        std::ostringstream reference, dragonbox;
+        reference.imbue(reference_locale_);
+        dragonbox.imbue(dragonbox_locale_);
+        manipulator(reference);
+        manipulator(dragonbox);
+        reference << x << '|' << x;
+        dragonbox << x << '|' << x;
+        if (reference.str() != dragonbox.str()) {
+            std::cout << "Error detected! [Expected = " << reference.str()
+                      << ", computed = " << dragonbox.str() << "]\n";
+            return false;
+        }
+        return true;
+    }
+
+private:
+    std::locale reference_locale_;
+    std::locale dragonbox_locale_;
+};
+
+template <class Float>
+static bool test_random_stream_states(checker& c, char const* name, std::size_t number_of_tests) {
+    auto rg = generate_correctly_seeded_mt19937_64();
+    std::ios_base::fmtflags const floatfields[] = {
+        std::ios_base::fmtflags{}, std::ios_base::fixed, std::ios_base::scientific,
+        std::ios_base::fixed | std::ios_base::scientific};
+    std::ios_base::fmtflags const adjustfields[] = {std::ios_base::fmtflags{}, std::ios_base::left,
+                                                    std::ios_base::right, std::ios_base::internal};
+    std::uniform_int_distribution<int> flag_distribution{0, 3};
+    std::uniform_int_distribution<int> precision_distribution{-1, 20};
+    std::uniform_int_distribution<int> large_precision_distribution{21, 120};
+    std::uniform_int_distribution<int> width_distribution{0, 40};
+    std::uniform_int_distribution<int> bool_distribution{0, 1};
+
+    std::size_t number_of_errors = 0;
+    for (std::size_t i = 0; i < number_of_tests; ++i) {
+        Float x;
+        if (i % 32 == 0) {
+            Float const special[] = {Float(0), std::numeric_limits<Float>::infinity(),
+                                     std::numeric_limits<Float>::quiet_NaN()};
+            x = special[i / 32 % 3];
+        }
+        else if (i % 2 == 0) {
+            auto const digits = unsigned(i / 2 % std::numeric_limits<Float>::max_digits10 + 1);
+            x = randomly_generate_float_with_given_digits<Float>(digits, rg);
+        }
+        else {
+            x = uniformly_randomly_generate_general_float<Float>(rg);
+        }
+        if (i % 4 < 2) {
+            x = -x;
+        }
+
+        auto flags = floatfields[flag_distribution(rg)] | adjustfields[flag_distribution(rg)];
+        if (bool_distribution(rg)) {
+            flags |= std::ios_base::showpos;
+        }
+        if (bool_distribution(rg)) {
+            flags |= std::ios_base::uppercase;
+        }
+        auto const precision = i % 16 == 1 ? large_precision_distribution(rg)
+                                           : precision_distribution(rg);
+        auto const width = width_distribution(rg);
+        auto const manipulator = [&](std::ostream& stream) {
+            stream.flags(flags);
+            stream.precision(precision);
+            stream.width(width);
+            stream.fill('*');
+        };
+        if (!c.check(x, manipulator) && ++number_of_errors >= 10) {
+            break;
+        }
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "num_put test for " << name << " with " << number_of_tests
+                  << " examples succeeded.\n";
+    }
+    return number_of_errors == 0;
+}
+
+// In the shortest mode, the default floatfield gives the output of std::to_chars.
+static bool test_shortest(std::size_t number_of_tests) {
+    auto rg = generate_correctly_seeded_mt19937_64();
+    std::ostringstream stream;
+    stream.imbue(std::locale(std::locale::classic(), new jkj::dragonbox::num_put<>(true)));
+    stream.precision(17);
+
+    std::size_t number_of_errors = 0;
+    for (std::size_t i = 0; i < number_of_tests; ++i) {
+        auto const x = uniformly_randomly_generate_general_float<double>(rg);
+        if (x != x) {
+            continue;
+        }
+        stream.str({});
+        stream << x;
+
+        char buffer[64];
+        auto const result = jkj::dragonbox::charconv::to_chars(
+            buffer, buffer + sizeof(buffer), x, jkj::dragonbox::charconv::chars_format::general);
+        auto const output = stream.str();
+        if (output != std::string(buffer, result.ptr) || std::strtod(output.c_str(), nullptr) != x) {
+            std::cout << "Error detected! [Shortest output = " << output << "]\n";
+            if (++number_of_errors >= 10) {
+                break;
+            }
+        }
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "Shortest num_put test with " << number_of_tests << " examples succeeded.\n";
+    }
+    return number_of_errors == 0;
+}
+
+int main() {
+    constexpr std::size_t number_of_tests = 200000;
+    bool success = true;
+
+    std::cout << "[Testing num_put...]\n";
+    {
+        checker c{std::locale::classic()};
+        success &= test_random_stream_states<float>(c, "float", number_of_tests);
+        success &= test_random_stream_states<double>(c, "double", number_of_tests);
+    }
+    {
+        // A different decimal point.
+        checker c{std::locale(std::locale::classic(), new comma_numpunct)};
+        success &= test_random_stream_states<double>(c, "double with ','", number_of_tests / 10);
+    }
+    {
+        // Handed over to std::num_put.
+        checker c{std::locale(std::locale::classic(), new grouping_numpunct)};
+        success &=
+            test_random_stream_states<double>(c, "double with grouping", number_of_tests / 10);
+    }
+    {
+        // Also handed over to std::num_put.
+        checker c{std::locale::classic()};
+        success &= c.check(2.0, [](std::ostream& stream) {
+            stream.setf(std::ios_base::showpoint);
+            stream.precision(3);
+        });
+        success &= c.check(2.0, [](std::ostream& stream) {
+            stream.setf(std::ios_base::showpoint | std::ios_base::fixed);
+            stream.precision(0);
+        });
+    }
+    success &= test_shortest(number_of_tests);
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
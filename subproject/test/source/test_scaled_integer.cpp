@@ -0,0 +1,213 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_scaled_integer.h"
+#include "big_uint.h"
+#include "random_float.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+// Reference implementation: rounds numerator / denominator using big integers.
+template <class BinaryToDecimalRoundingPolicy>
+static jkj::dragonbox::scaled_integer_result round_fraction(bool is_negative,
+                                                            jkj::big_uint numerator,
+                                                            jkj::big_uint const& denominator) {
+    constexpr auto max = std::numeric_limits<std::int64_t>::max();
+    constexpr auto min = std::numeric_limits<std::int64_t>::min();
+
+    auto quotient = numerator.long_division(denominator);
+    auto const twice_remainder = numerator + numerator;
+    if (twice_remainder > denominator) {
+        ++quotient;
+    }
+    else if (twice_remainder == denominator) {
+        auto rounded_up = quotient + 1;
+        if (log2p1(rounded_up) <= 64 &&
+            !BinaryToDecimalRoundingPolicy::prefer_round_down(rounded_up[0])) {
+            quotient = rounded_up;
+        }
+    }
+
+    auto const limit = std::uint64_t(max) + (is_negative ? 1 : 0);
+    if (log2p1(quotient) > 64 || (quotient != 0 && quotient[0] > limit)) {
+        return {is_negative ? min : max, true};
+    }
+    auto const magnitude = quotient == 0 ? 0 : quotient[0];
+    return {is_negative ? std::int64_t(0 - magnitude) : std::int64_t(magnitude), false};
+}
+
+// Computes significand * 2^binary_exponent * 10^decimal_exponent as a fraction and rounds it.
+template <class BinaryToDecimalRoundingPolicy>
+static jkj::dragonbox::scaled_integer_result
+reference_round(bool is_negative, std::uint64_t significand, int binary_exponent,
+                int decimal_exponent) {
+    jkj::big_uint numerator = significand;
+    jkj::big_uint denominator = 1;
+    if (binary_exponent >= 0) {
+        numerator *= jkj::big_uint::power_of_2(std::size_t(binary_exponent));
+    }
+    else {
+        denominator = jkj::big_uint::power_of_2(std::size_t(-binary_exponent));
+    }
+    if (decimal_exponent >= 0) {
+        numerator *= jkj::big_uint::pow(10, std::size_t(decimal_exponent));
+    }
+    else {
+        denominator *= jkj::big_uint::pow(10, std::size_t(-decimal_exponent));
+    }
+    return round_fraction<BinaryToDecimalRoundingPolicy>(is_negative, numerator, denominator);
+}
+
+template <class Float, class BinaryToDecimalRoundingPolicy, bool shortest>
+static jkj::dragonbox::scaled_integer_result reference_implementation(Float x, int k) {
+    constexpr auto max = std::numeric_limits<std::int64_t>::max();
+    constexpr auto min = std::numeric_limits<std::int64_t>::min();
+    if (std::isnan(x)) {
+        return {0, true};
+    }
+    bool const is_negative = std::signbit(x);
+    if (std::isinf(x)) {
+        return {is_negative ? min : max, true};
+    }
+    if (x == 0) {
+        return {0, false};
+    }
+
+    if (shortest) {
+        auto const decimal = jkj::dragonbox::to_decimal(x);
+        return reference_round<BinaryToDecimalRoundingPolicy>(
+            is_negative, decimal.significand, 0, decimal.exponent + k);
+    }
+    int binary_exponent;
+    auto const m = std::uint64_t(std::ldexp(std::frexp(std::abs(x), &binary_exponent),
+                                            std::numeric_limits<Float>::digits));
+    binary_exponent -= std::numeric_limits<Float>::digits;
+    return reference_round<BinaryToDecimalRoundingPolicy>(is_negative, m, binary_exponent, k);
+}
+
+template <class Float, class BinaryToDecimalRoundingPolicy, bool shortest>
+static bool check(Float x, int k, std::size_t& number_of_errors) {
+    auto const computed =
+        shortest ? jkj::dragonbox::to_scaled_integer_shortest(x, k, BinaryToDecimalRoundingPolicy{})
+                 : jkj::dragonbox::to_scaled_integer(x, k, BinaryToDecimalRoundingPolicy{});
+    auto const expected =
+        reference_implementation<Float, BinaryToDecimalRoundingPolicy, shortest>(x, k);
+    if (computed.value == expected.value && computed.overflow == expected.overflow) {
+        return true;
+    }
+    if (++number_of_errors <= 10) {
+        std::cout.precision(std::numeric_limits<Float>::max_digits10);
+        std::cout << "Error detected! [Input = " << x << ", k = " << k
+                  << (shortest ? " (shortest)" : "") << ", expected = " << expected.value
+                  << (expected.overflow ? " (overflow)" : "") << ", computed = " << computed.value
+                  << (computed.overflow ? " (overflow)" : "") << "]\n";
+    }
+    return false;
+}
+
+template <class Float, class BinaryToDecimalRoundingPolicy>
+static bool test_scaled_integer(char const* name, std::size_t number_of_tests) {
+    auto rg = generate_correctly_seeded_mt19937_64();
+    std::uniform_int_distribution<int> k_distribution{jkj::dragonbox::min_scaled_integer_exponent,
+                                                      jkj::dragonbox::max_scaled_integer_exponent};
+    std::uniform_int_distribution<int> offset_distribution{-3, 3};
+    std::uniform_int_distribution<std::uint64_t> integer_distribution{
+        1, std::uint64_t(1) << std::numeric_limits<Float>::digits};
+    std::uniform_int_distribution<int> dyadic_exponent_distribution{1, 8};
+
+    std::size_t number_of_errors = 0;
+    for (std::size_t i = 0; i < number_of_tests; ++i) {
+        Float x;
+        int k;
+        switch (i % 3) {
+        case 0:
+            // Short decimals like 1.005, scaled by a nearby power of 10.
+            {
+                auto const digits = unsigned(i / 3 % std::numeric_limits<Float>::max_digits10 + 1);
+                x = randomly_generate_float_with_given_digits<Float>(digits, rg);
+                int decimal_exponent;
+                std::frexp(x, &decimal_exponent);
+                decimal_exponent = int(std::floor(decimal_exponent * 0.30103));
+                k = std::min(std::max(int(digits) - 1 - decimal_exponent + offset_distribution(rg),
+                                      jkj::dragonbox::min_scaled_integer_exponent),
+                             jkj::dragonbox::max_scaled_integer_exponent);
+            }
+            break;
+
+        case 1:
+            // Dyadic rationals, which give exact ties.
+            x = Float(integer_distribution(rg)) /
+                Float(std::uint64_t(1) << dyadic_exponent_distribution(rg));
+            k = offset_distribution(rg);
+            break;
+
+        default:
+            // Arbitrary bit patterns, mostly overflowing or rounding to zero.
+            x = uniformly_randomly_generate_general_float<Float>(rg);
+            k = k_distribution(rg);
+            break;
+        }
+        if (i % 2 == 0) {
+            x = -x;
+        }
+        check<Float, BinaryToDecimalRoundingPolicy, false>(x, k, number_of_errors);
+        check<Float, BinaryToDecimalRoundingPolicy, true>(x, k, number_of_errors);
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "Scaled integer test for " << name << " with " << number_of_tests
+                  << " examples succeeded.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected for " << name << ".\n";
+    }
+    return number_of_errors == 0;
+}
+
+int main() {
+    namespace policy = jkj::dragonbox::policy;
+    constexpr std::size_t number_of_tests = 1000000;
+    bool success = true;
+
+    std::cout << "[Testing to_scaled_integer...]\n";
+    if (jkj::dragonbox::to_scaled_integer(1.015, 2).value != 101 ||
+        jkj::dragonbox::to_scaled_integer_shortest(1.015, 2).value != 102) {
+        std::cout << "Error detected! [Input = 1.015, k = 2]\n";
+        success = false;
+    }
+    success &= test_scaled_integer<float, policy::binary_to_decimal_rounding::to_even_t>(
+        "float (to_even)", number_of_tests);
+    success &= test_scaled_integer<double, policy::binary_to_decimal_rounding::to_even_t>(
+        "double (to_even)", number_of_tests);
+    success &= test_scaled_integer<double, policy::binary_to_decimal_rounding::to_odd_t>(
+        "double (to_odd)", number_of_tests);
+    success &= test_scaled_integer<double, policy::binary_to_decimal_rounding::away_from_zero_t>(
+        "double (away_from_zero)", number_of_tests);
+    success &= test_scaled_integer<double, policy::binary_to_decimal_rounding::toward_zero_t>(
+        "double (toward_zero)", number_of_tests);
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
@@ -0,0 +1,130 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_simd.h"
+#include "random_float.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+static float float_from_bits(std::uint32_t br) {
+    float x;
+    std::memcpy(&x, &br, sizeof(br));
+    return x;
+}
+
+// Compares to_decimal_n(x, results, count) with the scalar to_decimal.
+static bool check(float const* x, std::size_t count, std::size_t& number_of_errors) {
+    std::vector<jkj::dragonbox::binary32_decimal_fp> results(count + 1);
+    // A sentinel after the last result must not be written.
+    results[count] = {12345, 67, true};
+    jkj::dragonbox::to_decimal_n(x, results.data(), count);
+
+    bool success = results[count].significand == 12345 && results[count].exponent == 67 &&
+                   results[count].is_negative;
+    if (!success && ++number_of_errors <= 10) {
+        std::cout << "Error detected! [Result past count = " << count << " is overwritten]\n";
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const expected = jkj::dragonbox::to_decimal(x[i]);
+        if (results[i].significand != expected.significand ||
+            results[i].exponent != expected.exponent ||
+            results[i].is_negative != expected.is_negative) {
+            success = false;
+            if (++number_of_errors <= 10) {
+                std::uint32_t br;
+                std::memcpy(&br, &x[i], sizeof(br));
+                std::cout << "Error detected! [Input = 0x" << std::hex << std::setfill('0')
+                          << std::setw(8) << br << std::dec << std::setfill(' ')
+                          << ", to_decimal = " << (expected.is_negative ? "-" : "")
+                          << expected.significand << "E" << expected.exponent
+                          << ", to_decimal_n = " << (results[i].is_negative ? "-" : "")
+                          << results[i].significand << "E" << results[i].exponent << "]\n";
+            }
+        }
+    }
+    return success;
+}
+
+// Compares to_decimal_n against the scalar to_decimal for edge cases and random inputs, with
+// every count from 0 to 17 and every offset of the pointers modulo the vector width, so that the
+// vector kernel, the scalar tail and unaligned accesses are all exercised. If AVX-512 is not
+// available, the scalar fallback is tested instead. test_all_binary32_to_decimal_n checks every
+// binary32 input.
+int main() {
+    std::cout << "[Testing to_decimal_n...]\n";
+    std::cout << (jkj::dragonbox::to_decimal_n_uses_avx512()
+                      ? "AVX-512 kernel is in use.\n"
+                      : "AVX-512 is not available; only the scalar path is tested.\n");
+
+    std::vector<float> inputs;
+    // Subnormals.
+    for (std::uint32_t br : {UINT32_C(0x00000001), UINT32_C(0x00000002), UINT32_C(0x00000003),
+                             UINT32_C(0x00000400), UINT32_C(0x00400000), UINT32_C(0x007ffffe),
+                             UINT32_C(0x007fffff)}) {
+        inputs.push_back(float_from_bits(br));
+    }
+    // Powers of 2, which fall into the shorter interval case, and their neighbors.
+    for (std::uint32_t exponent_bits = 1; exponent_bits < 0xff; ++exponent_bits) {
+        auto const br = exponent_bits << 23;
+        inputs.push_back(float_from_bits(br - 1));
+        inputs.push_back(float_from_bits(br));
+        inputs.push_back(float_from_bits(br + 1));
+    }
+    inputs.push_back(float_from_bits(UINT32_C(0x7f7fffff)));
+    auto const number_of_edge_cases = inputs.size();
+    for (std::size_t i = 0; i < number_of_edge_cases; ++i) {
+        inputs.push_back(-inputs[i]);
+    }
+    // Random inputs, half of them with few digits so that trailing zeros are removed.
+    auto rg = generate_correctly_seeded_mt19937_64();
+    for (std::size_t i = 0; i < 100000; ++i) {
+        auto const x = i % 2 == 0 ? uniformly_randomly_generate_general_float<float>(rg)
+                                  : randomly_generate_float_with_given_digits<float>(
+                                        unsigned(i / 2 % 9 + 1), rg);
+        if (std::isfinite(x) && x != 0) {
+            inputs.push_back(x);
+        }
+    }
+
+    bool success = true;
+    std::size_t number_of_errors = 0;
+    success &= check(inputs.data(), inputs.size(), number_of_errors);
+    for (std::size_t count = 0; count <= 17; ++count) {
+        for (std::size_t offset = 0; offset < 8; ++offset) {
+            for (std::size_t first = offset; first + count <= inputs.size(); first += 997) {
+                success &= check(inputs.data() + first, count, number_of_errors);
+            }
+        }
+    }
+
+    if (success) {
+        std::cout << "All cases are verified.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected.\n";
+    }
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
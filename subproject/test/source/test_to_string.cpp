@@ -0,0 +1,136 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_string.h"
+#include "random_float.h"
+
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <type_traits>
+
+namespace dragonbox = jkj::dragonbox;
+
+static_assert(std::is_trivially_copyable<decltype(dragonbox::to_string(1.0))>::value,
+              "the result of to_string should be trivially copyable");
+static_assert(decltype(dragonbox::to_string(1.0))::capacity() ==
+                  dragonbox::max_output_string_length<dragonbox::ieee754_binary64>,
+              "");
+static_assert(sizeof(dragonbox::to_string(1.0f)) ==
+                  dragonbox::max_output_string_length<dragonbox::ieee754_binary32> + 2,
+              "");
+static_assert(decltype(dragonbox::to_string(1.0, dragonbox::policy::notation::fixed))::capacity() ==
+                  dragonbox::max_notation_output_string_length<
+                      dragonbox::ieee754_binary64, dragonbox::policy::notation::fixed_t<>>,
+              "");
+
+// Compares to_string and append_to with to_chars_n for the given policies.
+template <class Float, class... Policies>
+static bool check(Float x, std::string& appended, Policies... policies) {
+    char buffer[512];
+    auto const expected =
+        std::string(buffer, dragonbox::to_chars_n(x, buffer, policies...));
+
+    auto const str = dragonbox::to_string(x, policies...);
+    auto const copy = str;
+    auto const previous_size = appended.size();
+    dragonbox::append_to(appended, x, policies...);
+
+    return copy.str() == expected && copy.size() == expected.size() &&
+           std::strlen(copy.c_str()) == expected.size() &&
+           std::string(copy.begin(), copy.end()) == expected &&
+#if defined(__cpp_lib_string_view) && __cpp_lib_string_view >= 201606L
+           std::string_view(copy) == expected &&
+#endif
+           appended.size() == previous_size + expected.size() &&
+           appended.compare(previous_size, expected.size(), expected) == 0;
+}
+
+template <class Float>
+static bool test_to_string(char const* name, std::size_t number_of_tests) {
+    auto rg = generate_correctly_seeded_mt19937_64();
+    std::string appended = "prefix";
+
+    std::size_t number_of_errors = 0;
+    for (std::size_t i = 0; i < number_of_tests; ++i) {
+        Float x;
+        if (i % 64 == 0) {
+            Float const special[] = {Float(0), std::numeric_limits<Float>::infinity(),
+                                     std::numeric_limits<Float>::quiet_NaN()};
+            x = special[i / 64 % 3];
+        }
+        else if (i % 2 == 0) {
+            auto const digits = unsigned(i / 2 % std::numeric_limits<Float>::max_digits10 + 1);
+            x = randomly_generate_float_with_given_digits<Float>(digits, rg);
+        }
+        else {
+            x = uniformly_randomly_generate_general_float<Float>(rg);
+        }
+        if (i % 4 < 2) {
+            x = -x;
+        }
+        if (appended.size() > 100000) {
+            appended.resize(6);
+        }
+
+        bool const success =
+            check(x, appended) &&
+            check(x, appended, dragonbox::policy::notation::engineering) &&
+            check(x, appended, dragonbox::policy::notation::fixed_t<',', '.', 3>{});
+        if (!success && ++number_of_errors <= 10) {
+            char buffer[64];
+            dragonbox::to_chars(x, buffer);
+            std::cout << "Error detected! [Input = " << buffer << "]\n";
+        }
+    }
+    if (appended.compare(0, 6, "prefix") != 0) {
+        std::cout << "Error detected! [The existing contents are overwritten]\n";
+        ++number_of_errors;
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "to_string test for " << name << " with " << number_of_tests
+                  << " examples succeeded.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected for " << name << ".\n";
+    }
+    return number_of_errors == 0;
+}
+
+int main() {
+    constexpr std::size_t number_of_tests = 1000000;
+    bool success = true;
+
+    std::cout << "[Testing to_string...]\n";
+    {
+        decltype(dragonbox::to_string(1.0)) const empty;
+        if (!empty.empty() || empty.c_str()[0] != '\0') {
+            std::cout << "Error detected! [A default-constructed inline_string is not empty]\n";
+            success = false;
+        }
+    }
+    success &= test_to_string<float>("float", number_of_tests);
+    success &= test_to_string<double>("double", number_of_tests);
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
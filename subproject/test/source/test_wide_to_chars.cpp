@@ -0,0 +1,121 @@
+// Copyright 2022 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "dragonbox/dragonbox_to_chars.h"
+#include "random_float.h"
+
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+// Checks that the outputs into buffers of CharT are those into a char buffer converted character
+// by character, for both digit generation policies.
+template <class CharT, class Float>
+static bool check(Float x) {
+    char expected[64];
+    auto const expected_end = jkj::dragonbox::to_chars_n(x, expected);
+
+    CharT fast[64];
+    CharT compact[64];
+    auto const fast_end = jkj::dragonbox::to_chars(x, fast);
+    auto const compact_end =
+        jkj::dragonbox::to_chars(x, compact, jkj::dragonbox::policy::digit_generation::compact);
+    if (fast_end - fast != expected_end - expected || compact_end - compact != fast_end - fast ||
+        *fast_end != CharT('\0') || *compact_end != CharT('\0')) {
+        return false;
+    }
+    for (std::ptrdiff_t i = 0; i < expected_end - expected; ++i) {
+        if (fast[i] != CharT(expected[i]) || compact[i] != CharT(expected[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class CharT, class Float>
+static bool test_wide_to_chars(char const* name, std::size_t number_of_tests) {
+    auto rg = generate_correctly_seeded_mt19937_64();
+
+    std::size_t number_of_errors = 0;
+    for (std::size_t i = 0; i < number_of_tests; ++i) {
+        Float x;
+        if (i % 64 == 0) {
+            Float const special[] = {Float(0), std::numeric_limits<Float>::infinity(),
+                                     std::numeric_limits<Float>::quiet_NaN()};
+            x = special[i / 64 % 3];
+        }
+        else if (i % 2 == 0) {
+            auto const digits = unsigned(i / 2 % std::numeric_limits<Float>::max_digits10 + 1);
+            x = randomly_generate_float_with_given_digits<Float>(digits, rg);
+        }
+        else {
+            x = uniformly_randomly_generate_general_float<Float>(rg);
+        }
+        if (i % 4 < 2) {
+            x = -x;
+        }
+        if (!check<CharT>(x) && ++number_of_errors <= 10) {
+            char buffer[64];
+            jkj::dragonbox::to_chars(x, buffer);
+            std::cout << "Error detected! [Input = " << buffer << "]\n";
+        }
+    }
+
+    if (number_of_errors == 0) {
+        std::cout << "Wide to_chars test for " << name << " with " << number_of_tests
+                  << " examples succeeded.\n";
+    }
+    else {
+        std::cout << number_of_errors << " errors detected for " << name << ".\n";
+    }
+    return number_of_errors == 0;
+}
+
+template <class CharT>
+static bool test_character_type(char const* float_name, char const* double_name,
+                                std::size_t number_of_tests) {
+    bool success = true;
+    success &= test_wide_to_chars<CharT, float>(float_name, number_of_tests);
+    success &= test_wide_to_chars<CharT, double>(double_name, number_of_tests);
+    return success;
+}
+
+int main() {
+    constexpr std::size_t number_of_tests = 1000000;
+    bool success = true;
+
+    std::cout << "[Testing to_chars with wide characters...]\n";
+    success &=
+        test_character_type<wchar_t>("float to wchar_t", "double to wchar_t", number_of_tests);
+    success &=
+        test_character_type<char16_t>("float to char16_t", "double to char16_t", number_of_tests);
+    success &=
+        test_character_type<char32_t>("float to char32_t", "double to char32_t", number_of_tests);
+#if defined(__cpp_char8_t) && __cpp_char8_t >= 201811L
+    success &=
+        test_character_type<char8_t>("float to char8_t", "double to char8_t", number_of_tests);
+#else
+    std::cout << "char8_t is not available; skipped.\n";
+#endif
+    std::cout << "Done.\n\n\n";
+
+    if (!success) {
+        return -1;
+    }
+}
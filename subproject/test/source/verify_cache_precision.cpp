@@ -18,6 +18,7 @@
 #include "best_rational_approx.h"
 #include "good_rational_approx.h"
 #include "big_uint.h"
+#include "parallel_for.h"
 #include "rational_continued_fractions.h"
 #include "dragonbox/dragonbox.h"
 #include <algorithm>
@@ -26,7 +27,9 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <optional>
 #include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -63,171 +66,220 @@ struct analysis_result {
         std::vector<jkj::big_uint> candidate_multipliers{};
     };
     std::vector<error_case> error_cases;
+
+    // What is computed for each e independently.
+    struct result_per_exponent {
+        int k;
+        int sufficient_bits_for_multiplication;
+        int sufficient_bits_for_integer_checks;
+        jkj::unsigned_rational<jkj::big_uint> distance_to_upper_bound;
+        std::optional<error_case> error_case_for_e;
+    };
 };
 
 template <class FormatTraits>
-static bool analyze(std::ostream& out, std::size_t cache_bits) {
-    out << "e,bits_for_multiplication,bits_for_integer_check\n";
-
+static analysis_result::result_per_exponent analyze_exponent(int e, std::size_t cache_bits) {
     using impl = jkj::dragonbox::detail::impl<FormatTraits>;
     using namespace jkj::dragonbox::detail::log;
 
     auto n_max = jkj::big_uint::power_of_2(impl::significand_bits + 2);
 
-    analysis_result result;
-    result.results.resize(impl::max_k - impl::min_k + 1);
+    int k = impl::kappa - floor_log10_pow2(e);
+    auto exp_2 = k - floor_log2_pow10(k) - 1;
+    int beta = e + floor_log2_pow10(k);
 
+    analysis_result::result_per_exponent result{k, 0, 0, {}, std::nullopt};
+
+    // target = 2^(k - klog2(10) - 1) * 5^k = phi_k / 2^Q in [1/2, 1).
     jkj::unsigned_rational<jkj::big_uint> target{1, 1}, unit;
-    int prev_k = impl::max_k + 1;
-    for (int e = impl::min_exponent - impl::significand_bits;
-         e <= impl::max_exponent - impl::significand_bits; ++e) {
-        int k = impl::kappa - floor_log10_pow2(e);
-        auto exp_2 = k - floor_log2_pow10(k) - 1;
-        int beta = e + floor_log2_pow10(k);
-
-        auto& results_for_k = result.results[k - impl::min_k];
-
-        // target = 2^(k - klog2(10) - 1) * 5^k = phi_k / 2^Q in [1/2, 1).
-        if (k != prev_k) {
-            target.numerator = 1;
-            target.denominator = 1;
-            if (k >= 0) {
-                target.numerator = jkj::big_uint::pow(5, k);
-            }
-            else {
-                target.denominator = jkj::big_uint::pow(5, -k);
-            }
-            if (exp_2 >= 0) {
-                target.numerator *= jkj::big_uint::power_of_2(exp_2);
-            }
-            else {
-                target.denominator *= jkj::big_uint::power_of_2(-exp_2);
-            }
-        }
+    if (k >= 0) {
+        target.numerator = jkj::big_uint::pow(5, k);
+    }
+    else {
+        target.denominator = jkj::big_uint::pow(5, -k);
+    }
+    if (exp_2 >= 0) {
+        target.numerator *= jkj::big_uint::power_of_2(exp_2);
+    }
+    else {
+        target.denominator *= jkj::big_uint::power_of_2(-exp_2);
+    }
 
-        // unit = 2^(e + k - 1) * 5^k = a/b.
-        unit.numerator = 1;
-        unit.denominator = 1;
-        if (k >= 0) {
-            unit.numerator = jkj::big_uint::pow(5, k);
-        }
-        else {
-            unit.denominator = jkj::big_uint::pow(5, -k);
-        }
-        if (e + k - 1 >= 0) {
-            unit.numerator *= jkj::big_uint::power_of_2(e + k - 1);
+    // unit = 2^(e + k - 1) * 5^k = a/b.
+    unit.numerator = 1;
+    unit.denominator = 1;
+    if (k >= 0) {
+        unit.numerator = jkj::big_uint::pow(5, k);
+    }
+    else {
+        unit.denominator = jkj::big_uint::pow(5, -k);
+    }
+    if (e + k - 1 >= 0) {
+        unit.numerator *= jkj::big_uint::power_of_2(e + k - 1);
+    }
+    else {
+        unit.denominator *= jkj::big_uint::power_of_2(-e - k + 1);
+    }
+
+
+    jkj::unsigned_rational<jkj::big_uint> upper_bound;
+    int sufficient_bits_for_integer_checks;
+    if (unit.denominator <= n_max) {
+        if (unit.denominator == 1) {
+            upper_bound = {unit.numerator * n_max + 1, n_max * jkj::big_uint::power_of_2(beta)};
         }
         else {
-            unit.denominator *= jkj::big_uint::power_of_2(-e - k + 1);
+            // We want to find the largest v <= n_max such that va == -1 (mod b).
+            // To obtain such v, we first find the smallest positive v0 such that
+            // v0 * a == -1 (mod b). Then v = v0 + floor((n_max - v0)/b) * b.
+            auto v0 =
+                jkj::find_best_rational_approx<jkj::rational_continued_fractions<jkj::big_uint>>(
+                    unit, unit.denominator - 1)
+                    .above.denominator;
+            auto v = v0 + ((n_max - v0) / unit.denominator) * unit.denominator;
+
+            auto div_result = div(v * unit.numerator + 1, unit.denominator);
+            assert(div_result.rem.is_zero());
+            upper_bound = jkj::unsigned_rational<jkj::big_uint>{
+                div_result.quot, v * jkj::big_uint::power_of_2(beta)};
         }
 
+        sufficient_bits_for_integer_checks =
+            impl::carrier_bits + int(jkj::big_uint(1).multiply_2_until(unit.denominator));
+    }
+    else {
+        auto [below, above] =
+            jkj::find_best_rational_approx<jkj::rational_continued_fractions<jkj::big_uint>>(unit,
+                                                                                             n_max);
+
+        upper_bound = std::move(above);
+        upper_bound.denominator *= jkj::big_uint::power_of_2(beta);
+
+        sufficient_bits_for_integer_checks =
+            impl::carrier_bits +
+            int((unit.numerator * below.denominator - below.numerator * unit.denominator)
+                    .multiply_2_until(unit.denominator));
+
+        // Collect all cases where cache_bits seems insufficient.
+        if (sufficient_bits_for_integer_checks > cache_bits) {
+            result.error_case_for_e = analysis_result::error_case{e, k, target, unit};
+        }
+    }
 
-        jkj::unsigned_rational<jkj::big_uint> upper_bound;
-        int sufficient_bits_for_integer_checks;
-        if (unit.denominator <= n_max) {
-            if (unit.denominator == 1) {
-                upper_bound = {unit.numerator * n_max + 1, n_max * jkj::big_uint::power_of_2(beta)};
-            }
-            else {
-                // We want to find the largest v <= n_max such that va == -1 (mod b).
-                // To obtain such v, we first find the smallest positive v0 such that
-                // v0 * a == -1 (mod b). Then v = v0 + floor((n_max - v0)/b) * b.
-                auto v0 =
-                    jkj::find_best_rational_approx<jkj::rational_continued_fractions<jkj::big_uint>>(
-                        unit, unit.denominator - 1)
-                        .above.denominator;
-                auto v = v0 + ((n_max - v0) / unit.denominator) * unit.denominator;
-
-                auto div_result = div(v * unit.numerator + 1, unit.denominator);
-                assert(div_result.rem.is_zero());
-                upper_bound = jkj::unsigned_rational<jkj::big_uint>{
-                    div_result.quot, v * jkj::big_uint::power_of_2(beta)};
-            }
+    // Compute the required number of bits for successful multiplication.
+    // The following is an upper bound.
+    auto div_result = div(upper_bound.denominator * target.denominator,
+                          upper_bound.numerator * target.denominator -
+                              upper_bound.denominator * target.numerator);
+    if (!div_result.rem.is_zero()) {
+        div_result.quot += 1;
+    }
+    auto sufficient_bits_for_multiplication =
+        int(jkj::big_uint(1).multiply_2_until(div_result.quot));
+
+    // Tentatively decrease the above result to find the minimum admissible value.
+    while (sufficient_bits_for_multiplication > 0) {
+        auto r = (jkj::big_uint::power_of_2(sufficient_bits_for_multiplication - 1) *
+                  target.numerator) %
+                 target.denominator;
+        if (!r.is_zero()) {
+            r = target.denominator - r;
+        }
 
-            sufficient_bits_for_integer_checks =
-                impl::carrier_bits + int(jkj::big_uint(1).multiply_2_until(unit.denominator));
+        if (r * upper_bound.denominator >=
+            jkj::big_uint::power_of_2(sufficient_bits_for_multiplication - 1) *
+                (upper_bound.numerator * target.denominator -
+                 upper_bound.denominator * target.numerator)) {
+            break;
         }
-        else {
-            auto [below, above] =
-                jkj::find_best_rational_approx<jkj::rational_continued_fractions<jkj::big_uint>>(unit,
-                                                                                                 n_max);
 
-            upper_bound = std::move(above);
-            upper_bound.denominator *= jkj::big_uint::power_of_2(beta);
+        --sufficient_bits_for_multiplication;
+    }
 
-            sufficient_bits_for_integer_checks =
-                impl::carrier_bits +
-                int((unit.numerator * below.denominator - below.numerator * unit.denominator)
-                        .multiply_2_until(unit.denominator));
+    result.sufficient_bits_for_multiplication = sufficient_bits_for_multiplication;
+    result.sufficient_bits_for_integer_checks = sufficient_bits_for_integer_checks;
+    result.distance_to_upper_bound = jkj::unsigned_rational<jkj::big_uint>{
+        upper_bound.numerator * target.denominator - upper_bound.denominator * target.numerator,
+        upper_bound.denominator * target.denominator};
+    return result;
+}
 
-            // Collect all cases where cache_bits seems insufficient.
-            if (sufficient_bits_for_integer_checks > cache_bits) {
-                result.error_cases.push_back({e, k, target, unit});
-            }
-        }
+template <class FormatTraits>
+static bool analyze(std::ostream& out, std::size_t cache_bits,
+                    jkj::verification_options const& options) {
+    using impl = jkj::dragonbox::detail::impl<FormatTraits>;
 
-        // Compute the required number of bits for successful multiplication.
-        // The following is an upper bound.
-        auto div_result = div(upper_bound.denominator * target.denominator,
-                              upper_bound.numerator * target.denominator -
-                                  upper_bound.denominator * target.numerator);
-        if (!div_result.rem.is_zero()) {
-            div_result.quot += 1;
-        }
-        auto sufficient_bits_for_multiplication =
-            int(jkj::big_uint(1).multiply_2_until(div_result.quot));
-
-        // Tentatively decrease the above result to find the minimum admissible value.
-        while (sufficient_bits_for_multiplication > 0) {
-            auto r =
-                (jkj::big_uint::power_of_2(sufficient_bits_for_multiplication - 1) * target.numerator) %
-                target.denominator;
-            if (!r.is_zero()) {
-                r = target.denominator - r;
-            }
+    auto min_e = impl::min_exponent - impl::significand_bits;
+    auto max_e = impl::max_exponent - impl::significand_bits;
+    if (!options.restrict_exponents(min_e, max_e)) {
+        std::cout << "No exponent to verify.\n\n";
+        return true;
+    }
+    if (options.has_exponent_range) {
+        std::cout << "Verifying only e in [" << min_e << ", " << max_e << "].\n";
+    }
 
-            if (r * upper_bound.denominator >=
-                jkj::big_uint::power_of_2(sufficient_bits_for_multiplication - 1) *
-                    (upper_bound.numerator * target.denominator -
-                     upper_bound.denominator * target.numerator)) {
-                break;
-            }
+    out << "e,bits_for_multiplication,bits_for_integer_check\n";
 
-            --sufficient_bits_for_multiplication;
-        }
+    auto n_max = jkj::big_uint::power_of_2(impl::significand_bits + 2);
+
+    analysis_result result;
+    result.results.resize(impl::max_k - impl::min_k + 1);
 
-        out << e << "," << sufficient_bits_for_multiplication << ","
-            << sufficient_bits_for_integer_checks << "\n";
+    // Each e is analyzed independently on the worker threads, and the results are merged in the
+    // increasing order of e.
+    jkj::ordered_parallel_for(
+        min_e, max_e, options.number_of_threads,
+        [cache_bits](int e) { return analyze_exponent<FormatTraits>(e, cache_bits); },
+        [&](int e, analysis_result::result_per_exponent&& r) {
+            out << e << "," << r.sufficient_bits_for_multiplication << ","
+                << r.sufficient_bits_for_integer_checks << "\n";
+
+            // Update.
+            auto& results_for_k = result.results[r.k - impl::min_k];
+            if (results_for_k.sufficient_bits_for_multiplication <
+                r.sufficient_bits_for_multiplication) {
+                results_for_k.sufficient_bits_for_multiplication =
+                    r.sufficient_bits_for_multiplication;
+            }
+            if (results_for_k.sufficient_bits_for_integer_checks <
+                r.sufficient_bits_for_integer_checks) {
+                results_for_k.sufficient_bits_for_integer_checks =
+                    r.sufficient_bits_for_integer_checks;
+            }
+            auto& distance = r.distance_to_upper_bound;
+            if (results_for_k.distance_to_upper_bound.denominator.is_zero()) {
+                results_for_k.distance_to_upper_bound = std::move(distance);
+            }
+            else if (results_for_k.distance_to_upper_bound.numerator * distance.denominator >
+                     distance.numerator * results_for_k.distance_to_upper_bound.denominator) {
+                results_for_k.distance_to_upper_bound = std::move(distance);
+            }
 
-        // Update.
-        if (results_for_k.sufficient_bits_for_multiplication < sufficient_bits_for_multiplication) {
-            results_for_k.sufficient_bits_for_multiplication = sufficient_bits_for_multiplication;
-        }
-        if (results_for_k.sufficient_bits_for_integer_checks < sufficient_bits_for_integer_checks) {
-            results_for_k.sufficient_bits_for_integer_checks = sufficient_bits_for_integer_checks;
-        }
-        auto distance = jkj::unsigned_rational<jkj::big_uint>{
-            upper_bound.numerator * target.denominator - upper_bound.denominator * target.numerator,
-            upper_bound.denominator * target.denominator};
-        if (results_for_k.distance_to_upper_bound.denominator.is_zero()) {
-            results_for_k.distance_to_upper_bound = std::move(distance);
-        }
-        else if (results_for_k.distance_to_upper_bound.numerator * distance.denominator >
-                 distance.numerator * results_for_k.distance_to_upper_bound.denominator) {
-            results_for_k.distance_to_upper_bound = distance;
-        }
-    }
+            if (r.error_case_for_e) {
+                result.error_cases.push_back(std::move(*r.error_case_for_e));
+            }
+            return true;
+        },
+        &std::cout);
 
     // Analyze all error cases.
     auto reciprocal_error_threshold = jkj::big_uint::power_of_2(cache_bits - impl::carrier_bits);
-    for (auto& ec : result.error_cases) {
-        // We want to find all n such that
-        // d:= na/b - floor(na/b) < 2^(q-Q).
-
-        ec.candidate_multipliers = jkj::find_all_good_rational_approx_from_below_denoms<
-            jkj::rational_continued_fractions<jkj::big_uint>>(
-            ec.unit, n_max, jkj::unsigned_rational<jkj::big_uint>{1, reciprocal_error_threshold});
-    }
+    jkj::ordered_parallel_for(
+        0, int(result.error_cases.size()) - 1, options.number_of_threads,
+        [&](int idx) {
+            // We want to find all n such that
+            // d:= na/b - floor(na/b) < 2^(q-Q).
+            return jkj::find_all_good_rational_approx_from_below_denoms<
+                jkj::rational_continued_fractions<jkj::big_uint>>(
+                result.error_cases[idx].unit, n_max,
+                jkj::unsigned_rational<jkj::big_uint>{1, reciprocal_error_threshold});
+        },
+        [&](int idx, std::vector<jkj::big_uint>&& candidate_multipliers) {
+            result.error_cases[idx].candidate_multipliers = std::move(candidate_multipliers);
+            return true;
+        },
+        nullptr);
 
     auto sufficient_bits_for_multiplication =
         std::max_element(result.results.cbegin(), result.results.cend(),
@@ -314,25 +366,44 @@ static bool analyze(std::ostream& out, std::size_t cache_bits) {
 
 
 
-int main() {
+int main(int argc, char* argv[]) {
+    jkj::verification_options options;
+    if (!jkj::parse_verification_options(argc, argv, options)) {
+        std::cout << "Usage: verify_cache_precision [--threads=<n>] [--format=binary32|binary64] "
+                     "[--exponents=<first>:<last>]\n";
+        return -1;
+    }
+
     bool success = true;
     std::ofstream out;
 
-    std::cout << "[Verifying sufficiency of cache precision for binary32...]\n";
-    out.open("results/binary32.csv");
-    if (!analyze<jkj::dragonbox::ieee754_binary_traits<jkj::dragonbox::ieee754_binary32,
-                                                       std::uint_least32_t>>(out, 64)) {
-        success = false;
+    // A partial result is written next to the full one.
+    auto const csv_suffix = options.has_exponent_range
+                                ? "_" + std::to_string(options.first_exponent) + "_" +
+                                      std::to_string(options.last_exponent) + ".csv"
+                                : std::string(".csv");
+
+    if (options.includes_format("binary32")) {
+        std::cout << "[Verifying sufficiency of cache precision for binary32...]\n";
+        out.open("results/binary32" + csv_suffix);
+        if (!analyze<jkj::dragonbox::ieee754_binary_traits<jkj::dragonbox::ieee754_binary32,
+                                                           std::uint_least32_t>>(out, 64,
+                                                                                 options)) {
+            success = false;
+        }
+        out.close();
     }
-    out.close();
 
-    std::cout << "[Verifying sufficiency of cache precision for binary64...]\n";
-    out.open("results/binary64.csv");
-    if (!analyze<jkj::dragonbox::ieee754_binary_traits<jkj::dragonbox::ieee754_binary64,
-                                                        std::uint_least64_t>>(out, 128)) {
-        success = false;
+    if (options.includes_format("binary64")) {
+        std::cout << "[Verifying sufficiency of cache precision for binary64...]\n";
+        out.open("results/binary64" + csv_suffix);
+        if (!analyze<jkj::dragonbox::ieee754_binary_traits<jkj::dragonbox::ieee754_binary64,
+                                                            std::uint_least64_t>>(out, 128,
+                                                                                  options)) {
+            success = false;
+        }
+        out.close();
     }
-    out.close();
 
     return success ? 0 : -1;
-}
\ No newline at end of file
+}
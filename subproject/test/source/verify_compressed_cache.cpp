@@ -17,11 +17,15 @@
 
 #include "dragonbox/dragonbox.h"
 #include "big_uint.h"
+#include "parallel_for.h"
 #include "rational_continued_fractions.h"
 
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 // We are trying to verify that an appropriate right-shift of phi_k * 5^a plus one
@@ -49,91 +53,142 @@ struct recovered_cache_t {
     bool success;
 };
 
+// The outcome of the verification for each e: whether it passed, and what to report.
+struct result_per_exponent {
+    bool success;
+    std::string message;
+};
+
 template <class FormatTraits, class GetCache, class ConvertToBigUInt>
-bool verify_compressed_cache(GetCache&& get_cache, ConvertToBigUInt&& convert_to_big_uint,
-                             std::size_t max_diff_for_multiplication) {
+result_per_exponent verify_compressed_cache_for_exponent(int e, GetCache& get_cache,
+                                                         ConvertToBigUInt& convert_to_big_uint,
+                                                         std::size_t max_diff_for_multiplication) {
     using format = typename FormatTraits::format;
     using cache_holder_type = jkj::dragonbox::compressed_cache_holder<format>;
     using impl = jkj::dragonbox::detail::impl<FormatTraits>;
 
-    jkj::unsigned_rational<jkj::big_uint> unit;
-    auto n_max = jkj::big_uint::power_of_2(format::significand_bits + 2);
-    for (int e = format::min_exponent - format::significand_bits;
-         e <= format::max_exponent - format::significand_bits; ++e) {
-        int const k = impl::kappa - jkj::dragonbox::detail::log::floor_log10_pow2(e);
+    std::ostringstream message;
+    auto const n_max = jkj::big_uint::power_of_2(format::significand_bits + 2);
+    int const k = impl::kappa - jkj::dragonbox::detail::log::floor_log10_pow2(e);
 
-        auto const real_cache = jkj::dragonbox::policy::cache::full.get_cache<format, int>(k);
+    auto const real_cache = jkj::dragonbox::policy::cache::full.get_cache<format, int>(k);
 
-        auto const recovered_cache = get_cache(k);
-        if (!recovered_cache.success) {
-            std::cout << " (e = " << e << ")\n";
-            return false;
+    auto const recovered_cache = get_cache(k);
+    if (!recovered_cache.success) {
+        message << "Overflow detected - taking the ceil requires addition-with-carry (e = " << e
+                << ")\n";
+        return {false, message.str()};
+    }
+
+    auto const rc = convert_to_big_uint(recovered_cache.value);
+    auto const diff = rc - convert_to_big_uint(real_cache);
+    if (diff != 0) {
+        if (diff > max_diff_for_multiplication) {
+            message << "Multiplication is no longer valid. (e = " << e << ")\n";
+            return {false, message.str()};
         }
 
-        auto const rc = convert_to_big_uint(recovered_cache.value);
-        auto const diff = rc - convert_to_big_uint(real_cache);
-        if (diff != 0) {
-            if (diff > max_diff_for_multiplication) {
-                std::cout << "Multiplication is no longer valid. (e = " << e << ")\n";
-                return false;
-            }
+        // For the case b <= n_max, integer check might be no longer valid.
+        int const beta = e + jkj::dragonbox::detail::log::floor_log2_pow10(k);
 
-            // For the case b <= n_max, integer check might be no longer valid.
-            int const beta = e + jkj::dragonbox::detail::log::floor_log2_pow10(k);
+        // unit = 2^(e + k - 1) * 5^k = a/b.
+        jkj::unsigned_rational<jkj::big_uint> unit;
+        unit.numerator = 1;
+        unit.denominator = 1;
+        if (k >= 0) {
+            unit.numerator = jkj::big_uint::pow(5, k);
+        }
+        else {
+            unit.denominator = jkj::big_uint::pow(5, -k);
+        }
+        if (e + k - 1 >= 0) {
+            unit.numerator *= jkj::big_uint::power_of_2(e + k - 1);
+        }
+        else {
+            unit.denominator *= jkj::big_uint::power_of_2(-e - k + 1);
+        }
 
-            // unit = 2^(e + k - 1) * 5^k = a/b.
-            unit.numerator = 1;
-            unit.denominator = 1;
-            if (k >= 0) {
-                unit.numerator = jkj::big_uint::pow(5, k);
-            }
-            else {
-                unit.denominator = jkj::big_uint::pow(5, -k);
-            }
-            if (e + k - 1 >= 0) {
-                unit.numerator *= jkj::big_uint::power_of_2(e + k - 1);
-            }
-            else {
-                unit.denominator *= jkj::big_uint::power_of_2(-e - k + 1);
-            }
+        if (unit.denominator <= n_max) {
+            // Check (recovered_cache) < 2^(Q-beta) * a/b + 2^(q-beta)/(floor(nmax/b) * b),
+            // or equivalently,
+            // b * (recovered_cache) - 2^(Q-beta) * a < 2^(q-beta) / floor(nmax/b).
+            auto const left_hand_side =
+                unit.denominator * rc -
+                jkj::big_uint::power_of_2(cache_holder_type::cache_bits - beta) * unit.numerator;
 
-            if (unit.denominator <= n_max) {
-                // Check (recovered_cache) < 2^(Q-beta) * a/b + 2^(q-beta)/(floor(nmax/b) * b),
-                // or equivalently,
-                // b * (recovered_cache) - 2^(Q-beta) * a < 2^(q-beta) / floor(nmax/b).
-                auto const left_hand_side =
-                    unit.denominator * rc -
-                    jkj::big_uint::power_of_2(cache_holder_type::cache_bits - beta) * unit.numerator;
-
-                if (left_hand_side * (n_max / unit.denominator) >=
-                    jkj::big_uint::power_of_2(FormatTraits::carrier_bits - beta)) {
-                    std::cout << "Integer check is no longer valid. (e = " << e << ")\n";
-
-                    // This exceptional case is carefully examined, so okay.
-                    if (std::is_same<format, jkj::dragonbox::ieee754_binary32>::value && e == -10) {
-                        // The exceptional case only occurs when n is exactly n_max.
-                        if (left_hand_side * ((n_max - 1) / unit.denominator) >=
-                            jkj::big_uint::power_of_2(FormatTraits::carrier_bits - beta)) {
-                            return false;
-                        }
-                        std::cout << "    This case has been carefully addressed.\n\n";
-                    }
-                    else {
-                        return false;
+            if (left_hand_side * (n_max / unit.denominator) >=
+                jkj::big_uint::power_of_2(FormatTraits::carrier_bits - beta)) {
+                message << "Integer check is no longer valid. (e = " << e << ")\n";
+
+                // This exceptional case is carefully examined, so okay.
+                if (std::is_same<format, jkj::dragonbox::ieee754_binary32>::value && e == -10) {
+                    // The exceptional case only occurs when n is exactly n_max.
+                    if (left_hand_side * ((n_max - 1) / unit.denominator) >=
+                        jkj::big_uint::power_of_2(FormatTraits::carrier_bits - beta)) {
+                        return {false, message.str()};
                     }
+                    message << "    This case has been carefully addressed.\n\n";
+                }
+                else {
+                    return {false, message.str()};
                 }
             }
         }
     }
 
-    return true;
+    return {true, message.str()};
+}
+
+// Each e is verified independently on the worker threads, and the results are reported in the
+// increasing order of e, stopping at the first failure.
+template <class FormatTraits, class GetCache, class ConvertToBigUInt>
+bool verify_compressed_cache(GetCache&& get_cache, ConvertToBigUInt&& convert_to_big_uint,
+                             std::size_t max_diff_for_multiplication,
+                             jkj::verification_options const& options) {
+    using format = typename FormatTraits::format;
+
+    auto min_e = format::min_exponent - format::significand_bits;
+    auto max_e = format::max_exponent - format::significand_bits;
+    if (!options.restrict_exponents(min_e, max_e)) {
+        std::cout << "No exponent to verify.\n";
+        return true;
+    }
+    if (options.has_exponent_range) {
+        std::cout << "Verifying only e in [" << min_e << ", " << max_e << "].\n";
+    }
+
+    bool success = true;
+    std::string report;
+    jkj::ordered_parallel_for(
+        min_e, max_e, options.number_of_threads,
+        [&](int e) {
+            return verify_compressed_cache_for_exponent<FormatTraits>(
+                e, get_cache, convert_to_big_uint, max_diff_for_multiplication);
+        },
+        [&](int, result_per_exponent&& r) {
+            report += r.message;
+            success = r.success;
+            return success;
+        },
+        &std::cout);
+
+    std::cout << report;
+    return success;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    jkj::verification_options options;
+    if (!jkj::parse_verification_options(argc, argv, options)) {
+        std::cout << "Usage: verify_compressed_cache [--threads=<n>] [--format=binary32|binary64] "
+                     "[--exponents=<first>:<last>]\n";
+        return -1;
+    }
+
     bool success = true;
 
-    std::cout << "[Verifying compressed cache for binary32...]\n";
-    {
+    if (options.includes_format("binary32")) {
+        std::cout << "[Verifying compressed cache for binary32...]\n";
+
         using cache_holder_type =
             jkj::dragonbox::compressed_cache_holder<jkj::dragonbox::ieee754_binary32>;
 
@@ -143,7 +198,8 @@ int main() {
                     return recovered_cache_t<cache_holder_type::cache_entry_type>{
                         cache_holder_type::get_cache<int>(k), true};
                 },
-                [](cache_holder_type::cache_entry_type value) { return jkj::big_uint{value}; }, 7)) {
+                [](cache_holder_type::cache_entry_type value) { return jkj::big_uint{value}; }, 7,
+                options)) {
             std::cout << "Verification succeeded. No error detected.\n\n";
         }
         else {
@@ -152,8 +208,9 @@ int main() {
         }
     }
 
-    std::cout << "[Verifying compressed cache for binary64...]\n";
-    {
+    if (options.includes_format("binary64")) {
+        std::cout << "[Verifying compressed cache for binary64...]\n";
+
         using cache_holder_type =
             jkj::dragonbox::compressed_cache_holder<jkj::dragonbox::ieee754_binary64>;
 
@@ -196,16 +253,8 @@ int main() {
                         recovered_cache = {recovered_cache.high(),
                                            std::uint_least64_t(recovered_cache.low() + 1)};
 
-                        if (recovered_cache.low() == 0) {
-                            std::cout
-                                << "Overflow detected - taking the ceil requires addition-with-carry";
-                            return recovered_cache_t<cache_holder_type::cache_entry_type>{
-                                recovered_cache, false};
-                        }
-                        else {
-                            return recovered_cache_t<cache_holder_type::cache_entry_type>{
-                                recovered_cache, true};
-                        }
+                        return recovered_cache_t<cache_holder_type::cache_entry_type>{
+                            recovered_cache, recovered_cache.low() != 0};
                     }
                     else {
                         return recovered_cache_t<cache_holder_type::cache_entry_type>{base_cache, true};
@@ -214,7 +263,7 @@ int main() {
                 [](cache_holder_type::cache_entry_type value) {
                     return jkj::big_uint{value.low(), value.high()};
                 },
-                13)) {
+                13, options)) {
             std::cout << "Verification succeeded. No error detected.\n\n";
         }
         else {